@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Synthetic graph families used by benchmarks.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef BENCH_GRAPHS_HPP
+#define BENCH_GRAPHS_HPP
+
+#include <vector>
+#include <tuple>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "ugraph/lbl_ugraph.hpp"
+
+
+typedef unsigned int UInt;
+
+/// Graph with integer vertices and weights used by benchmarks.
+typedef EdgeLblUGraph<UInt, UInt> BenchGraph;
+
+/// Labeled edge (s, d, weight).
+typedef BenchGraph::LblEdge BenchEdge;
+
+
+/// Families of synthetic graphs.
+enum GraphFamily {
+    GF_RANDOM = 0,      ///< Erdős–Rényi G(n, p) with the average degree 8.
+    GF_GRID,            ///< Square 2D grid.
+    GF_POWER_LAW,       ///< Preferential attachment, 4 edges per new vertex.
+    GF_COMPLETE,        ///< Complete graph.
+    GF_FAMILIES_NUM
+};
+
+/// Returns the name of the family \a gf.
+inline const char* getFamilyName(int gf)
+{
+    static const char* names[] = { "gnp", "grid", "power-law", "complete" };
+    return names[gf];
+}
+
+
+/// Makes a graph of the family \a gf with about \a m edges having random
+/// weights from 1 to 1000. The same arguments give the same graph.
+inline std::vector<BenchEdge> makeFamilyGraph(int gf, size_t m,
+                                              unsigned int seed = 42)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<UInt> wDist(1, 1000);
+    std::vector<BenchEdge> es;
+    es.reserve(m);
+
+    switch (gf)
+    {
+    case GF_RANDOM:
+    {
+        // skips absent pairs by geometric jumps (Batagelj & Brandes)
+        UInt n = UInt(m / 4 + 2);
+        double p = double(m) / (double(n) * (n - 1) / 2);
+        std::uniform_real_distribution<double> rDist(0.0, 1.0);
+        double lq = std::log(1.0 - p);
+        std::int64_t v = 1, w = -1;
+        while (v < n)
+        {
+            w += 1 + std::int64_t(std::log(1.0 - rDist(rng)) / lq);
+            while (w >= v && v < n)
+            {
+                w -= v;
+                ++v;
+            }
+            if (v < n)
+                es.push_back(BenchEdge(UInt(v), UInt(w), wDist(rng)));
+        }
+        break;
+    }
+    case GF_GRID:
+    {
+        UInt side = UInt(std::sqrt(double(m) / 2)) + 1;
+        for (UInt r = 0; r < side; ++r)
+            for (UInt c = 0; c < side; ++c)
+            {
+                UInt v = r * side + c;
+                if (c + 1 < side)
+                    es.push_back(BenchEdge(v, v + 1, wDist(rng)));
+                if (r + 1 < side)
+                    es.push_back(BenchEdge(v, v + side, wDist(rng)));
+            }
+        break;
+    }
+    case GF_POWER_LAW:
+    {
+        // a vertex is chosen with probability proportional to its degree by
+        // picking a random end of an already added edge
+        const UInt k = 4;
+        UInt n = UInt(m / k) + k + 1;
+        std::vector<UInt> ends;
+        ends.reserve(2 * m + 2 * k * k);
+        for (UInt v = 0; v <= k; ++v)
+            for (UInt u = 0; u < v; ++u)
+            {
+                es.push_back(BenchEdge(v, u, wDist(rng)));
+                ends.push_back(v);
+                ends.push_back(u);
+            }
+        for (UInt v = k + 1; v < n; ++v)
+            for (UInt i = 0; i < k; ++i)
+            {
+                UInt u = ends[rng() % ends.size()];
+                es.push_back(BenchEdge(v, u, wDist(rng)));
+                ends.push_back(v);
+                ends.push_back(u);
+            }
+        break;
+    }
+    case GF_COMPLETE:
+    {
+        UInt n = UInt(std::sqrt(2.0 * double(m))) + 1;
+        for (UInt v = 1; v < n; ++v)
+            for (UInt u = 0; u < v; ++u)
+                es.push_back(BenchEdge(v, u, wDist(rng)));
+        break;
+    }
+    }
+
+    return es;
+}
+
+
+/// Makes \a m random pairs of elements from 0 to \a n - 1.
+inline std::vector<std::pair<UInt, UInt>> makeRandomPairs(UInt n, size_t m)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<UInt> dist(0, n - 1);
+    std::vector<std::pair<UInt, UInt>> pairs(m);
+    for (auto& p : pairs)
+        p = {dist(rng), dist(rng)};
+
+    return pairs;
+}
+
+
+/// Builds a graph from the edges \a es one edge at a time.
+inline void addEdges(BenchGraph& g, const std::vector<BenchEdge>& es)
+{
+    for (const BenchEdge& e : es)
+        g.addLblEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+}
+
+
+/// Adds arguments (family, edges number) for all families and the numbers of
+/// edges 10^3, 10^4, ..., 10^maxPow.
+inline void applyFamilyArgs(benchmark::internal::Benchmark* b, int maxPow)
+{
+    for (int gf = 0; gf < GF_FAMILIES_NUM; ++gf)
+    {
+        std::int64_t m = 1000;
+        for (int pow = 3; pow <= maxPow; ++pow, m *= 10)
+            b->Args({gf, m});
+    }
+}
+
+/// Families and sizes up to 10^7 edges.
+inline void familyArgs(benchmark::internal::Benchmark* b)
+{
+    applyFamilyArgs(b, 7);
+}
+
+
+#endif // BENCH_GRAPHS_HPP
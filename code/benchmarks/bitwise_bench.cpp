@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for bulk popcount and bit-extraction kernels.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+#include <random>
+#include <sstream>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bitwise_tasks.hpp"
+
+
+// Returns true if the CPU supports the instruction set \a isa.
+static bool isIsaSupported(BitwiseIsa isa)
+{
+    switch (isa)
+    {
+    case BitwiseIsa::Avx512:
+        return hasAvx512Popcnt();
+    case BitwiseIsa::Avx2:
+        return hasAvx2();
+    default:
+        return true;
+    }
+}
+
+// Adds arguments (words number, instruction set): from L1-resident arrays
+// to ones that only fit in memory.
+static void bitwiseArgs(benchmark::internal::Benchmark* b)
+{
+    for (int isa = 0; isa <= int(BitwiseIsa::Avx512); ++isa)
+        for (std::int64_t n = 1 << 10; n <= (1 << 24); n <<= 7)
+            b->Args({n, isa});
+}
+
+
+static void BM_CountOnes(benchmark::State& state)
+{
+    size_t n = size_t(state.range(0));
+    BitwiseIsa isa = BitwiseIsa(state.range(1));
+    if (!isIsaSupported(isa))
+    {
+        state.SkipWithError("instruction set is not supported");
+        return;
+    }
+
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> words(n);
+    for (std::uint64_t& w : words)
+        w = rng();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(countOnes(words.data(), n, isa));
+
+    state.SetBytesProcessed(std::int64_t(state.iterations())
+                            * std::int64_t(n * sizeof(std::uint64_t)));
+}
+BENCHMARK(BM_CountOnes)->Apply(bitwiseArgs);
+
+
+static void BM_GetBitsAtIndex(benchmark::State& state)
+{
+    size_t n = size_t(state.range(0));
+    BitwiseIsa isa = BitwiseIsa(state.range(1));
+    if (!isIsaSupported(isa))
+    {
+        state.SkipWithError("instruction set is not supported");
+        return;
+    }
+
+    std::mt19937 rng(42);
+    std::vector<std::uint32_t> numbers(n);
+    for (std::uint32_t& x : numbers)
+        x = rng();
+    std::vector<std::uint8_t> bits(n);
+
+    for (auto _ : state)
+    {
+        getBitsAtIndex(numbers.data(), n, 5, bits.data(), isa);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(std::int64_t(state.iterations())
+                            * std::int64_t(n * sizeof(std::uint32_t)));
+}
+BENCHMARK(BM_GetBitsAtIndex)->Apply(bitwiseArgs);
+
+
+// Formats numbers to a stream a character at a time, as printBinary() did.
+static void BM_ToBinaryStream(benchmark::State& state)
+{
+    size_t n = size_t(state.range(0));
+    std::mt19937 rng(42);
+    std::vector<std::uint32_t> numbers(n);
+    for (std::uint32_t& x : numbers)
+        x = rng();
+
+    for (auto _ : state)
+    {
+        std::ostringstream out;
+        for (std::uint32_t x : numbers)
+        {
+            for (int i = 31; i >= 0; --i)
+                out << char('0' + ((x >> i) & 1));
+            out << '\n';
+        }
+        benchmark::DoNotOptimize(out.str().size());
+    }
+
+    state.SetBytesProcessed(std::int64_t(state.iterations())
+                            * std::int64_t(n * (BINARY32_LEN + 1)));
+}
+BENCHMARK(BM_ToBinaryStream)->Arg(1 << 16);
+
+
+static void BM_ToBinaryBulk(benchmark::State& state)
+{
+    size_t n = size_t(state.range(0));
+    BitwiseIsa isa = BitwiseIsa(state.range(1));
+    if (!isIsaSupported(isa))
+    {
+        state.SkipWithError("instruction set is not supported");
+        return;
+    }
+
+    std::mt19937 rng(42);
+    std::vector<std::uint32_t> numbers(n);
+    for (std::uint32_t& x : numbers)
+        x = rng();
+    std::vector<char> buf(n * (BINARY32_LEN + 1));
+
+    for (auto _ : state)
+    {
+        toBinaryBulk(numbers.data(), n, buf.data(), '\n', isa);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(std::int64_t(state.iterations())
+                            * std::int64_t(buf.size()));
+}
+BENCHMARK(BM_ToBinaryBulk)->Args({1 << 16, int(BitwiseIsa::Scalar)})
+                          ->Args({1 << 16, int(BitwiseIsa::Avx2)});
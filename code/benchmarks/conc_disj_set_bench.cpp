@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for the concurrent union-find and parallel connected
+/// components: scaling from 1 to N threads.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/conc_disj_set.hpp"
+#include "ugraph/ugraph_par_algos.hpp"
+#include "ugraph/conn_index.hpp"
+
+
+// Adds thread counts 1, 2, 4, ... up to the hardware concurrency.
+static void threadsArgs(benchmark::internal::Benchmark* b)
+{
+    unsigned int maxThreads = getThreadsNum();
+    for (unsigned int t = 1; t < maxThreads; t *= 2)
+        b->Arg(t);
+    b->Arg(maxThreads);
+}
+
+
+static void BM_ConcurrentDSFMerge(benchmark::State& state)
+{
+    const unsigned int N = 1 << 20;
+    static const auto pairs = makeRandomPairs(N, 2 * N);
+    unsigned int threads = unsigned(state.range(0));
+
+    for (auto _ : state)
+    {
+        ConcurrentDisjointSetForest dsf(N);
+        parallelFor(0, pairs.size(), threads,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t i = beg; i < end; ++i)
+                    dsf.merge(pairs[i].first, pairs[i].second);
+            });
+        benchmark::DoNotOptimize(dsf.find(0));
+    }
+
+    state.SetItemsProcessed(state.iterations() * pairs.size());
+}
+BENCHMARK(BM_ConcurrentDSFMerge)->Apply(threadsArgs)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+
+static void BM_ConnectedComponents(benchmark::State& state)
+{
+    const unsigned int N = 1 << 16;
+    static UGraph<unsigned int> g;
+    if (g.getVerticesNum() == 0)
+    {
+        for (auto& p : makeRandomPairs(N, N))
+            g.addEdge(p.first, p.second);
+    }
+    unsigned int threads = unsigned(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(connectedComponents(g, threads));
+
+    state.SetItemsProcessed(state.iterations() * g.getEdgesNum());
+}
+BENCHMARK(BM_ConnectedComponents)->Apply(threadsArgs)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+
+static void BM_ConnectedComponentsSV(benchmark::State& state)
+{
+    const unsigned int N = 1 << 16;
+    static UGraph<unsigned int> g;
+    if (g.getVerticesNum() == 0)
+    {
+        for (auto& p : makeRandomPairs(N, N))
+            g.addEdge(p.first, p.second);
+    }
+    unsigned int threads = unsigned(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(connectedComponentsSV(g, threads));
+
+    state.SetItemsProcessed(state.iterations() * g.getEdgesNum());
+}
+BENCHMARK(BM_ConnectedComponentsSV)->Apply(threadsArgs)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+
+// Batches of edges, each followed by a connectivity query, answered by the
+// index attached to the graph (range(0) == 1) or by rebuilding components.
+static void BM_IncrementalConnectivity(benchmark::State& state)
+{
+    const unsigned int N = 1 << 14;
+    const size_t BATCH = 256;
+    const auto pairs = makeRandomPairs(N, N);
+    const bool useIndex = state.range(0) == 1;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        UGraph<unsigned int> g;
+        for (unsigned int v = 0; v < N; ++v)
+            g.addVertex(v);
+        state.ResumeTiming();
+
+        ConnectivityIndex<UGraph<unsigned int>> ci(g);
+        size_t connected = 0;
+        for (size_t i = 0; i < pairs.size(); ++i)
+        {
+            g.addEdge(pairs[i].first, pairs[i].second);
+            if ((i + 1) % BATCH != 0)
+                continue;
+
+            if (useIndex)
+                connected += ci.connected(0, pairs[i].first);
+            else
+            {
+                std::vector<unsigned int> comps = connectedComponents(g, 1);
+                connected += comps[g.getVertexId(0)]
+                             == comps[g.getVertexId(pairs[i].first)];
+            }
+        }
+        benchmark::DoNotOptimize(connected);
+    }
+}
+BENCHMARK(BM_IncrementalConnectivity)->Arg(0)->Arg(1)
+    ->Unit(benchmark::kMillisecond);
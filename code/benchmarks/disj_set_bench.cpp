@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for union-find structures with and without path
+/// compression.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/disj_set.hpp"
+
+
+// Adds arguments (elements number, path compression flag).
+static void dsfArgs(benchmark::internal::Benchmark* b)
+{
+    for (int pc = 0; pc <= 1; ++pc)
+        for (std::int64_t n = 1000; n <= 10000000; n *= 10)
+            b->Args({n, pc});
+}
+
+
+// Random unions followed by finds of every element.
+static void BM_DSFFindMerge(benchmark::State& state)
+{
+    unsigned int n = unsigned(state.range(0));
+    bool pc = state.range(1) != 0;
+    std::vector<std::pair<unsigned int, unsigned int>> pairs =
+            makeRandomPairs(n, n);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        DisjointSetForest<unsigned int> dsf(pc);
+        std::vector<DisjointSetForest<unsigned int>::Node*> nodes(n);
+        for (unsigned int i = 0; i < n; ++i)
+            nodes[i] = dsf.makeSet(i);
+        state.ResumeTiming();
+
+        for (const auto& p : pairs)
+            dsf.merge(dsf.find(nodes[p.first]), dsf.find(nodes[p.second]));
+        for (unsigned int i = 0; i < n; ++i)
+            benchmark::DoNotOptimize(dsf.find(nodes[i]));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+    state.SetLabel(pc ? "pc" : "no-pc");
+}
+BENCHMARK(BM_DSFFindMerge)->Apply(dsfArgs)->Unit(benchmark::kMillisecond);
+
+
+static void BM_FlatDSFFindMerge(benchmark::State& state)
+{
+    unsigned int n = unsigned(state.range(0));
+    bool pc = state.range(1) != 0;
+    std::vector<std::pair<unsigned int, unsigned int>> pairs =
+            makeRandomPairs(n, n);
+
+    for (auto _ : state)
+    {
+        FlatDisjointSetForest dsf(pc);
+        dsf.reserve(n);
+
+        for (const auto& p : pairs)
+            dsf.merge(dsf.find(p.first), dsf.find(p.second));
+        for (unsigned int i = 0; i < n; ++i)
+            benchmark::DoNotOptimize(dsf.find(i));
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+    state.SetLabel(pc ? "pc" : "no-pc");
+}
+BENCHMARK(BM_FlatDSFFindMerge)->Apply(dsfArgs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for MST algorithms on synthetic graph families.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/ugraph_algos.hpp"
+#include "ugraph/dyn_mst.hpp"
+
+
+static void BM_MSTPrim(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(findMSTPrim(g));
+
+    state.SetItemsProcessed(state.iterations() * g.getEdgesNum());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_MSTPrim)->Apply(familyArgs)->Unit(benchmark::kMillisecond);
+
+
+static void BM_MSTKruskal(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(findMSTKruskal(g));
+
+    state.SetItemsProcessed(state.iterations() * g.getEdgesNum());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_MSTKruskal)->Apply(familyArgs)->Unit(benchmark::kMillisecond);
+
+
+// Adds arguments (family, edges number) for sparse families.
+static void dynMstArgs(benchmark::internal::Benchmark* b)
+{
+    for (int gf : { int(GF_RANDOM), int(GF_GRID), int(GF_POWER_LAW) })
+        for (std::int64_t m : { 10000, 100000, 1000000 })
+            b->Args({gf, m});
+}
+
+// Single-edge changes maintained by DynamicMST: every iteration reweights a
+// random edge and then removes and restores another one.
+static void BM_DynamicMSTUpdate(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+    DynamicMST<BenchGraph> mst(g);
+
+    std::mt19937 rng(42);
+    for (auto _ : state)
+    {
+        const BenchEdge& e1 = es[rng() % es.size()];
+        g.setLabel(std::get<0>(e1), std::get<1>(e1), UInt(rng() % 1000 + 1));
+
+        const BenchEdge& e2 = es[rng() % es.size()];
+        UInt lbl;
+        if (g.getLabel(std::get<0>(e2), std::get<1>(e2), lbl))
+        {
+            g.removeEdge(std::get<0>(e2), std::get<1>(e2));
+            g.addLblEdge(std::get<0>(e2), std::get<1>(e2), lbl);
+        }
+    }
+
+    benchmark::DoNotOptimize(mst.getWeight());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_DynamicMSTUpdate)->Apply(dynMstArgs)
+    ->Unit(benchmark::kMicrosecond);
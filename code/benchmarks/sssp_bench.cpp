@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for single-source shortest path algorithms on synthetic
+/// graph families.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/ugraph_algos.hpp"
+#include "ugraph/ugraph_par_algos.hpp"
+
+
+typedef CsrEdgeLblUGraph<UInt, UInt> CsrBenchGraph;
+
+
+// Families and sizes up to 10^6 edges.
+static void ssspArgs(benchmark::internal::Benchmark* b)
+{
+    applyFamilyArgs(b, 6);
+}
+
+
+// Distances from one source to all vertices.
+template <typename Graph>
+static void dijkstraAllBody(benchmark::State& state, const Graph& g)
+{
+    DijkstraSearch<Graph> search(g);
+    UInt src = *g.getVertices().first;
+    for (auto _ : state)
+    {
+        search.run(src);
+        benchmark::DoNotOptimize(search.getDistances().data());
+    }
+}
+
+static void BM_DijkstraAll(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    dijkstraAllBody(state, BenchGraph::fromEdges(es.begin(), es.end()));
+}
+BENCHMARK(BM_DijkstraAll)->Apply(ssspArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_DijkstraAllCsr(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    dijkstraAllBody(state, CsrBenchGraph(BenchGraph::fromEdges(es.begin(), es.end())));
+}
+BENCHMARK(BM_DijkstraAllCsr)->Apply(ssspArgs)->Unit(benchmark::kMillisecond);
+
+
+// Point-to-point queries between random vertices with early exit, the search
+// being reused between queries.
+static void BM_DijkstraQueryCsr(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    CsrBenchGraph g(BenchGraph::fromEdges(es.begin(), es.end()));
+    DijkstraSearch<CsrBenchGraph> search(g);
+
+    std::mt19937 rng(42);
+    const UInt n = UInt(g.getVerticesNum());
+    for (auto _ : state)
+    {
+        UInt s = g.getVertexById(rng() % n);
+        UInt t = g.getVertexById(rng() % n);
+        benchmark::DoNotOptimize(search.run(s, t));
+    }
+}
+BENCHMARK(BM_DijkstraQueryCsr)->Apply(ssspArgs)->Unit(benchmark::kMicrosecond);
+
+
+// Adds arguments (family, edges number, threads) for road-like (grid) and
+// power-law graphs.
+static void deltaArgs(benchmark::internal::Benchmark* b)
+{
+    for (int gf : { int(GF_GRID), int(GF_POWER_LAW) })
+        for (std::int64_t m : { 1000000, 10000000 })
+            for (std::int64_t t : { 1, 2, 4, 8 })
+                b->Args({gf, m, t});
+}
+
+// Delta-stepping with the automatic delta; the search (and its copy of the
+// graph) is prepared once, as for many runs from landmarks.
+static void BM_DeltaStepping(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    CsrBenchGraph g(BenchGraph::fromEdges(es.begin(), es.end()));
+    DeltaSteppingSearch<CsrBenchGraph> search(g, 0, unsigned(state.range(2)));
+
+    UInt src = *g.getVertices().first;
+    for (auto _ : state)
+        search.run(src);
+
+    state.SetLabel(getFamilyName(int(state.range(0))));
+}
+BENCHMARK(BM_DeltaStepping)->Apply(deltaArgs)->Unit(benchmark::kMillisecond)
+                           ->UseRealTime();
+
+// The sequential baseline for the same graphs.
+static void BM_DeltaSteppingBaseline(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    CsrBenchGraph g(BenchGraph::fromEdges(es.begin(), es.end()));
+    DijkstraSearch<CsrBenchGraph> search(g);
+
+    UInt src = *g.getVertices().first;
+    for (auto _ : state)
+        search.run(src);
+
+    state.SetLabel(getFamilyName(int(state.range(0))));
+}
+BENCHMARK(BM_DeltaSteppingBaseline)->Args({GF_GRID, 1000000})
+                                   ->Args({GF_GRID, 10000000})
+                                   ->Args({GF_POWER_LAW, 1000000})
+                                   ->Args({GF_POWER_LAW, 10000000})
+                                   ->Unit(benchmark::kMillisecond);
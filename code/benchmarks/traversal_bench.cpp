@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for traversals of undirected graphs: the visitor-based
+/// BFS and the top-down and direction-optimizing parallel BFS.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/ugraph_traversal.hpp"
+
+
+typedef CsrEdgeLblUGraph<UInt, UInt> CsrBenchGraph;
+
+
+// Adds arguments (family, edges number) for graphs of small (gnp, power-law)
+// and large (grid) diameter.
+static void bfsArgs(benchmark::internal::Benchmark* b)
+{
+    for (int gf : { int(GF_RANDOM), int(GF_GRID), int(GF_POWER_LAW) })
+        for (std::int64_t m : { 100000, 1000000 })
+            b->Args({gf, m});
+}
+
+// The same with the number of threads.
+static void parBfsArgs(benchmark::internal::Benchmark* b)
+{
+    for (int gf : { int(GF_RANDOM), int(GF_GRID), int(GF_POWER_LAW) })
+        for (std::int64_t m : { 100000, 1000000 })
+            for (std::int64_t t : { 1, 2, 4 })
+                b->Args({gf, m, t});
+}
+
+
+// Level-synchronous BFS with a visitor counting vertices.
+static void BM_BfsVisitorCsr(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    CsrBenchGraph g(BenchGraph::fromEdges(es.begin(), es.end()));
+
+    struct Counter : TraversalVisitor {
+        size_t n = 0;
+        void discoverVertex(UInt, UInt) { ++n; }
+    };
+
+    UInt src = *g.getVertices().first;
+    for (auto _ : state)
+    {
+        Counter vis;
+        traverseBfs(g, src, vis);
+        benchmark::DoNotOptimize(vis.n);
+    }
+
+    state.SetLabel(getFamilyName(int(state.range(0))));
+}
+BENCHMARK(BM_BfsVisitorCsr)->Apply(bfsArgs)->Unit(benchmark::kMillisecond);
+
+
+// DirOptBfs with only top-down steps and with switching to bottom-up; the
+// copy of the graph is made once.
+template <bool DirOpt>
+static void dirOptBfsBody(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(int(state.range(0)),
+                                                size_t(state.range(1)));
+    CsrBenchGraph g(BenchGraph::fromEdges(es.begin(), es.end()));
+    DirOptBfs<CsrBenchGraph> bfs(g, unsigned(state.range(2)), DirOpt);
+
+    UInt src = *g.getVertices().first;
+    for (auto _ : state)
+        bfs.run(src);
+
+    // the share of half-edges examined by the last run
+    state.counters["examined"] = double(bfs.getExaminedEdgesNum())
+                                 / double(2 * g.getEdgesNum());
+    state.SetLabel(getFamilyName(int(state.range(0))));
+}
+
+static void BM_BfsTopDown(benchmark::State& state)
+{
+    dirOptBfsBody<false>(state);
+}
+BENCHMARK(BM_BfsTopDown)->Apply(parBfsArgs)->Unit(benchmark::kMillisecond)
+                        ->UseRealTime();
+
+static void BM_BfsDirOpt(benchmark::State& state)
+{
+    dirOptBfsBody<true>(state);
+}
+BENCHMARK(BM_BfsDirOpt)->Apply(parBfsArgs)->Unit(benchmark::kMillisecond)
+                       ->UseRealTime();
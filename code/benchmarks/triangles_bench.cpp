@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for triangle counting on sparse and dense representations
+/// of random graphs of different densities.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <vector>
+#include <random>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/dense_ugraph.hpp"
+#include "ugraph/ugraph_algos.hpp"
+
+
+typedef CsrUGraph<UInt> CsrBenchGraph;
+typedef DenseUGraph<UInt> DenseBenchGraph;
+
+
+/// Makes G(n, p) with \a n vertices and the edge probability \a permille / 1000.
+static UGraph<UInt> makeGnp(UInt n, int permille)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 999);
+    std::vector<std::pair<UInt, UInt>> es;
+    for (UInt v = 0; v < n; ++v)
+        for (UInt u = 0; u < v; ++u)
+            if (dist(rng) < permille)
+                es.push_back({u, v});
+
+    UGraph<UInt> g = UGraph<UInt>::fromEdges(es.begin(), es.end());
+    for (UInt v = 0; v < n; ++v)
+        g.addVertex(v);
+    return g;
+}
+
+// Adds arguments (vertices number, density in permille).
+static void trianglesArgs(benchmark::internal::Benchmark* b)
+{
+    for (std::int64_t n : { 2000, 8000 })
+        for (std::int64_t pm : { 1, 10, 100 })
+            b->Args({n, pm});
+}
+
+
+static void BM_TrianglesSparse(benchmark::State& state)
+{
+    CsrBenchGraph g(makeGnp(UInt(state.range(0)), int(state.range(1))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(countTrianglesSparse(g));
+}
+BENCHMARK(BM_TrianglesSparse)->Apply(trianglesArgs)->Unit(benchmark::kMillisecond);
+
+
+static void BM_TrianglesDense(benchmark::State& state)
+{
+    DenseBenchGraph g(makeGnp(UInt(state.range(0)), int(state.range(1))));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(countTrianglesDense(g));
+}
+BENCHMARK(BM_TrianglesDense)->Apply(trianglesArgs)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Benchmarks for building and traversing UGraph on synthetic graph
+/// families.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <random>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <ostream>
+#include <streambuf>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_graphs.hpp"
+#include "ugraph/node_pool.hpp"
+#include "grviz/ugraph_dotwriter.hpp"
+
+
+static void BM_UGraphAddEdge(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+
+    for (auto _ : state)
+    {
+        BenchGraph g;
+        addEdges(g, es);
+        benchmark::DoNotOptimize(g.getEdgesNum());
+    }
+
+    state.SetItemsProcessed(state.iterations() * es.size());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_UGraphAddEdge)->Apply(familyArgs)->Unit(benchmark::kMillisecond);
+
+
+static void BM_UGraphFromEdges(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+
+    for (auto _ : state)
+    {
+        BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+        benchmark::DoNotOptimize(g.getEdgesNum());
+    }
+
+    state.SetItemsProcessed(state.iterations() * es.size());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_UGraphFromEdges)->Apply(familyArgs)->Unit(benchmark::kMillisecond);
+
+
+// Half of the queries are existing edges, the other half are random pairs.
+static void BM_UGraphIsEdgeExists(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+
+    const size_t QUERIES_NUM = 1 << 16;
+    std::mt19937 rng(7);
+    std::vector<std::pair<UInt, UInt>> qs(QUERIES_NUM);
+    for (size_t i = 0; i < QUERIES_NUM; ++i)
+    {
+        const BenchEdge& e = es[rng() % es.size()];
+        if (i % 2 == 0)
+            qs[i] = {std::get<1>(e), std::get<0>(e)};
+        else
+            qs[i] = {std::get<0>(e), std::get<1>(es[rng() % es.size()])};
+    }
+
+    for (auto _ : state)
+    {
+        size_t found = 0;
+        for (const auto& q : qs)
+            found += g.isEdgeExists(q.first, q.second);
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.SetItemsProcessed(state.iterations() * QUERIES_NUM);
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_UGraphIsEdgeExists)->Apply(familyArgs)
+    ->Unit(benchmark::kMicrosecond);
+
+
+static void BM_UGraphAdjIteration(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+
+    for (auto _ : state)
+    {
+        UInt sum = 0;
+        BenchGraph::VertexIterPair vs = g.getVertices();
+        for (auto v = vs.first; v != vs.second; ++v)
+        {
+            BenchGraph::AdjListCIterPair adj = g.getAdjEdges(*v);
+            for (auto it = adj.first; it != adj.second; ++it)
+                sum += it->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2 * g.getEdgesNum());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_UGraphAdjIteration)->Apply(familyArgs)
+    ->Unit(benchmark::kMillisecond);
+
+
+static void BM_UGraphEdgeIter(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+
+    for (auto _ : state)
+    {
+        UInt sum = 0;
+        BenchGraph::EdgeIterPair eit = g.getEdges();
+        for (BenchGraph::EdgeIter it = eit.first; it != eit.second; ++it)
+            sum += it->first ^ it->second;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * g.getEdgesNum());
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_UGraphEdgeIter)->Apply(familyArgs)->Unit(benchmark::kMillisecond);
+
+
+// Families and sizes up to 10^5 edges.
+static void churnArgs(benchmark::internal::Benchmark* b)
+{
+    applyFamilyArgs(b, 5);
+}
+
+
+// Removes random vertices and adds their original edges back, with IDs
+// renumbered by every removal or kept by tombstones.
+template <bool Tombstones>
+static void churnBody(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+    g.setTombstoneMode(Tombstones);
+
+    std::unordered_map<UInt, std::vector<std::pair<UInt, UInt>>> adj;
+    for (const BenchEdge& e : es)
+    {
+        adj[std::get<0>(e)].push_back({std::get<1>(e), std::get<2>(e)});
+        adj[std::get<1>(e)].push_back({std::get<0>(e), std::get<2>(e)});
+    }
+
+    const size_t OPS_NUM = 1 << 10;
+    std::mt19937 rng(7);
+    std::vector<UInt> vs(OPS_NUM);
+    for (UInt& v : vs)
+        v = std::get<0>(es[rng() % es.size()]);
+
+    size_t halves = 0;
+    for (auto _ : state)
+    {
+        for (UInt v : vs)
+        {
+            g.removeVertex(v);
+            for (const auto& n : adj[v])
+                g.addLblEdge(v, n.first, n.second);
+            halves += adj[v].size();
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(halves));
+    state.SetLabel(getFamilyName(gf));
+}
+
+static void BM_UGraphChurnSwap(benchmark::State& state)
+{
+    churnBody<false>(state);
+}
+BENCHMARK(BM_UGraphChurnSwap)->Apply(churnArgs)->Unit(benchmark::kMillisecond);
+
+static void BM_UGraphChurnTombstones(benchmark::State& state)
+{
+    churnBody<true>(state);
+}
+BENCHMARK(BM_UGraphChurnTombstones)->Apply(churnArgs)
+    ->Unit(benchmark::kMillisecond);
+
+
+// Compacts a copy of the graph with a tenth of vertices removed.
+static void BM_UGraphCompact(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+    BenchGraph src = BenchGraph::fromEdges(es.begin(), es.end());
+    src.setTombstoneMode(true);
+    std::mt19937 rng(7);
+    for (size_t i = 0; i < src.getVerticesNum() / 10; ++i)
+        src.removeVertex(std::get<0>(es[rng() % es.size()]));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        BenchGraph g = src;
+        state.ResumeTiming();
+
+        g.compact();
+        benchmark::DoNotOptimize(g.getVerticesNum());
+    }
+
+    state.SetLabel(getFamilyName(gf));
+}
+BENCHMARK(BM_UGraphCompact)->Apply(churnArgs)->Unit(benchmark::kMillisecond);
+
+
+typedef EdgeLblUGraph<UInt, UInt, PoolAllocator<UInt>> PoolBenchGraph;
+
+// Families and sizes up to 10^6 edges.
+static void teardownArgs(benchmark::internal::Benchmark* b)
+{
+    applyFamilyArgs(b, 6);
+}
+
+// Builds a graph one edge at a time and destroys it, timing both phases.
+template <typename Graph>
+static void buildTeardownBody(benchmark::State& state)
+{
+    int gf = int(state.range(0));
+    std::vector<BenchEdge> es = makeFamilyGraph(gf, size_t(state.range(1)));
+
+    double buildTime = 0, teardownTime = 0;
+    for (auto _ : state)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<Graph> g(new Graph());
+        for (const BenchEdge& e : es)
+            g->addLblEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+        auto mid = std::chrono::steady_clock::now();
+        g.reset();
+        auto end = std::chrono::steady_clock::now();
+
+        buildTime += std::chrono::duration<double>(mid - start).count();
+        teardownTime += std::chrono::duration<double>(end - mid).count();
+    }
+
+    // average times in ms
+    state.counters["build"] = buildTime * 1000 / double(state.iterations());
+    state.counters["teardown"] = teardownTime * 1000
+                                 / double(state.iterations());
+    state.SetLabel(getFamilyName(gf));
+}
+
+static void BM_UGraphTeardownStd(benchmark::State& state)
+{
+    buildTeardownBody<BenchGraph>(state);
+}
+BENCHMARK(BM_UGraphTeardownStd)->Apply(teardownArgs)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_UGraphTeardownPool(benchmark::State& state)
+{
+    buildTeardownBody<PoolBenchGraph>(state);
+}
+BENCHMARK(BM_UGraphTeardownPool)->Apply(teardownArgs)
+    ->Unit(benchmark::kMillisecond);
+
+
+// Stream buffer dropping all output, so only formatting is measured.
+class NullStreamBuf : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Writes the body of a G(n,p) graph with the number of edges given by the arg.
+template <typename Visitor>
+static void dotWriteBody(benchmark::State& state)
+{
+    std::vector<BenchEdge> es = makeFamilyGraph(GF_RANDOM, size_t(state.range(0)));
+    BenchGraph g = BenchGraph::fromEdges(es.begin(), es.end());
+    NullStreamBuf nb;
+    std::ostream out(&nb);
+    Visitor vis;
+
+    for (auto _ : state)
+        vis.outputBody(out, g);
+
+    state.SetItemsProcessed(state.iterations() * g.getEdgesNum());
+}
+
+static void BM_DotWriteSlow(benchmark::State& state)
+{
+    dotWriteBody<EdgeLblUGraphDotVisitor<UInt, UInt>>(state);
+}
+BENCHMARK(BM_DotWriteSlow)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_DotWriteFast(benchmark::State& state)
+{
+    dotWriteBody<EdgeLblUGraphFastDotVisitor<UInt, UInt>>(state);
+}
+BENCHMARK(BM_DotWriteFast)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
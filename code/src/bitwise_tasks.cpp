@@ -1,19 +1,22 @@
 #include <iostream>
 
+#include "bitwise_tasks.hpp"
+
 int getBitAtIndex(unsigned int number, int idx)
 {
-    int bit = 0;
+    int bit = int((number >> idx) & 1u);
     return bit;
 }
 
 
 int countOnes(unsigned long long  number)
 {
-    int count = 0;
+    int count = int(popcountWord(number));
     return count;
 }
 
 void printBinary(unsigned int  number)
 {
-    
+    char buf[BINARY32_LEN];
+    std::cout.write(buf, toBinary(std::uint32_t(number), buf) - buf);
 }
@@ -0,0 +1,547 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains bulk bitwise kernels: popcounts over large bitmaps,
+///             bit extraction over arrays of numbers and binary formatting.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+/// Each kernel has a portable version and, on x86 with GCC or Clang, AVX2 and
+/// AVX-512 versions compiled for their targets by function attributes, so the
+/// rest of the program needs no special flags. The best version supported by
+/// the CPU is chosen once at run time.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef BITWISE_TASKS_HPP
+#define BITWISE_TASKS_HPP
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BITWISE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+
+/// Instruction sets a kernel may use.
+enum class BitwiseIsa { Scalar, Avx2, Avx512 };
+
+
+/// Returns true if the CPU supports AVX2.
+inline bool hasAvx2()
+{
+#ifdef BITWISE_X86_SIMD
+    static const bool res = __builtin_cpu_supports("avx2");
+    return res;
+#else
+    return false;
+#endif
+}
+
+/// Returns true if the CPU supports AVX-512 with the VPOPCNTDQ extension.
+inline bool hasAvx512Popcnt()
+{
+#ifdef BITWISE_X86_SIMD
+    static const bool res = __builtin_cpu_supports("avx512f")
+                            && __builtin_cpu_supports("avx512vpopcntdq");
+    return res;
+#else
+    return false;
+#endif
+}
+
+/// Returns the best instruction set supported by the CPU.
+inline BitwiseIsa getBestBitwiseIsa()
+{
+    if (hasAvx512Popcnt())
+        return BitwiseIsa::Avx512;
+    if (hasAvx2())
+        return BitwiseIsa::Avx2;
+    return BitwiseIsa::Scalar;
+}
+
+
+//------------------------------------------------------------------------------
+// Popcount
+
+
+/// Counts ones in the word \a w without special instructions.
+inline unsigned int popcountWord(std::uint64_t w)
+{
+    // sums bits in pairs, nibbles and bytes in parallel
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return unsigned((w * 0x0101010101010101ULL) >> 56);
+}
+
+/// Counts ones in \a n words starting from \a words, portable version.
+inline std::uint64_t countOnesScalar(const std::uint64_t* words, size_t n)
+{
+    std::uint64_t cnt = 0;
+    for (size_t i = 0; i < n; ++i)
+        cnt += popcountWord(words[i]);
+    return cnt;
+}
+
+#ifdef BITWISE_X86_SIMD
+
+/// AVX2 version: counts nibbles' ones by a lookup table in a register
+/// (vpshufb) and sums bytes by vpsadbw (W. Muła's method).
+__attribute__((target("avx2")))
+inline std::uint64_t countOnesAvx2(const std::uint64_t* words, size_t n)
+{
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        __m256i lo = _mm256_and_si256(v, lowMask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo),
+                                      _mm256_shuffle_epi8(lut, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+    }
+
+    std::uint64_t res = std::uint64_t(_mm256_extract_epi64(acc, 0))
+                      + std::uint64_t(_mm256_extract_epi64(acc, 1))
+                      + std::uint64_t(_mm256_extract_epi64(acc, 2))
+                      + std::uint64_t(_mm256_extract_epi64(acc, 3));
+
+    return res + countOnesScalar(words + i, n - i);
+}
+
+/// Sums 64-bit lanes of \a v. Lanes are stored and added by hand: the
+/// expansions of _mm512_reduce_add_epi64() and _mm512_extracti64x4_epi64()
+/// take _mm256_undefined_si256(), which GCC 12 reports by -Wuninitialized
+/// at -O2 (GCC bug 105593).
+__attribute__((target("avx512f")))
+inline std::uint64_t sumLanesAvx512(__m512i v)
+{
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, v);
+
+    std::uint64_t res = 0;
+    for (std::uint64_t l : lanes)
+        res += l;
+    return res;
+}
+
+/// AVX-512 version: counts ones in 8 words at once by vpopcntq.
+__attribute__((target("avx512f,avx512vpopcntdq")))
+inline std::uint64_t countOnesAvx512(const std::uint64_t* words, size_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512i v = _mm512_loadu_si512(words + i);
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+    }
+
+    // the tail is loaded by a mask
+    if (i < n)
+    {
+        __mmask8 m = __mmask8((1u << (n - i)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi64(m, words + i);
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+    }
+
+    return sumLanesAvx512(acc);
+}
+
+#endif // BITWISE_X86_SIMD
+
+
+/// Counts ones in \a n words starting from \a words using the instruction set
+/// \a isa, which must be supported by the CPU.
+inline std::uint64_t countOnes(const std::uint64_t* words, size_t n,
+                               BitwiseIsa isa)
+{
+#ifdef BITWISE_X86_SIMD
+    if (isa == BitwiseIsa::Avx512)
+        return countOnesAvx512(words, n);
+    if (isa == BitwiseIsa::Avx2)
+        return countOnesAvx2(words, n);
+#endif
+    (void)isa;
+    return countOnesScalar(words, n);
+}
+
+/// Counts ones in \a n words starting from \a words using the best
+/// instruction set supported by the CPU.
+inline std::uint64_t countOnes(const std::uint64_t* words, size_t n)
+{
+    static const BitwiseIsa isa = getBestBitwiseIsa();
+    return countOnes(words, n, isa);
+}
+
+/// Counts ones in the bitmap \a words.
+inline std::uint64_t countOnes(const std::vector<std::uint64_t>& words)
+{
+    return countOnes(words.data(), words.size());
+}
+
+
+/// Counts ones in the bitwise AND of \a n words starting from \a a and \a b
+/// (i.e. the size of the intersection of two bitsets), portable version.
+inline std::uint64_t countOnesAndScalar(const std::uint64_t* a,
+                                        const std::uint64_t* b, size_t n)
+{
+    std::uint64_t cnt = 0;
+    for (size_t i = 0; i < n; ++i)
+        cnt += popcountWord(a[i] & b[i]);
+    return cnt;
+}
+
+#ifdef BITWISE_X86_SIMD
+
+/// AVX2 version of countOnesAndScalar(), see countOnesAvx2().
+__attribute__((target("avx2")))
+inline std::uint64_t countOnesAndAvx2(const std::uint64_t* a,
+                                      const std::uint64_t* b, size_t n)
+{
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_and_si256(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        __m256i lo = _mm256_and_si256(v, lowMask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo),
+                                      _mm256_shuffle_epi8(lut, hi));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+    }
+
+    std::uint64_t res = std::uint64_t(_mm256_extract_epi64(acc, 0))
+                      + std::uint64_t(_mm256_extract_epi64(acc, 1))
+                      + std::uint64_t(_mm256_extract_epi64(acc, 2))
+                      + std::uint64_t(_mm256_extract_epi64(acc, 3));
+
+    return res + countOnesAndScalar(a + i, b + i, n - i);
+}
+
+/// AVX-512 version of countOnesAndScalar(), see countOnesAvx512().
+__attribute__((target("avx512f,avx512vpopcntdq")))
+inline std::uint64_t countOnesAndAvx512(const std::uint64_t* a,
+                                        const std::uint64_t* b, size_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512i v = _mm512_and_si512(_mm512_loadu_si512(a + i),
+                                     _mm512_loadu_si512(b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+    }
+
+    if (i < n)
+    {
+        __mmask8 m = __mmask8((1u << (n - i)) - 1);
+        __m512i v = _mm512_and_si512(_mm512_maskz_loadu_epi64(m, a + i),
+                                     _mm512_maskz_loadu_epi64(m, b + i));
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+    }
+
+    return sumLanesAvx512(acc);
+}
+
+#endif // BITWISE_X86_SIMD
+
+
+/// Counts ones in the bitwise AND of \a n words starting from \a a and \a b
+/// using the instruction set \a isa, which must be supported by the CPU.
+inline std::uint64_t countOnesAnd(const std::uint64_t* a,
+                                  const std::uint64_t* b, size_t n,
+                                  BitwiseIsa isa)
+{
+#ifdef BITWISE_X86_SIMD
+    if (isa == BitwiseIsa::Avx512)
+        return countOnesAndAvx512(a, b, n);
+    if (isa == BitwiseIsa::Avx2)
+        return countOnesAndAvx2(a, b, n);
+#endif
+    (void)isa;
+    return countOnesAndScalar(a, b, n);
+}
+
+/// Counts ones in the bitwise AND of \a n words starting from \a a and \a b
+/// using the best instruction set supported by the CPU.
+inline std::uint64_t countOnesAnd(const std::uint64_t* a,
+                                  const std::uint64_t* b, size_t n)
+{
+    static const BitwiseIsa isa = getBestBitwiseIsa();
+    return countOnesAnd(a, b, n, isa);
+}
+
+
+//------------------------------------------------------------------------------
+// Bit extraction
+
+
+/// Returns the bit with index \a idx of the bitmap \a words.
+inline int getBitmapBit(const std::uint64_t* words, size_t idx)
+{
+    return int((words[idx / 64] >> (idx % 64)) & 1);
+}
+
+/// Writes the bit with index \a idx (0 to 31) of each of \a n numbers to
+/// \a bits, portable version.
+inline void getBitsAtIndexScalar(const std::uint32_t* numbers, size_t n,
+                                 int idx, std::uint8_t* bits)
+{
+    for (size_t i = 0; i < n; ++i)
+        bits[i] = std::uint8_t((numbers[i] >> idx) & 1);
+}
+
+#ifdef BITWISE_X86_SIMD
+
+/// AVX2 version: shifts and masks 32 numbers at once and packs the results
+/// into bytes.
+__attribute__((target("avx2")))
+inline void getBitsAtIndexAvx2(const std::uint32_t* numbers, size_t n,
+                               int idx, std::uint8_t* bits)
+{
+    const __m128i shift = _mm_cvtsi32_si128(idx);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    // packs mix 128-bit lanes, this permutation restores the order
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            __m256i x = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(numbers + i + 8 * k));
+            v[k] = _mm256_and_si256(_mm256_srl_epi32(x, shift), one);
+        }
+
+        __m256i w01 = _mm256_packus_epi32(v[0], v[1]);
+        __m256i w23 = _mm256_packus_epi32(v[2], v[3]);
+        __m256i b = _mm256_packus_epi16(w01, w23);
+        b = _mm256_permutevar8x32_epi32(b, order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bits + i), b);
+    }
+
+    getBitsAtIndexScalar(numbers + i, n - i, idx, bits + i);
+}
+
+#endif // BITWISE_X86_SIMD
+
+/// Writes the bit with index \a idx (0 to 31) of each of \a n numbers to
+/// \a bits using the instruction set \a isa, which must be supported by the
+/// CPU (AVX2 is used for AVX-512 too).
+inline void getBitsAtIndex(const std::uint32_t* numbers, size_t n, int idx,
+                           std::uint8_t* bits, BitwiseIsa isa)
+{
+#ifdef BITWISE_X86_SIMD
+    if (isa != BitwiseIsa::Scalar)
+    {
+        getBitsAtIndexAvx2(numbers, n, idx, bits);
+        return;
+    }
+#endif
+    (void)isa;
+    getBitsAtIndexScalar(numbers, n, idx, bits);
+}
+
+/// Writes the bit with index \a idx (0 to 31) of each of \a n numbers to
+/// \a bits using the best instruction set supported by the CPU.
+inline void getBitsAtIndex(const std::uint32_t* numbers, size_t n, int idx,
+                           std::uint8_t* bits)
+{
+    static const BitwiseIsa isa = getBestBitwiseIsa();
+    getBitsAtIndex(numbers, n, idx, bits, isa);
+}
+
+
+//------------------------------------------------------------------------------
+// Binary formatting
+
+
+/// Number of characters in the binary form of a 32-bit number.
+const size_t BINARY32_LEN = 32;
+
+/// Number of characters in the binary form of a 64-bit number.
+const size_t BINARY64_LEN = 64;
+
+
+/*! ****************************************************************************
+ *  \brief Table of binary forms of all bytes: the entry b holds 8 characters
+ *  '0'/'1' of the byte b, the most significant bit first.
+ ******************************************************************************/
+struct BinaryByteTable {
+    BinaryByteTable()
+    {
+        for (unsigned int b = 0; b < 256; ++b)
+            for (unsigned int k = 0; k < 8; ++k)
+                chars[b][k] = char('0' + ((b >> (7 - k)) & 1));
+    }
+
+    /// Returns the table, which is built on the first call.
+    static const BinaryByteTable& get()
+    {
+        static const BinaryByteTable table;
+        return table;
+    }
+
+    char chars[256][8];
+}; // struct BinaryByteTable
+
+
+/// Writes 32 characters '0'/'1' of \a x, the most significant bit first, to
+/// \a buf and returns the pointer past the last written one. No terminating
+/// zero is written. Portable version, converts a byte at a time by a table.
+inline char* toBinaryScalar(std::uint32_t x, char* buf)
+{
+    const BinaryByteTable& t = BinaryByteTable::get();
+    for (int i = 0; i < 4; ++i)
+        std::memcpy(buf + 8 * i, t.chars[(x >> (24 - 8 * i)) & 0xff], 8);
+    return buf + BINARY32_LEN;
+}
+
+/// The same as toBinaryScalar(std::uint32_t, char*) for 64 characters of \a x.
+inline char* toBinaryScalar(std::uint64_t x, char* buf)
+{
+    buf = toBinaryScalar(std::uint32_t(x >> 32), buf);
+    return toBinaryScalar(std::uint32_t(x), buf);
+}
+
+#ifdef BITWISE_X86_SIMD
+
+/// AVX2 version of toBinaryScalar(): spreads the bytes of \a x over 32 bytes
+/// of a register, MSB byte first, and tests each byte against its own bit.
+__attribute__((target("avx2")))
+inline char* toBinaryAvx2(std::uint32_t x, char* buf)
+{
+    // both 128-bit lanes contain all of x, so in-lane shuffles suffice
+    const __m256i spread = _mm256_setr_epi8(3, 3, 3, 3, 3, 3, 3, 3,
+                                            2, 2, 2, 2, 2, 2, 2, 2,
+                                            1, 1, 1, 1, 1, 1, 1, 1,
+                                            0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i bits = _mm256_set1_epi64x(0x0102040810204080LL);
+
+    __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(int(x)), spread);
+    __m256i set = _mm256_cmpeq_epi8(_mm256_and_si256(v, bits), bits);
+
+    // '0' - (-1) gives '1' for set bits
+    __m256i res = _mm256_sub_epi8(_mm256_set1_epi8('0'), set);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(buf), res);
+    return buf + BINARY32_LEN;
+}
+
+/// AVX2 version of toBinaryScalar(std::uint64_t, char*).
+__attribute__((target("avx2")))
+inline char* toBinaryAvx2(std::uint64_t x, char* buf)
+{
+    buf = toBinaryAvx2(std::uint32_t(x >> 32), buf);
+    return toBinaryAvx2(std::uint32_t(x), buf);
+}
+
+#endif // BITWISE_X86_SIMD
+
+
+/// Writes 32 characters '0'/'1' of \a x to \a buf and returns the pointer past
+/// the last written one, see toBinaryScalar().
+inline char* toBinary(std::uint32_t x, char* buf)
+{
+#ifdef BITWISE_X86_SIMD
+    if (hasAvx2())
+        return toBinaryAvx2(x, buf);
+#endif
+    return toBinaryScalar(x, buf);
+}
+
+/// Writes 64 characters '0'/'1' of \a x to \a buf and returns the pointer past
+/// the last written one, see toBinaryScalar().
+inline char* toBinary(std::uint64_t x, char* buf)
+{
+#ifdef BITWISE_X86_SIMD
+    if (hasAvx2())
+        return toBinaryAvx2(x, buf);
+#endif
+    return toBinaryScalar(x, buf);
+}
+
+/// Returns a string of 32 characters '0'/'1' of \a x.
+inline std::string toBinaryString(std::uint32_t x)
+{
+    char buf[BINARY32_LEN];
+    return std::string(buf, toBinary(x, buf));
+}
+
+/// Returns a string of 64 characters '0'/'1' of \a x.
+inline std::string toBinaryString(std::uint64_t x)
+{
+    char buf[BINARY64_LEN];
+    return std::string(buf, toBinary(x, buf));
+}
+
+
+/// Writes binary forms of \a n numbers starting from \a numbers to \a buf,
+/// each followed by the separator \a sep, using the instruction set \a isa,
+/// which must be supported by the CPU (AVX2 is used for AVX-512 too).
+///
+/// \a buf must have room for n * (BINARY32_LEN + 1) characters (or
+/// BINARY64_LEN + 1 for 64-bit numbers). Returns the pointer past the last
+/// written character.
+template <typename UIntT>
+char* toBinaryBulk(const UIntT* numbers, size_t n, char* buf, char sep,
+                   BitwiseIsa isa)
+{
+#ifdef BITWISE_X86_SIMD
+    if (isa != BitwiseIsa::Scalar)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            buf = toBinaryAvx2(numbers[i], buf);
+            *buf++ = sep;
+        }
+        return buf;
+    }
+#endif
+    (void)isa;
+    for (size_t i = 0; i < n; ++i)
+    {
+        buf = toBinaryScalar(numbers[i], buf);
+        *buf++ = sep;
+    }
+    return buf;
+}
+
+/// Writes binary forms of \a n numbers using the best instruction set
+/// supported by the CPU, see above.
+template <typename UIntT>
+char* toBinaryBulk(const UIntT* numbers, size_t n, char* buf, char sep = '\n')
+{
+    static const BitwiseIsa isa = getBestBitwiseIsa();
+    return toBinaryBulk(numbers, n, buf, sep, isa);
+}
+
+
+#endif // BITWISE_TASKS_HPP
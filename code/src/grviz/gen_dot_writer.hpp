@@ -18,7 +18,12 @@
 // std
 #include <list>
 #include <string>
+#include <vector>
 #include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
 
 namespace xi { namespace ldopa { namespace graph {
 
@@ -154,6 +159,221 @@ struct DefaultDotVisitor
 //=============================================================================
 
 
+/*! ****************************************************************************
+ *  \brief Output buffer for fast writing of DOT files.
+ *
+ *  Values are formatted right into a large reusable buffer, which is passed
+ *  to the stream only when full, so writing an element costs no heap
+ *  allocations. Integers are formatted manually, floating point values by
+ *  snprintf() with the same "%g" format as std::ostream uses by default,
+ *  values of other types fall back to a std::stringstream.
+ ******************************************************************************/
+class DotOutBuffer
+{
+public:
+    /** \brief Default capacity of the buffer. */
+    static const size_t DEF_CAPACITY = 1 << 20;
+
+public:
+    //----<Constructors>----
+    DotOutBuffer(size_t capacity = DEF_CAPACITY)
+        : _capacity(capacity > 32 ? capacity : 32)
+    {
+    }
+
+    //----<Main methods>----
+
+    /// Starts writing to the stream \a str; the buffer memory is allocated
+    /// once and reused by subsequent writes.
+    void begin(std::ostream& str)
+    {
+        _str = &str;
+        _len = 0;
+        if (_buf.empty())
+            _buf.resize(_capacity);
+    }
+
+    /// Passes the rest of the buffer to the stream and detaches from it.
+    void end()
+    {
+        flush();
+        _str = nullptr;
+    }
+
+    /// Passes the contents of the buffer to the stream.
+    void flush()
+    {
+        if (_len != 0)
+            _str->write(_buf.data(), std::streamsize(_len));
+        _len = 0;
+    }
+
+    void append(char c)
+    {
+        if (_len == _capacity)
+            flush();
+        _buf[_len++] = c;
+    }
+
+    void append(const char* s, size_t n)
+    {
+        if (_len + n > _capacity)
+        {
+            flush();
+            if (n > _capacity)          // too long to be buffered
+            {
+                _str->write(s, std::streamsize(n));
+                return;
+            }
+        }
+
+        std::memcpy(_buf.data() + _len, s, n);
+        _len += n;
+    }
+
+    void append(const char* s) { append(s, std::strlen(s)); }
+
+    /// Appends the decimal representation of \a v.
+    void appendUInt(unsigned long long v)
+    {
+        static const char DIGITS[] =
+            "0001020304050607080910111213141516171819"
+            "2021222324252627282930313233343536373839"
+            "4041424344454647484950515253545556575859"
+            "6061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        // digits are made by pairs from the end
+        char tmp[24];
+        char* p = tmp + sizeof(tmp);
+        while (v >= 100)
+        {
+            unsigned int i = unsigned(v % 100) * 2;
+            v /= 100;
+            *--p = DIGITS[i + 1];
+            *--p = DIGITS[i];
+        }
+        if (v >= 10)
+        {
+            unsigned int i = unsigned(v) * 2;
+            *--p = DIGITS[i + 1];
+            *--p = DIGITS[i];
+        }
+        else
+            *--p = char('0' + v);
+
+        append(p, size_t(tmp + sizeof(tmp) - p));
+    }
+
+    /// Appends the decimal representation of \a v.
+    void appendInt(long long v)
+    {
+        if (v < 0)
+        {
+            append('-');
+            appendUInt(0ULL - (unsigned long long)v);
+        }
+        else
+            appendUInt((unsigned long long)v);
+    }
+
+    /// Appends \a v as std::ostream does by default.
+    void appendDouble(double v)
+    {
+        char tmp[32];
+        int n = std::snprintf(tmp, sizeof(tmp), "%g", v);
+        append(tmp, size_t(n));
+    }
+
+    //----<Values of arbitrary types>----
+
+    /// Characters are written as they are, as by std::ostream.
+    void appendValue(char c) { append(c); }
+    void appendValue(signed char c) { append(char(c)); }
+    void appendValue(unsigned char c) { append(char(c)); }
+
+    void appendValue(const std::string& s) { append(s.data(), s.size()); }
+    void appendValue(const char* s) { append(s); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+        appendValue(T v) { appendInt(v); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+        appendValue(T v) { appendUInt(v); }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+        appendValue(T v) { appendDouble(double(v)); }
+
+    /// Slow path for other types: uses their operator<<.
+    template <typename T>
+    typename std::enable_if<!std::is_arithmetic<T>::value>::type
+        appendValue(const T& v)
+    {
+        std::stringstream ss;
+        ss << v;
+        appendValue(ss.str());
+    }
+
+    /// Appends \a v enclosed into dblquotes with special symbols escaped, as
+    /// DefaultDotVisitor::makeEscapedString() does.
+    template <typename T>
+    void appendQuoted(const T& v)
+    {
+        append('\"');
+        appendQuotedBody(v, std::is_arithmetic<T>());
+        append('\"');
+    }
+
+protected:
+    /// Numbers need no escaping.
+    template <typename T>
+    void appendQuotedBody(const T& v, std::true_type) { appendValue(v); }
+
+    /// Characters are arithmetic too but are written as they are, so they
+    /// may need escaping.
+    void appendQuotedBody(char c, std::true_type) { appendEscaped(c); }
+    void appendQuotedBody(signed char c, std::true_type) { appendEscaped(char(c)); }
+    void appendQuotedBody(unsigned char c, std::true_type) { appendEscaped(char(c)); }
+
+    template <typename T>
+    void appendQuotedBody(const T& v, std::false_type)
+    {
+        std::stringstream ss;
+        ss << v;
+        appendEscaped(ss.str());
+    }
+
+    void appendQuotedBody(const std::string& s, std::false_type)
+    {
+        appendEscaped(s);
+    }
+
+    void appendEscaped(const std::string& s)
+    {
+        for (char c : s)
+            appendEscaped(c);
+    }
+
+    void appendEscaped(char c)
+    {
+        if (c == '"' || c == '\\')
+            append('\\');
+        append(c);
+    }
+
+protected:
+    std::vector<char> _buf;             ///< Buffer, allocated on first use.
+    size_t _capacity;                   ///< Capacity of the buffer.
+    size_t _len = 0;                    ///< Number of buffered chars.
+    std::ostream* _str = nullptr;       ///< Current stream.
+}; // class DotOutBuffer
+
+//=============================================================================
+
+
 /*! ****************************************************************************
  *  \brief Generic DOT-writer.
  *
@@ -20,16 +20,21 @@
 
 #include "gen_dot_writer.hpp"
 #include "../ugraph/lbl_ugraph.hpp"
+#include "../ugraph/csr_ugraph.hpp"
 
 
-/** \brief DOT-writer for EvLogTSWithFreqs models. */
-template <typename Vertex, typename EdgeLbl>
+/** \brief DOT-writer for EvLogTSWithFreqs models.
+ *
+ *  \tparam TGraph is a labeled graph type: EdgeLblUGraph (by default) or any
+ *  other one providing the same iteration interface, e.g. CsrEdgeLblUGraph.
+ */
+template <typename Vertex, typename EdgeLbl,
+          typename TGraph = EdgeLblUGraph<Vertex, EdgeLbl> >
 struct EdgeLblUGraphDotVisitor :
-    public xi::ldopa::graph::DefaultDotVisitor < EdgeLblUGraph<Vertex, EdgeLbl> >
+    public xi::ldopa::graph::DefaultDotVisitor < TGraph >
 {
-    typedef EdgeLblUGraph<Vertex, EdgeLbl> Graph;
-    typedef xi::ldopa::graph::DefaultDotVisitor
-        < EdgeLblUGraph<Vertex, EdgeLbl> > Base;
+    typedef TGraph Graph;
+    typedef xi::ldopa::graph::DefaultDotVisitor < TGraph > Base;
 
 
     EdgeLblUGraphDotVisitor() : Base(Base::Sort::graph) {}
@@ -65,6 +70,58 @@ struct EdgeLblUGraphDotVisitor :
 
 
 
+/** \brief Fast DOT-writer visitor for labeled graphs.
+ *
+ *  Gives exactly the same output as EdgeLblUGraphDotVisitor, but formats
+ *  vertices and labels right into a reusable DotOutBuffer instead of building
+ *  strings and lists of parameters for each edge.
+ */
+template <typename Vertex, typename EdgeLbl,
+          typename TGraph = EdgeLblUGraph<Vertex, EdgeLbl> >
+struct EdgeLblUGraphFastDotVisitor :
+    public EdgeLblUGraphDotVisitor < Vertex, EdgeLbl, TGraph >
+{
+    typedef TGraph Graph;
+
+    void outputBody(std::ostream& str, const Graph& g)
+    {
+        buf.begin(str);
+
+        // enumerates all vertices
+        typename Graph::VertexIterPair vs = g.getVertices();
+        for(typename Graph::VertexIter it = vs.first; it != vs.second; ++it)
+        {
+            buf.appendValue(*it);
+            buf.append('\n');
+        }
+
+        // enumerates all edges
+        typename Graph::EdgeIterPair es = g.getEdges();
+        for(typename Graph::EdgeIter it = es.first; it != es.second; ++it)
+        {
+            buf.appendValue(it->first);
+            buf.append(" -- ", 4);
+            buf.appendValue(it->second);
+            buf.append(' ');
+
+            EdgeLbl lbl;
+            if(g.getLabel(it->first, it->second, lbl))
+            {
+                buf.append("[label=", 7);
+                buf.appendQuoted(lbl);
+                buf.append(']');
+            }
+            buf.append('\n');
+        }
+
+        buf.end();
+    }
+
+    /// Output buffer reused by all writes of this visitor.
+    xi::ldopa::graph::DotOutBuffer buf;
+};
+
+
 /*! ****************************************************************************
  *  \brief Metafunction for typedefing templates.
  *
@@ -77,7 +134,22 @@ template <typename Vertex, typename EdgeLbl>
 struct EdgeLblUGraphDotWriter
 {
     typedef xi::ldopa::graph::GenDotWriter < EdgeLblUGraph<Vertex, EdgeLbl>,
-                                             EdgeLblUGraphDotVisitor<Vertex, EdgeLbl> >
+                                             EdgeLblUGraphFastDotVisitor<Vertex, EdgeLbl> >
+            Type;
+};
+
+
+/*! ****************************************************************************
+ *  \brief Metafunction for typedefing DOT-writers for CSR labeled graphs.
+ *
+ *  Usage: CsrEdgeLblUGraphDotWriter<T1, T2>::Type...
+ ******************************************************************************/
+template <typename Vertex, typename EdgeLbl>
+struct CsrEdgeLblUGraphDotWriter
+{
+    typedef CsrEdgeLblUGraph<Vertex, EdgeLbl> Graph;
+    typedef xi::ldopa::graph::GenDotWriter < Graph,
+                EdgeLblUGraphFastDotVisitor<Vertex, EdgeLbl, Graph> >
             Type;
 };
 
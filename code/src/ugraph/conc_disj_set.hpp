@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains definitions of a concurrent union-find data structure.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       29.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CONC_DISJ_SET_HPP_
+#define CONC_DISJ_SET_HPP_
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <cstddef>
+
+
+/*! ****************************************************************************
+ *  \brief Implements lock-free union-find structure for representing a forest
+ *  of disjoint sets of integer handles, safe for concurrent use.
+ *
+ *  The number of elements is fixed at construction; elements are handles
+ *  0, 1, ..., n - 1 as in FlatDisjointSetForest. Any number of threads may
+ *  call find(), merge() and isSameSet() simultaneously.
+ *
+ *  The implementation follows Jayanti and Tarjan: a root is linked below
+ *  another one with a single CAS on the parent array, which fails (and the
+ *  operation is retried) only if some other thread has linked that root
+ *  meanwhile. Instead of ranks, roots are ordered by fixed pseudo-random
+ *  priorities derived from handles (randomized linking), so no extra word
+ *  needs to be updated atomically together with the parent. Find performs
+ *  path halving with CAS, which is safe since it only shortcuts a node to
+ *  one of its ancestors.
+ ******************************************************************************/
+class ConcurrentDisjointSetForest {
+public:
+
+    typedef unsigned int UInt;
+
+    /// Type of element handles.
+    typedef UInt Handle;
+
+public:
+    // Constructors, destructors and all the guys.
+
+    /// Makes \a n singletons 0, 1, ..., n - 1.
+    explicit ConcurrentDisjointSetForest(size_t n)
+        : _par(new std::atomic<UInt>[n])
+        , _size(n)
+    {
+        for (size_t h = 0; h < n; ++h)
+            _par[h].store(UInt(h), std::memory_order_relaxed);
+    }
+
+    ConcurrentDisjointSetForest(const ConcurrentDisjointSetForest&) = delete;
+    ConcurrentDisjointSetForest& operator=(const ConcurrentDisjointSetForest&) = delete;
+
+public:
+    // ADS operations
+
+    /// Find the representative of the provided element.
+    ///
+    /// In presence of concurrent merges, the result is a node that was the
+    /// representative at some moment during the call.
+    Handle find(Handle x)
+    {
+        while (true)
+        {
+            UInt p = _par[x].load(std::memory_order_acquire);
+            if (p == x)
+                return x;
+
+            UInt gp = _par[p].load(std::memory_order_acquire);
+            if (p != gp)            // path halving: try to skip the parent
+                _par[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel,
+                                              std::memory_order_acquire);
+            x = gp;
+        }
+    }
+
+    /// Unites the sets containing \a x and \a y.
+    /// \return true if this call united two different sets, false if the
+    /// elements were already in the same set.
+    bool merge(Handle x, Handle y)
+    {
+        while (true)
+        {
+            Handle rx = find(x);
+            Handle ry = find(y);
+            if (rx == ry)
+                return false;
+
+            // the root with the lower priority goes below the other one
+            if (isLowerPriority(ry, rx))
+                std::swap(rx, ry);
+
+            UInt expected = rx;
+            if (_par[rx].compare_exchange_strong(expected, ry,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire))
+                return true;
+
+            // rx has been linked by another thread, try again
+            x = rx;
+            y = ry;
+        }
+    }
+
+    /// Returns true if \a x and \a y belong to the same set.
+    bool isSameSet(Handle x, Handle y)
+    {
+        while (true)
+        {
+            Handle rx = find(x);
+            Handle ry = find(y);
+            if (rx == ry)
+                return true;
+
+            // if rx is still a root, the sets were different at that moment
+            if (_par[rx].load(std::memory_order_acquire) == rx)
+                return false;
+
+            x = rx;
+            y = ry;
+        }
+    }
+
+    /// Returns the parent of the element \a x.
+    Handle getPar(Handle x) const { return _par[x].load(std::memory_order_acquire); }
+
+    /// \returns true if the element is the representative
+    bool isRepresentative(Handle x) const { return getPar(x) == x; }
+
+    /// Returns the number of elements.
+    size_t getSize() const { return _size; }
+
+protected:
+
+    /// Pseudo-random priority of a handle: a bijective mix of its bits, so
+    /// distinct handles have distinct priorities.
+    static UInt getPriority(UInt h)
+    {
+        h ^= h >> 16;
+        h *= 0x7feb352dU;
+        h ^= h >> 15;
+        h *= 0x846ca68bU;
+        h ^= h >> 16;
+        return h;
+    }
+
+    /// Returns true if \a a must be linked below \a b.
+    static bool isLowerPriority(UInt a, UInt b)
+    {
+        return getPriority(a) < getPriority(b);
+    }
+
+protected:
+
+    std::unique_ptr<std::atomic<UInt>[]> _par;      ///< Parents of elements.
+    size_t _size;                                   ///< Number of elements.
+
+}; // class ConcurrentDisjointSetForest
+
+
+#endif // CONC_DISJ_SET_HPP_
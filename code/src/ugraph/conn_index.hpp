@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of the index of connected components
+///             kept up to date with a growing graph.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CONN_INDEX_HPP
+#define CONN_INDEX_HPP
+
+#include <vector>
+#include <map>
+
+#include "ugraph.hpp"
+#include "disj_set.hpp"
+#include "ugraph_par_algos.hpp"
+
+
+/*! ****************************************************************************
+ *  \brief Index of connected components attached to a graph, answering
+ *  connectivity queries in nearly O(1).
+ *
+ *  \tparam Graph is UGraph or a class derived from it, e.g. EdgeLblUGraph.
+ *
+ *  The index is built once (by connectedComponentsSV(), in parallel if asked)
+ *  and then listens to the graph: every new vertex makes a singleton and every
+ *  new edge merges two sets of a FlatDisjointSetForest, so adding edges in
+ *  batches needs no rebuilds. Sizes of components are kept at representatives.
+ *  Removals cannot be undone in the forest: they mark the index as stale, and
+ *  the next query rebuilds it. Tombstones of the graph are isolated vertices
+ *  for the forest and are not counted as components.
+ *
+ *  The graph must outlive the index. Queries use path halving and so change
+ *  the forest; concurrent queries need external synchronization.
+ ******************************************************************************/
+template <typename Graph>
+class ConnectivityIndex : public UGraphListener {
+public:
+    typedef unsigned int UInt;
+    typedef typename Graph::Edge::first_type Vertex;
+
+public:
+    /// Builds the index of the graph \a g using \a threadsNum threads (0 means
+    /// all available cores) and attaches it to the graph.
+    explicit ConnectivityIndex(Graph& g, unsigned int threadsNum = 1)
+        : _g(g)
+        , _threadsNum(threadsNum)
+    {
+        build();
+        _g.addListener(this);
+    }
+
+    ~ConnectivityIndex() override
+    {
+        _g.removeListener(this);
+    }
+
+    // the index is bound to a graph object
+    ConnectivityIndex(const ConnectivityIndex&) = delete;
+    ConnectivityIndex& operator=(const ConnectivityIndex&) = delete;
+
+public:
+    /// Returns true if the vertices \a u and \a v are in the same component.
+    /// If no such vertices, throws std::invalid_argument.
+    bool connected(Vertex u, Vertex v)
+    {
+        refresh();
+        return _dsf.find(_g.getVertexId(u)) == _dsf.find(_g.getVertexId(v));
+    }
+
+    /// Returns the component of the vertex \a v given by the ID of its
+    /// representative; it stays the same until the component is merged with
+    /// another one. If no such vertex, throws std::invalid_argument.
+    UInt componentOf(Vertex v)
+    {
+        refresh();
+        return _dsf.find(_g.getVertexId(v));
+    }
+
+    /// Returns the number of vertices in the component of the vertex \a v.
+    size_t getComponentSize(Vertex v)
+    {
+        return _sizes[componentOf(v)];
+    }
+
+    /// Returns sizes of all components keyed by their representatives (see
+    /// componentOf()).
+    std::map<UInt, size_t> componentSizes()
+    {
+        refresh();
+        std::map<UInt, size_t> res;
+        for (UInt v = 0; v < _dsf.getSize(); ++v)
+            if (_dsf.isRepresentative(v) && !_g.isTombstone(v))
+                res.emplace_hint(res.end(), v, _sizes[v]);
+
+        return res;
+    }
+
+    /// Returns the number of components.
+    size_t getComponentsNum()
+    {
+        refresh();
+        return _compsNum - _g.getTombstonesNum();
+    }
+
+    /// Returns true if the index is to be rebuilt by the next query.
+    bool isStale() const { return _stale; }
+
+public:
+    // UGraphListener callbacks
+
+    void onVertexAdded(UInt id) override
+    {
+        if (_stale)
+            return;
+
+        _dsf.reserve(id + 1);
+        _sizes.resize(id + 1, 1);
+        ++_compsNum;
+    }
+
+    void onEdgeAdded(UInt si, UInt di) override
+    {
+        if (!_stale && unite(si, di))
+            --_compsNum;
+    }
+
+    void onEdgeRemoved(UInt, UInt) override { _stale = true; }
+
+    void onVertexRemoved(UInt, UInt) override { _stale = true; }
+
+    void onCompacted(const std::vector<UInt>&) override { _stale = true; }
+
+protected:
+    /// Builds the index from scratch.
+    void build()
+    {
+        const UInt vertsNum = UInt(_g.getVerticesNum());
+        std::vector<UInt> comps = connectedComponentsSV(_g, _threadsNum);
+
+        // every vertex is merged with the first vertex of its component
+        std::vector<UInt> firsts;
+        _dsf = FlatDisjointSetForest();
+        _dsf.reserve(vertsNum);
+        _sizes.assign(vertsNum, 1);
+        for (UInt v = 0; v < vertsNum; ++v)
+        {
+            if (comps[v] == firsts.size())
+                firsts.push_back(v);
+            else
+                unite(firsts[comps[v]], v);
+        }
+        _compsNum = firsts.size();
+        _stale = false;
+    }
+
+    /// Rebuilds the index if it is stale.
+    void refresh()
+    {
+        if (_stale)
+            build();
+    }
+
+    /// Merges components of the vertices with IDs \a a and \a b. Returns
+    /// false if they are the same component.
+    bool unite(UInt a, UInt b)
+    {
+        UInt ra = _dsf.find(a);
+        UInt rb = _dsf.find(b);
+        if (ra == rb)
+            return false;
+
+        UInt r = _dsf.merge(ra, rb);
+        _sizes[r] = _sizes[ra] + _sizes[rb];
+        return true;
+    }
+
+protected:
+    Graph& _g;                          ///< Indexed graph.
+    unsigned int _threadsNum;           ///< Threads for rebuilds.
+    FlatDisjointSetForest _dsf;         ///< Components by vertex IDs.
+    std::vector<size_t> _sizes;         ///< Sizes at representatives.
+    size_t _compsNum = 0;               ///< Components with tombstones.
+    bool _stale = false;                ///< Removals since the last build.
+}; // class ConnectivityIndex
+
+
+#endif // CONN_INDEX_HPP
@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains a binary file format for CSR graphs: a writer and a
+///             zero-copy memory-mapping reader.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+/// A file consists of a header (CsrFileHeader) followed by sections, each
+/// aligned to CSR_FILE_ALIGN bytes: vertices, offsets, neighbours and, for
+/// labeled graphs, labels and label flags. Sections are stored exactly as
+/// CsrUGraph keeps them in memory, in the native byte order, so a reader maps
+/// the file and makes the graph refer to the sections without copying. The
+/// magic number written in the native byte order also detects files made on
+/// machines with the other one.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CSR_FILE_HPP
+#define CSR_FILE_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+
+#include "csr_ugraph.hpp"
+#include "mapped_file.hpp"
+
+
+/// Magic number of CSR files ("UGCSR" and the format version).
+const std::uint64_t CSR_FILE_MAGIC = 0x0000315253434755ULL;
+
+/// Version of the format.
+const std::uint32_t CSR_FILE_VERSION = 1;
+
+/// Alignment of sections.
+const std::uint64_t CSR_FILE_ALIGN = 64;
+
+
+/// Header of a CSR file. Offsets of sections are given from the file start;
+/// a zero offset means no section.
+struct CsrFileHeader {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t vertexSize;       ///< sizeof(Vertex).
+    std::uint32_t labelSize;        ///< sizeof(EdgeLbl), 0 if no labels.
+    std::uint32_t indexSize;        ///< sizeof(UInt) of offsets and neighbours.
+    std::uint64_t verticesNum;
+    std::uint64_t adjNum;           ///< Number of half-edges.
+    std::uint64_t edgesNum;
+    std::uint64_t verticesOff;
+    std::uint64_t offsetsOff;
+    std::uint64_t adjOff;
+    std::uint64_t labelsOff;
+    std::uint64_t labeledOff;
+};
+
+
+/// Writes sections of a CSR file.
+class CsrFileWriter {
+public:
+    /// Opens the file \a fn. Throws std::invalid_argument if it fails.
+    explicit CsrFileWriter(const std::string& fn)
+        : _file(fn.c_str(), std::ios::binary | std::ios::trunc)
+    {
+        if (!_file.is_open())
+            throw std::invalid_argument("Can't open graph file for writing");
+    }
+
+    /// Returns the offset where a section of \a bytes bytes will be placed,
+    /// given that \a pos bytes go before it; advances \a pos.
+    static std::uint64_t placeSection(std::uint64_t& pos, std::uint64_t bytes)
+    {
+        std::uint64_t off = (pos + CSR_FILE_ALIGN - 1) / CSR_FILE_ALIGN * CSR_FILE_ALIGN;
+        pos = off + bytes;
+        return off;
+    }
+
+    /// Writes \a bytes bytes of \a data at the offset \a off, padding the gap
+    /// with zeros.
+    void write(std::uint64_t off, const void* data, std::uint64_t bytes)
+    {
+        static const char ZEROS[CSR_FILE_ALIGN] = {};
+        while (_pos < off)
+        {
+            std::uint64_t n = std::min<std::uint64_t>(off - _pos, CSR_FILE_ALIGN);
+            _file.write(ZEROS, std::streamsize(n));
+            _pos += n;
+        }
+
+        _file.write(static_cast<const char*>(data), std::streamsize(bytes));
+        _pos += bytes;
+    }
+
+    /// Flushes the file. Throws std::invalid_argument if writing has failed.
+    void close()
+    {
+        _file.close();
+        if (_file.fail())
+            throw std::invalid_argument("Can't write graph file");
+    }
+
+protected:
+    std::ofstream _file;
+    std::uint64_t _pos = 0;
+}; // class CsrFileWriter
+
+
+/// Fills the common part of a header for the graph \a g and places its
+/// sections starting from \a pos.
+template <typename Vertex>
+CsrFileHeader makeCsrFileHeader(const CsrUGraph<Vertex>& g, std::uint64_t& pos)
+{
+    static_assert(std::is_trivially_copyable<Vertex>::value,
+                  "Vertex must be trivially copyable to be stored in a file");
+    typedef typename CsrUGraph<Vertex>::UInt UInt;
+
+    CsrFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    h.magic = CSR_FILE_MAGIC;
+    h.version = CSR_FILE_VERSION;
+    h.vertexSize = sizeof(Vertex);
+    h.indexSize = sizeof(UInt);
+    h.verticesNum = g.getVerticesNum();
+    h.adjNum = g.getAdj().size();
+    h.edgesNum = g.getEdgesNum();
+
+    pos = sizeof(CsrFileHeader);
+    h.verticesOff = CsrFileWriter::placeSection(pos, h.verticesNum * sizeof(Vertex));
+    h.offsetsOff = CsrFileWriter::placeSection(pos, (h.verticesNum + 1) * sizeof(UInt));
+    h.adjOff = CsrFileWriter::placeSection(pos, h.adjNum * sizeof(UInt));
+
+    return h;
+}
+
+
+/// Writes the graph \a g to the file \a fn.
+/// Throws std::invalid_argument if the file can't be written.
+template <typename Vertex>
+void writeCsrFile(const std::string& fn, const CsrUGraph<Vertex>& g)
+{
+    std::uint64_t pos;
+    CsrFileHeader h = makeCsrFileHeader(g, pos);
+
+    CsrFileWriter w(fn);
+    w.write(0, &h, sizeof(h));
+    w.write(h.verticesOff, g.getVerticesArray().data(), h.verticesNum * sizeof(Vertex));
+    w.write(h.offsetsOff, g.getOffsets().data(), (h.verticesNum + 1) * h.indexSize);
+    w.write(h.adjOff, g.getAdj().data(), h.adjNum * h.indexSize);
+    w.close();
+}
+
+
+/// Writes the labeled graph \a g to the file \a fn.
+/// Throws std::invalid_argument if the file can't be written.
+template <typename Vertex, typename EdgeLbl>
+void writeCsrFile(const std::string& fn, const CsrEdgeLblUGraph<Vertex, EdgeLbl>& g)
+{
+    static_assert(std::is_trivially_copyable<EdgeLbl>::value,
+                  "EdgeLbl must be trivially copyable to be stored in a file");
+
+    std::uint64_t pos;
+    CsrFileHeader h = makeCsrFileHeader(g, pos);
+    h.labelSize = sizeof(EdgeLbl);
+    h.labelsOff = CsrFileWriter::placeSection(pos, h.adjNum * sizeof(EdgeLbl));
+    h.labeledOff = CsrFileWriter::placeSection(pos, h.adjNum);
+
+    CsrFileWriter w(fn);
+    w.write(0, &h, sizeof(h));
+    w.write(h.verticesOff, g.getVerticesArray().data(), h.verticesNum * sizeof(Vertex));
+    w.write(h.offsetsOff, g.getOffsets().data(), (h.verticesNum + 1) * h.indexSize);
+    w.write(h.adjOff, g.getAdj().data(), h.adjNum * h.indexSize);
+    w.write(h.labelsOff, g.getLabels().data(), h.adjNum * sizeof(EdgeLbl));
+    w.write(h.labeledOff, g.getLabeledFlags().data(), h.adjNum);
+    w.close();
+}
+
+
+/// Checks the header of the mapped file \a mf for the vertex type of size
+/// \a vertexSize and returns it. Throws std::invalid_argument if the file is
+/// not a valid CSR file.
+inline const CsrFileHeader& checkCsrFileHeader(const MappedFile& mf,
+                                               size_t vertexSize,
+                                               size_t indexSize)
+{
+    if (mf.getSize() < sizeof(CsrFileHeader))
+        throw std::invalid_argument("Graph file is too short");
+
+    const CsrFileHeader& h = *reinterpret_cast<const CsrFileHeader*>(mf.getData());
+    if (h.magic != CSR_FILE_MAGIC)
+        throw std::invalid_argument("Not a graph file or wrong byte order");
+    if (h.version != CSR_FILE_VERSION)
+        throw std::invalid_argument("Unsupported graph file version");
+    if (h.vertexSize != vertexSize || h.indexSize != indexSize)
+        throw std::invalid_argument("Graph file has other vertex type");
+
+    // sections of \a count elements must lie within the file; counts are
+    // compared before multiplying, so huge ones cannot wrap to small sizes
+    auto checkSection = [&mf](std::uint64_t off, std::uint64_t count,
+                              std::uint64_t elemSize)
+    {
+        if (off % CSR_FILE_ALIGN != 0 || off > mf.getSize()
+            || count > (mf.getSize() - off) / elemSize)
+            throw std::invalid_argument("Graph file is corrupted");
+    };
+    checkSection(h.verticesOff, h.verticesNum, vertexSize);
+    if (h.verticesNum == std::uint64_t(-1))
+        throw std::invalid_argument("Graph file is corrupted");
+    checkSection(h.offsetsOff, h.verticesNum + 1, indexSize);
+    checkSection(h.adjOff, h.adjNum, indexSize);
+    if (h.labelSize != 0)
+    {
+        checkSection(h.labelsOff, h.adjNum, h.labelSize);
+        checkSection(h.labeledOff, h.adjNum, 1);
+    }
+
+    return h;
+}
+
+
+/// Maps the file \a fn written by writeCsrFile() and makes a read-only graph
+/// referring to it without copying. Labels, if any, are ignored. The file
+/// stays mapped while the graph or any of its copies exist.
+///
+/// Only the header and the bounds of offsets are checked, neighbours are
+/// trusted, so the load time does not depend on the graph size.
+/// Throws std::invalid_argument if the file is not a valid CSR file.
+template <typename Vertex>
+CsrUGraph<Vertex> mapCsrFile(const std::string& fn)
+{
+    static_assert(std::is_trivially_copyable<Vertex>::value,
+                  "Vertex must be trivially copyable to be stored in a file");
+    typedef typename CsrUGraph<Vertex>::UInt UInt;
+
+    std::shared_ptr<MappedFile> mf = std::make_shared<MappedFile>(fn);
+    const CsrFileHeader& h = checkCsrFileHeader(*mf, sizeof(Vertex), sizeof(UInt));
+    const char* base = mf->getData();
+
+    const UInt* offsets = reinterpret_cast<const UInt*>(base + h.offsetsOff);
+    if (offsets[0] != 0 || offsets[h.verticesNum] != h.adjNum)
+        throw std::invalid_argument("Graph file is corrupted");
+
+    CsrUGraph<Vertex> g;
+    g.attachArrays(mf, reinterpret_cast<const Vertex*>(base + h.verticesOff),
+                   size_t(h.verticesNum), offsets,
+                   reinterpret_cast<const UInt*>(base + h.adjOff),
+                   size_t(h.adjNum), size_t(h.edgesNum));
+
+    return g;
+}
+
+
+/// The same as mapCsrFile() for a labeled graph. The file must have labels of
+/// the type EdgeLbl.
+template <typename Vertex, typename EdgeLbl>
+CsrEdgeLblUGraph<Vertex, EdgeLbl> mapCsrLblFile(const std::string& fn)
+{
+    static_assert(std::is_trivially_copyable<Vertex>::value,
+                  "Vertex must be trivially copyable to be stored in a file");
+    static_assert(std::is_trivially_copyable<EdgeLbl>::value,
+                  "EdgeLbl must be trivially copyable to be stored in a file");
+    typedef typename CsrUGraph<Vertex>::UInt UInt;
+
+    std::shared_ptr<MappedFile> mf = std::make_shared<MappedFile>(fn);
+    const CsrFileHeader& h = checkCsrFileHeader(*mf, sizeof(Vertex), sizeof(UInt));
+    if (h.labelSize != sizeof(EdgeLbl))
+        throw std::invalid_argument("Graph file has no labels of this type");
+    const char* base = mf->getData();
+
+    const UInt* offsets = reinterpret_cast<const UInt*>(base + h.offsetsOff);
+    if (offsets[0] != 0 || offsets[h.verticesNum] != h.adjNum)
+        throw std::invalid_argument("Graph file is corrupted");
+
+    CsrEdgeLblUGraph<Vertex, EdgeLbl> g;
+    g.attachArrays(mf, reinterpret_cast<const Vertex*>(base + h.verticesOff),
+                   size_t(h.verticesNum), offsets,
+                   reinterpret_cast<const UInt*>(base + h.adjOff),
+                   size_t(h.adjNum), size_t(h.edgesNum),
+                   reinterpret_cast<const EdgeLbl*>(base + h.labelsOff),
+                   reinterpret_cast<const unsigned char*>(base + h.labeledOff));
+
+    return g;
+}
+
+
+#endif // CSR_FILE_HPP
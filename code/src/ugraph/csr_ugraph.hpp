@@ -0,0 +1,610 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of the compressed sparse row (CSR) types
+///             for frozen undirected graphs.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef CSR_UGRAPH_HPP
+#define CSR_UGRAPH_HPP
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "ugraph.hpp"
+#include "lbl_ugraph.hpp"
+
+
+/*! ****************************************************************************
+ *  \brief Read-only array that either owns its elements in a vector or refers
+ *  to external memory (e.g. a memory-mapped file) kept alive by a holder.
+ *
+ *  \tparam T represents a type of elements.
+ *
+ *  Copies of an owning array own copies of the elements, copies of a
+ *  referring array refer to the same memory.
+ ******************************************************************************/
+template <typename T>
+class ConstArray {
+public:
+    typedef const T* const_iterator;
+
+public:
+    ConstArray() {}
+
+    ConstArray(const ConstArray& other)
+        : _own(other._own)
+        , _holder(other._holder)
+        , _data(other._holder ? other._data : _own.data())
+        , _size(other._size)
+    {
+    }
+
+    ConstArray(ConstArray&& other) = default;
+
+    ConstArray& operator=(ConstArray other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(ConstArray& other)
+    {
+        _own.swap(other._own);
+        _holder.swap(other._holder);
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+
+    /// Takes the elements of the vector \a v.
+    void assign(std::vector<T>&& v)
+    {
+        _own = std::move(v);
+        _holder.reset();
+        _data = _own.data();
+        _size = _own.size();
+    }
+
+    /// Refers to \a size elements at \a data, which stay valid while
+    /// \a holder is alive.
+    void attach(std::shared_ptr<const void> holder, const T* data, size_t size)
+    {
+        _own.clear();
+        _own.shrink_to_fit();
+        _holder = std::move(holder);
+        _data = data;
+        _size = size;
+    }
+
+    const T* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    const T& operator[](size_t i) const { return _data[i]; }
+
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+
+protected:
+    std::vector<T> _own;                    ///< Owned elements, if any.
+    std::shared_ptr<const void> _holder;    ///< Keeps external memory alive.
+    const T* _data = nullptr;               ///< Elements.
+    size_t _size = 0;                       ///< Number of elements.
+}; // class ConstArray
+
+
+
+/*! ****************************************************************************
+ *  \brief The CsrUGraph class represents a frozen (read-only) undirected graph
+ *  stored in the compressed sparse row format.
+ *
+ *  \tparam Vertex represents a type for vertices. See requirements for UGraph.
+ *
+ *  Vertices are kept in a sorted vector and are addressed by their index in
+ *  it. For the vertex with index i its neighbours occupy the semirange
+ *  [_offsets[i], _offsets[i + 1]) of the _adj array, which stores neighbours'
+ *  indices. Thus, a graph takes (V + 1) + 2E integers plus V vertices instead
+ *  of 2E tree nodes of a multimap.
+ *
+ *  The class provides the same iteration interface as UGraph does, so it can
+ *  be used by graph algorithms and DOT-writers directly.
+ *
+ *  The arrays may either be owned by the graph or refer to external memory,
+ *  e.g. a memory-mapped file (see csr_file.hpp), so Vertex must be trivially
+ *  copyable for the latter.
+ ******************************************************************************/
+template <typename Vertex>
+class CsrUGraph {
+public:
+    // type definitions
+
+    typedef unsigned int UInt;
+
+    typedef std::pair<Vertex, Vertex> Edge;
+
+    /// Sorted array of vertices.
+    typedef ConstArray<Vertex> VerticesArray;
+
+    /// Iterator type for vertices.
+    typedef typename VerticesArray::const_iterator VertexIter;
+
+    /// Pair of vertex iterators.
+    typedef std::pair<VertexIter, VertexIter> VertexIterPair;
+
+    /// Array of indices (offsets or neighbours).
+    typedef ConstArray<UInt> IndexArray;
+
+
+    /// \brief Iterator over neighbours of a single vertex.
+    ///
+    /// Dereferencing yields a pair (vertex, neighbour), as a multimap iterator
+    /// of UGraph does.
+    class AdjIter {
+    public:
+        typedef Edge                        value_type;
+        typedef const Edge&                 reference;
+        typedef const Edge*                 pointer;
+
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef long                        difference_type;
+
+        typedef AdjIter Self;               ///< For convenience.
+    public:
+        AdjIter(const CsrUGraph* g, UInt src, const UInt* cur)
+            : _g(g), _src(src), _cur(cur)
+        {
+        }
+
+        Self& operator++()
+        {
+            ++_cur;
+            return *this;
+        }
+
+        Self operator++(int)
+        {
+            Self curCopy = *this;
+            ++_cur;
+            return curCopy;
+        }
+
+        reference operator*() const
+        {
+            _val = Edge(_g->_vertices[_src], _g->_vertices[*_cur]);
+            return _val;
+        }
+
+        pointer operator->() const { return &(operator*()); }
+
+        /// Returns the index of the current neighbour.
+        UInt getNeighbourId() const { return *_cur; }
+
+        /// Returns the position of the current neighbour in the adjacency
+        /// array (useful for accessing data aligned with it).
+        UInt getPos() const { return UInt(_cur - _g->_adj.data()); }
+
+        bool operator==(const Self& rhv) const { return _cur == rhv._cur; }
+        bool operator!=(const Self& rhv) const { return !(*this == rhv); }
+
+    protected:
+        const CsrUGraph* _g;                ///< Owning graph.
+        UInt _src;                          ///< Index of the source vertex.
+        const UInt* _cur;                   ///< Current neighbour.
+        mutable Edge _val;                  ///< Materialized current edge.
+    }; // class AdjIter
+
+
+    /// \brief Iterator over all (non-repeating) edges of the graph.
+    ///
+    /// Follows the same rules as UGraph::EdgeIter: an edge {a, b} is reported
+    /// once as the pair with a < b; a self-loop is reported once as well.
+    class EdgeIter {
+    public:
+        typedef Edge                        value_type;
+        typedef const Edge&                 reference;
+        typedef const Edge*                 pointer;
+
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef long                        difference_type;
+
+        typedef EdgeIter Self;              ///< For convenience.
+    public:
+        EdgeIter(const CsrUGraph* g, UInt pos)
+            : _g(g), _src(0), _pos(pos)
+        {
+            goUntilNextValid();
+        }
+
+        Self& operator++()
+        {
+            ++_pos;
+            goUntilNextValid();
+            return *this;
+        }
+
+        Self operator++(int)
+        {
+            Self curCopy = *this;
+            ++(*this);
+            return curCopy;
+        }
+
+        reference operator*() const
+        {
+            _val = Edge(_g->_vertices[_src], _g->_vertices[_g->_adj[_pos]]);
+            return _val;
+        }
+
+        pointer operator->() const { return &(operator*()); }
+
+        /// Returns the position of the current half-edge in the adjacency
+        /// array.
+        UInt getPos() const { return _pos; }
+
+        bool operator==(const Self& rhv) const { return _pos == rhv._pos; }
+        bool operator!=(const Self& rhv) const { return !(*this == rhv); }
+
+    protected:
+        /// Iterates the adjacency array until finds a valid half-edge or
+        /// reaches the end.
+        void goUntilNextValid()
+        {
+            const UInt end = UInt(_g->_adj.size());
+            while (_pos < end)
+            {
+                // moves the source forward to the vertex owning _pos
+                while (_g->_offsets[_src + 1] <= _pos)
+                    ++_src;
+
+                UInt d = _g->_adj[_pos];
+                if (_src < d)
+                    return;                     // valid first part of edge
+
+                // a self-loop is stored twice in a row, take the first copy
+                if (_src == d && (_pos == _g->_offsets[_src]
+                                  || _g->_adj[_pos - 1] != d))
+                    return;
+
+                ++_pos;
+            }
+        }
+
+    protected:
+        const CsrUGraph* _g;                ///< Owning graph.
+        UInt _src;                          ///< Index of the current source.
+        UInt _pos;                          ///< Current half-edge position.
+        mutable Edge _val;                  ///< Materialized current edge.
+    }; // class EdgeIter
+
+
+    /// Pair of edge iterators.
+    typedef std::pair<EdgeIter, EdgeIter> EdgeIterPair;
+
+    // aliases matching UGraph names, so generic algorithms are agnostic
+    typedef AdjIter AdjListCIter;
+    typedef std::pair<AdjListCIter, AdjListCIter> AdjListCIterPair;
+
+public:
+    // Constructors
+
+    /// Creates an empty graph.
+    CsrUGraph()
+    {
+        _offsets.assign(IndexVector(1, 0));
+    }
+
+    /// Freezes the given graph \a g.
+    template <typename Alloc>
+    explicit CsrUGraph(const UGraph<Vertex, Alloc>& g)
+    {
+        build(g);
+    }
+
+public:
+    // Helpers
+
+    /// Creates an edge as a pair of provided vertices s.t. the “smaller” node
+    /// goes first and the “greater” node goes second.
+    static Edge makeNormalizedEdge(Vertex s, Vertex d)
+    {
+        return UGraph<Vertex>::makeNormalizedEdge(s, d);
+    }
+
+    /// Method determines whether an edge {s, d} exists in this graph.
+    bool isEdgeExists(Vertex s, Vertex d) const
+    {
+        UInt si, di;
+        if (!findVertexId(s, si) || !findVertexId(d, di))
+            return false;
+
+        return findHalfEdge(si, di) != NO_POS;
+    }
+
+    bool isVertexExists(Vertex v) const
+    {
+        UInt vi;
+        return findVertexId(v, vi);
+    }
+
+    /// Looks for the index of the vertex \a v. Returns true and sets \a id if
+    /// the vertex exists, false otherwise.
+    bool findVertexId(Vertex v, UInt& id) const
+    {
+        VertexIter it = std::lower_bound(_vertices.begin(), _vertices.end(), v);
+        if (it == _vertices.end() || v < *it)
+            return false;
+
+        id = UInt(it - _vertices.begin());
+        return true;
+    }
+
+    /// Returns the index of the vertex \a v.
+    /// If no such a vertex, throws an exception.
+    UInt getVertexId(Vertex v) const
+    {
+        UInt id;
+        if (!findVertexId(v, id))
+            throw std::invalid_argument("No such vertex");
+
+        return id;
+    }
+
+public:
+    // setters/getters
+    size_t getVerticesNum() const { return _vertices.size(); }
+    size_t getEdgesNum() const { return _edgesNum; }
+
+    /// Provides a collection of vertices as a semirange (pair of iterators).
+    VertexIterPair getVertices() const
+    {
+        return {_vertices.begin(), _vertices.end()};
+    }
+
+    EdgeIterPair getEdges() const
+    {
+        return {EdgeIter(this, 0), EdgeIter(this, UInt(_adj.size()))};
+    }
+
+    /// Return a range of edges that are direct neighbours of the given
+    /// vertex \a v.
+    AdjListCIterPair getAdjEdges(Vertex v) const
+    {
+        UInt vi;
+        if (!findVertexId(v, vi))
+            return {AdjIter(this, 0, _adj.data()), AdjIter(this, 0, _adj.data())};
+
+        return getAdjEdgesById(vi);
+    }
+
+    /// Return a range of neighbours of the vertex with index \a vi.
+    AdjListCIterPair getAdjEdgesById(UInt vi) const
+    {
+        return {AdjIter(this, vi, _adj.data() + _offsets[vi]),
+                AdjIter(this, vi, _adj.data() + _offsets[vi + 1])};
+    }
+
+    /// Returns the vertex having index \a vi.
+    Vertex getVertexById(UInt vi) const { return _vertices[vi]; }
+
+    /// Returns the index of the neighbour an adjacency iterator \a it points
+    /// to. Takes O(1), as neighbours are stored by their indices.
+    UInt getAdjVertexId(const AdjIter& it) const { return it.getNeighbourId(); }
+
+    /// Returns the vertices array (V elements).
+    const VerticesArray& getVerticesArray() const { return _vertices; }
+
+    /// Returns the offsets array (V + 1 elements).
+    const IndexArray& getOffsets() const { return _offsets; }
+
+    /// Returns the adjacency array (2E elements, self-loops are doubled).
+    const IndexArray& getAdj() const { return _adj; }
+
+    /// \brief Makes the graph refer to external arrays instead of its own
+    /// ones, e.g. to sections of a memory-mapped file.
+    ///
+    /// \param holder keeps the memory alive while the graph (or its copies)
+    /// uses it.
+    /// Arrays must follow the layout described for the class: \a vertsNum
+    /// sorted vertices, vertsNum + 1 offsets and \a adjNum neighbours' indices.
+    void attachArrays(std::shared_ptr<const void> holder,
+                      const Vertex* verts, size_t vertsNum,
+                      const UInt* offsets, const UInt* adj, size_t adjNum,
+                      size_t edgesNum)
+    {
+        _vertices.attach(holder, verts, vertsNum);
+        _offsets.attach(holder, offsets, vertsNum + 1);
+        _adj.attach(holder, adj, adjNum);
+        _edgesNum = edgesNum;
+    }
+
+protected:
+    /// Vector of indices used while building.
+    typedef std::vector<UInt> IndexVector;
+
+    /// Position of a missing half-edge.
+    static const UInt NO_POS = UInt(-1);
+
+    /// Returns the position of the half-edge (si, di) in the adjacency array
+    /// or NO_POS. Neighbours of a vertex are sorted, so binary search is used.
+    UInt findHalfEdge(UInt si, UInt di) const
+    {
+        const UInt* beg = _adj.data() + _offsets[si];
+        const UInt* end = _adj.data() + _offsets[si + 1];
+        const UInt* it = std::lower_bound(beg, end, di);
+        if (it == end || *it != di)
+            return NO_POS;
+
+        return UInt(it - _adj.data());
+    }
+
+    /// Fills the arrays with the content of \a g.
+    template <typename Alloc>
+    void build(const UGraph<Vertex, Alloc>& g)
+    {
+        // vertices are already sorted in the set
+        typename UGraph<Vertex, Alloc>::VertexIterPair vs = g.getVertices();
+        _vertices.assign(std::vector<Vertex>(vs.first, vs.second));
+
+        IndexVector offsets(_vertices.size() + 1, 0);
+        IndexVector adj;
+        adj.reserve(g.getEdgesNum() * 2);
+        _edgesNum = g.getEdgesNum();
+
+        for (UInt vi = 0; vi < _vertices.size(); ++vi)
+        {
+            typename UGraph<Vertex, Alloc>::AdjListCIterPair ns = g.getAdjEdges(_vertices[vi]);
+            for (auto it = ns.first; it != ns.second; ++it)
+            {
+                UInt di = 0;
+                findVertexId(it->second, di);
+                adj.push_back(di);
+            }
+
+            std::sort(adj.begin() + offsets[vi], adj.end());
+            offsets[vi + 1] = UInt(adj.size());
+        }
+
+        _offsets.assign(std::move(offsets));
+        _adj.assign(std::move(adj));
+    }
+
+protected:
+    VerticesArray _vertices;    ///< Sorted vertices.
+    IndexArray _offsets;        ///< Offsets of adjacency ranges, V + 1 items.
+    IndexArray _adj;            ///< Indices of neighbours, 2E items.
+    size_t _edgesNum = 0;       ///< Number of edges.
+}; // class CsrUGraph
+
+
+
+/*! ****************************************************************************
+ *  \brief The CsrEdgeLblUGraph class represents a frozen undirected graph with
+ *  labels on edges in the CSR format.
+ *
+ *  \tparam Vertex represents a type for vertices. See requirements for UGraph.
+ *  \tparam EdgeLbl represents a type for edge labeling.
+ *
+ *  Labels are stored in an array aligned with the adjacency array, so each
+ *  label is kept next to its half-edge and no tree lookup is needed.
+ ******************************************************************************/
+template <typename Vertex, typename EdgeLbl>
+class CsrEdgeLblUGraph
+        : public CsrUGraph<Vertex>
+{
+public:
+    // Aliases
+    typedef CsrUGraph<Vertex> Base;
+    typedef typename Base::Edge Edge;
+    typedef typename Base::UInt UInt;
+
+    /// Type of edge labels.
+    typedef EdgeLbl Label;
+
+public:
+    // Constructors
+
+    /// Creates an empty graph.
+    CsrEdgeLblUGraph()
+    {
+    }
+
+    /// Freezes the given labeled graph \a g.
+    template <typename Alloc>
+    explicit CsrEdgeLblUGraph(const EdgeLblUGraph<Vertex, EdgeLbl, Alloc>& g)
+        : Base(g)
+    {
+        std::vector<EdgeLbl> labels(Base::_adj.size());
+        std::vector<unsigned char> labeled(Base::_adj.size(), 0);
+
+        for (UInt vi = 0; vi < Base::_vertices.size(); ++vi)
+        {
+            for (UInt p = Base::_offsets[vi]; p < Base::_offsets[vi + 1]; ++p)
+            {
+                Vertex d = Base::_vertices[Base::_adj[p]];
+                if (g.getLabel(Base::_vertices[vi], d, labels[p]))
+                    labeled[p] = 1;
+            }
+        }
+
+        _labels.assign(std::move(labels));
+        _labeled.assign(std::move(labeled));
+    }
+
+public:
+    /// For a given edge {s, d} tries to find an associated label and returns it
+    /// if so.
+    ///
+    /// \return true if a label for the given edge is associated and \a lbl is
+    /// assigned to its value; false otherwise.
+    bool getLabel(Vertex s, Vertex d, EdgeLbl& lbl) const
+    {
+        UInt si, di;
+        if (!Base::findVertexId(s, si) || !Base::findVertexId(d, di))
+            return false;
+
+        UInt pos = Base::findHalfEdge(si, di);
+        if (pos == Base::NO_POS)
+            return false;
+
+        return getLabelAt(pos, lbl);
+    }
+
+    /// Returns the label of the edge an adjacency iterator \a it points to,
+    /// if any. Takes O(1), as labels are stored next to half-edges.
+    bool getAdjLabel(const typename Base::AdjIter& it, EdgeLbl& lbl) const
+    {
+        return getLabelAt(it.getPos(), lbl);
+    }
+
+    /// Returns the label of the half-edge at the position \a pos of the
+    /// adjacency array, if any.
+    bool getLabelAt(UInt pos, EdgeLbl& lbl) const
+    {
+        if (!_labeled[pos])
+            return false;
+
+        lbl = _labels[pos];
+        return true;
+    }
+
+    /// Returns the labels array aligned with the adjacency array.
+    const ConstArray<EdgeLbl>& getLabels() const { return _labels; }
+
+    /// Returns the array of flags telling which half-edges have labels.
+    const ConstArray<unsigned char>& getLabeledFlags() const { return _labeled; }
+
+    /// The same as CsrUGraph::attachArrays(), plus \a labels and \a labeled
+    /// flags aligned with the adjacency array.
+    void attachArrays(std::shared_ptr<const void> holder,
+                      const Vertex* verts, size_t vertsNum,
+                      const UInt* offsets, const UInt* adj, size_t adjNum,
+                      size_t edgesNum,
+                      const EdgeLbl* labels, const unsigned char* labeled)
+    {
+        Base::attachArrays(holder, verts, vertsNum, offsets, adj, adjNum,
+                           edgesNum);
+        _labels.attach(holder, labels, adjNum);
+        _labeled.attach(holder, labeled, adjNum);
+    }
+
+protected:
+    ConstArray<EdgeLbl> _labels;            ///< Labels aligned with _adj.
+    ConstArray<unsigned char> _labeled;     ///< 1 if a half-edge has a label.
+}; // class CsrEdgeLblUGraph
+
+
+#endif // CSR_UGRAPH_HPP
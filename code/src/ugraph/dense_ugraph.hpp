@@ -0,0 +1,425 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of the bit adjacency matrix type for
+///             frozen dense undirected graphs.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DENSE_UGRAPH_HPP
+#define DENSE_UGRAPH_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <cstdint>
+
+#include "ugraph.hpp"
+#include "vertex_bitset.hpp"
+
+
+/*! ****************************************************************************
+ *  \brief The DenseUGraph class represents a frozen (read-only) undirected
+ *  graph stored as a bit adjacency matrix.
+ *
+ *  \tparam Vertex represents a type for vertices. See requirements for UGraph.
+ *
+ *  Vertices are kept in a sorted vector and are addressed by their index in
+ *  it. The vertex with index i has a row of getWordsPerRow() words, where the
+ *  bit j is set iff {i, j} is an edge. Thus, isEdgeExistsById() takes O(1)
+ *  and common neighbours of two vertices are counted by ANDing their rows
+ *  64 vertices at a time.
+ *
+ *  A graph takes V^2 / 8 bytes regardless of the number of edges, so the
+ *  representation pays off for dense graphs only; see isDenseEnough().
+ *
+ *  The class provides the same iteration interface as UGraph does, so it can
+ *  be used by generic graph algorithms and DOT-writers directly. A self-loop
+ *  is a single bit on the diagonal and is reported once by adjacency
+ *  iterators.
+ ******************************************************************************/
+template <typename Vertex>
+class DenseUGraph {
+public:
+    // type definitions
+
+    typedef unsigned int UInt;
+
+    typedef std::pair<Vertex, Vertex> Edge;
+
+    /// Sorted vector of vertices.
+    typedef std::vector<Vertex> VerticesVector;
+
+    /// Iterator type for vertices.
+    typedef typename VerticesVector::const_iterator VertexIter;
+
+    /// Pair of vertex iterators.
+    typedef std::pair<VertexIter, VertexIter> VertexIterPair;
+
+    /// Default minimal density 2E / V^2 for which isDenseEnough() holds.
+    static constexpr double DEF_DENSITY_THRESHOLD = 0.001;
+
+    /// Default maximal size of a matrix in bytes for which isDenseEnough()
+    /// holds.
+    static const size_t DEF_MAX_BYTES = size_t(1) << 30;
+
+
+    /// \brief Iterator over neighbours of a single vertex.
+    ///
+    /// Dereferencing yields a pair (vertex, neighbour), as a multimap iterator
+    /// of UGraph does.
+    class AdjIter {
+    public:
+        typedef Edge                        value_type;
+        typedef const Edge&                 reference;
+        typedef const Edge*                 pointer;
+
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef long                        difference_type;
+
+        typedef AdjIter Self;               ///< For convenience.
+    public:
+        AdjIter(const DenseUGraph* g, UInt src, size_t cur)
+            : _g(g), _src(src), _cur(cur)
+        {
+        }
+
+        Self& operator++()
+        {
+            _cur = _g->findNextNeighbour(_src, _cur + 1);
+            return *this;
+        }
+
+        Self operator++(int)
+        {
+            Self curCopy = *this;
+            ++(*this);
+            return curCopy;
+        }
+
+        reference operator*() const
+        {
+            _val = Edge(_g->_vertices[_src], _g->_vertices[_cur]);
+            return _val;
+        }
+
+        pointer operator->() const { return &(operator*()); }
+
+        /// Returns the index of the current neighbour.
+        UInt getNeighbourId() const { return UInt(_cur); }
+
+        bool operator==(const Self& rhv) const { return _cur == rhv._cur; }
+        bool operator!=(const Self& rhv) const { return !(*this == rhv); }
+
+    protected:
+        const DenseUGraph* _g;              ///< Owning graph.
+        UInt _src;                          ///< Index of the source vertex.
+        size_t _cur;                        ///< Index of the current neighbour.
+        mutable Edge _val;                  ///< Materialized current edge.
+    }; // class AdjIter
+
+
+    /// \brief Iterator over all (non-repeating) edges of the graph.
+    ///
+    /// Follows the same rules as UGraph::EdgeIter: an edge {a, b} is reported
+    /// once as the pair with a < b; a self-loop is reported once as well.
+    class EdgeIter {
+    public:
+        typedef Edge                        value_type;
+        typedef const Edge&                 reference;
+        typedef const Edge*                 pointer;
+
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef long                        difference_type;
+
+        typedef EdgeIter Self;              ///< For convenience.
+    public:
+        EdgeIter(const DenseUGraph* g, size_t src)
+            : _g(g), _src(src), _dst(src)
+        {
+            goUntilNextValid();
+        }
+
+        Self& operator++()
+        {
+            ++_dst;
+            goUntilNextValid();
+            return *this;
+        }
+
+        Self operator++(int)
+        {
+            Self curCopy = *this;
+            ++(*this);
+            return curCopy;
+        }
+
+        reference operator*() const
+        {
+            _val = Edge(_g->_vertices[_src], _g->_vertices[_dst]);
+            return _val;
+        }
+
+        pointer operator->() const { return &(operator*()); }
+
+        bool operator==(const Self& rhv) const
+        {
+            return _src == rhv._src && _dst == rhv._dst;
+        }
+
+        bool operator!=(const Self& rhv) const { return !(*this == rhv); }
+
+    protected:
+        /// Looks for the next set bit on or above the diagonal, starting from
+        /// (_src, _dst), or reaches the end (V, V).
+        void goUntilNextValid()
+        {
+            const size_t vertsNum = _g->_vertices.size();
+            while (_src < vertsNum)
+            {
+                _dst = _g->findNextNeighbour(UInt(_src), _dst);
+                if (_dst < vertsNum)
+                    return;
+
+                ++_src;
+                _dst = _src;
+            }
+
+            _dst = vertsNum;
+        }
+
+    protected:
+        const DenseUGraph* _g;              ///< Owning graph.
+        size_t _src;                        ///< Index of the current source.
+        size_t _dst;                        ///< Index of the current target.
+        mutable Edge _val;                  ///< Materialized current edge.
+    }; // class EdgeIter
+
+
+    /// Pair of edge iterators.
+    typedef std::pair<EdgeIter, EdgeIter> EdgeIterPair;
+
+    // aliases matching UGraph names, so generic algorithms are agnostic
+    typedef AdjIter AdjListCIter;
+    typedef std::pair<AdjListCIter, AdjListCIter> AdjListCIterPair;
+
+public:
+    // Constructors
+
+    /// Creates an empty graph.
+    DenseUGraph()
+    {
+    }
+
+    /// Freezes the given graph \a g.
+    template <typename Alloc>
+    explicit DenseUGraph(const UGraph<Vertex, Alloc>& g)
+    {
+        build(g);
+    }
+
+    /// Freezes the given graph \a g of any type providing the UGraph iteration
+    /// interface (e.g. CsrUGraph).
+    template <typename Graph>
+    static DenseUGraph fromGraph(const Graph& g)
+    {
+        DenseUGraph res;
+        res.build(g);
+        return res;
+    }
+
+public:
+    // Helpers
+
+    /// Creates an edge as a pair of provided vertices s.t. the “smaller” node
+    /// goes first and the “greater” node goes second.
+    static Edge makeNormalizedEdge(Vertex s, Vertex d)
+    {
+        return UGraph<Vertex>::makeNormalizedEdge(s, d);
+    }
+
+    /// Returns true if a graph with \a vertsNum vertices and \a edgesNum edges
+    /// is worth storing as a matrix: its density 2E / V^2 is at least
+    /// \a threshold and the matrix takes at most \a maxBytes.
+    static bool isDenseEnough(size_t vertsNum, size_t edgesNum,
+                              double threshold = DEF_DENSITY_THRESHOLD,
+                              size_t maxBytes = DEF_MAX_BYTES)
+    {
+        if (vertsNum == 0)
+            return false;
+
+        double v = double(vertsNum);
+        if (v * double(getBitsetWordsNum(vertsNum)) * 8 > double(maxBytes))
+            return false;
+
+        return 2.0 * double(edgesNum) >= threshold * v * v;
+    }
+
+    /// Method determines whether an edge {s, d} exists in this graph.
+    bool isEdgeExists(Vertex s, Vertex d) const
+    {
+        UInt si, di;
+        if (!findVertexId(s, si) || !findVertexId(d, di))
+            return false;
+
+        return isEdgeExistsById(si, di);
+    }
+
+    /// Method determines whether an edge between the vertices with indices
+    /// \a si and \a di exists. Takes O(1).
+    bool isEdgeExistsById(UInt si, UInt di) const
+    {
+        return (getRow(si)[di / BITSET_WORD_BITS] >> (di % BITSET_WORD_BITS)) & 1;
+    }
+
+    bool isVertexExists(Vertex v) const
+    {
+        UInt vi;
+        return findVertexId(v, vi);
+    }
+
+    /// Looks for the index of the vertex \a v. Returns true and sets \a id if
+    /// the vertex exists, false otherwise.
+    bool findVertexId(Vertex v, UInt& id) const
+    {
+        VertexIter it = std::lower_bound(_vertices.begin(), _vertices.end(), v);
+        if (it == _vertices.end() || v < *it)
+            return false;
+
+        id = UInt(it - _vertices.begin());
+        return true;
+    }
+
+    /// Returns the index of the vertex \a v.
+    /// If no such a vertex, throws an exception.
+    UInt getVertexId(Vertex v) const
+    {
+        UInt id;
+        if (!findVertexId(v, id))
+            throw std::invalid_argument("No such vertex");
+
+        return id;
+    }
+
+    /// Returns the number of neighbours of the vertex with index \a vi
+    /// (a self-loop makes the vertex its own neighbour once).
+    size_t getNeighboursNum(UInt vi) const
+    {
+        return size_t(countOnes(getRow(vi), _wordsPerRow));
+    }
+
+    /// Returns the number of common neighbours of the vertices with indices
+    /// \a ui and \a vi.
+    size_t countCommonNeighbours(UInt ui, UInt vi) const
+    {
+        return size_t(countOnesAnd(getRow(ui), getRow(vi), _wordsPerRow));
+    }
+
+public:
+    // setters/getters
+    size_t getVerticesNum() const { return _vertices.size(); }
+    size_t getEdgesNum() const { return _edgesNum; }
+
+    /// Provides a collection of vertices as a semirange (pair of iterators).
+    VertexIterPair getVertices() const
+    {
+        return {_vertices.begin(), _vertices.end()};
+    }
+
+    EdgeIterPair getEdges() const
+    {
+        return {EdgeIter(this, 0), EdgeIter(this, _vertices.size())};
+    }
+
+    /// Return a range of edges that are direct neighbours of the given
+    /// vertex \a v.
+    AdjListCIterPair getAdjEdges(Vertex v) const
+    {
+        UInt vi;
+        if (!findVertexId(v, vi))
+            return {AdjIter(this, 0, 0), AdjIter(this, 0, 0)};
+
+        return getAdjEdgesById(vi);
+    }
+
+    /// Return a range of neighbours of the vertex with index \a vi.
+    AdjListCIterPair getAdjEdgesById(UInt vi) const
+    {
+        return {AdjIter(this, vi, findNextNeighbour(vi, 0)),
+                AdjIter(this, vi, _vertices.size())};
+    }
+
+    /// Returns the vertex having index \a vi.
+    Vertex getVertexById(UInt vi) const { return _vertices[vi]; }
+
+    /// Returns the index of the neighbour an adjacency iterator \a it points
+    /// to. Takes O(1).
+    UInt getAdjVertexId(const AdjIter& it) const { return it.getNeighbourId(); }
+
+    /// Returns the row of the vertex with index \a vi.
+    const std::uint64_t* getRow(UInt vi) const
+    {
+        return _rows.data() + size_t(vi) * _wordsPerRow;
+    }
+
+    /// Returns the number of words in a row; it is a multiple of 8, unused
+    /// bits are zeros.
+    size_t getWordsPerRow() const { return _wordsPerRow; }
+
+protected:
+    /// Returns the index of the first neighbour of the vertex \a vi not less
+    /// than \a from, or V if none.
+    size_t findNextNeighbour(UInt vi, size_t from) const
+    {
+        return findNextBit(getRow(vi), _wordsPerRow, from, _vertices.size());
+    }
+
+    /// Fills the matrix with the content of \a g.
+    template <typename Graph>
+    void build(const Graph& g)
+    {
+        auto vs = g.getVertices();
+        _vertices.assign(vs.first, vs.second);
+        std::sort(_vertices.begin(), _vertices.end());
+
+        _wordsPerRow = getBitsetWordsNum(_vertices.size());
+        _rows.assign(_vertices.size() * _wordsPerRow, 0);
+        _edgesNum = g.getEdgesNum();
+
+        for (UInt vi = 0; vi < _vertices.size(); ++vi)
+        {
+            std::uint64_t* row = _rows.data() + size_t(vi) * _wordsPerRow;
+            auto ns = g.getAdjEdges(_vertices[vi]);
+            for (auto it = ns.first; it != ns.second; ++it)
+            {
+                UInt di = 0;
+                findVertexId(it->second, di);
+                row[di / BITSET_WORD_BITS] |= 1ULL << (di % BITSET_WORD_BITS);
+            }
+        }
+    }
+
+protected:
+    VerticesVector _vertices;           ///< Sorted vertices.
+    std::vector<std::uint64_t> _rows;   ///< Matrix rows, one after another.
+    size_t _wordsPerRow = 0;            ///< Number of words in a row.
+    size_t _edgesNum = 0;               ///< Number of edges.
+}; // class DenseUGraph
+
+
+template <typename Vertex>
+constexpr double DenseUGraph<Vertex>::DEF_DENSITY_THRESHOLD;
+
+
+#endif // DENSE_UGRAPH_HPP
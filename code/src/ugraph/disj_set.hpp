@@ -183,4 +183,144 @@ protected:
 }; // class DisjointSetForest
 
 
+
+/*! ****************************************************************************
+ *  \brief Implements array-backed union-find structure for representing a
+ *  forest of disjoint sets of integer handles.
+ *
+ *  Unlike DisjointSetForest, elements are not stored: each element is
+ *  represented by a handle 0, 1, 2, ... (e.g. a dense vertex ID), and parents
+ *  and ranks are kept in two contiguous arrays indexed by handles. Find is
+ *  iterative and uses path halving instead of the recursive full compression.
+ ******************************************************************************/
+class FlatDisjointSetForest {
+public:
+
+    typedef unsigned int UInt;
+
+    /// Type of element handles.
+    typedef UInt Handle;
+
+public:
+    // Constructors, destructors and all the guys.
+    FlatDisjointSetForest(bool pc = true)
+        : _doPathCompress(pc)
+    {
+    }
+
+public:
+    // ADS operations
+
+    /// Bulk initializer: makes singletons for all handles less than \a n that
+    /// have not been created yet.
+    void reserve(size_t n)
+    {
+        UInt first = UInt(_par.size());
+        if (n <= first)
+            return;
+
+        _par.resize(n);
+        _rank.resize(n, 0);
+        for (UInt h = first; h < n; ++h)
+            _par[h] = h;
+    }
+
+    /// Makes a new singleton set and returns its handle.
+    Handle makeSet()
+    {
+        Handle h = Handle(_par.size());
+        _par.push_back(h);
+        _rank.push_back(0);
+
+        return h;
+    }
+
+    /// Find the representative of the provided element.
+    Handle find(Handle x)
+    {
+        if (!_doPathCompress)
+        {
+            while (_par[x] != x)
+                x = _par[x];
+            return x;
+        }
+
+        // path halving: every node on the path is linked to its grandparent
+        while (_par[x] != x)
+        {
+            _par[x] = _par[_par[x]];
+            x = _par[x];
+        }
+
+        return x;
+    }
+
+    /// Finds the representative of the provided element without changing the
+    /// forest, so several threads may call it simultaneously as long as no one
+    /// modifies the forest.
+    Handle findConst(Handle x) const
+    {
+        while (_par[x] != x)
+            x = _par[x];
+        return x;
+    }
+
+    /// Applies Union by Rank. Returns the representative of the united set.
+    Handle merge(Handle x, Handle y)
+    {
+        Handle rx = find(x);
+        Handle ry = find(y);
+        if (rx == ry)
+            return rx;
+
+        if(_rank[rx] <= _rank[ry])
+            return mergeIntrn(rx, ry);
+        //else
+            return mergeIntrn(ry, rx);
+    }
+
+    /// Returns the parent of the element \a x.
+    Handle getPar(Handle x) const { return _par[x]; }
+
+    /// Returns the rank of the element \a x.
+    UInt getRank(Handle x) const { return _rank[x]; }
+
+    /// \returns true if the element is the representative
+    bool isRepresentative(Handle x) const { return _par[x] == x; }
+
+    /// Returns the number of elements.
+    size_t getSize() const { return _par.size(); }
+
+    /// Sets path compression flag.
+    void setPathCompression(bool pc) { _doPathCompress = pc; }
+
+    /// Returns path compression flag.
+    bool doesPathCompression() const { return _doPathCompress; }
+
+protected:
+
+    /// Performs actual union-by-rank, where \a s has smaller rank and \a l has
+    /// larger rank
+    Handle mergeIntrn(Handle s, Handle l)
+    {
+        _par[s] = l;
+
+        // if the only ranks are equal, we have to increase the largest tree rank
+        if (_rank[s] == _rank[l])
+            ++_rank[l];
+
+        return l;
+    }
+
+protected:
+
+    std::vector<UInt> _par;         ///< Parents of elements.
+    std::vector<UInt> _rank;        ///< Ranks of elements.
+
+    /// true if need do path compression.
+    bool _doPathCompress;
+
+}; // class FlatDisjointSetForest
+
+
 #endif // DISJ_SET_HPP_
@@ -0,0 +1,556 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of the minimum spanning forest kept up to
+///             date with a changing graph by link-cut trees.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef DYN_MST_HPP
+#define DYN_MST_HPP
+
+#include <set>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <tuple>
+#include <cstdint>
+
+#include "ugraph.hpp"
+#include "ugraph_algos.hpp"
+
+
+/*! ****************************************************************************
+ *  \brief Minimum spanning forest of a labeled graph, updated as edges are
+ *  added, removed or relabeled.
+ *
+ *  \tparam Graph is EdgeLblUGraph or a class derived from it; labels must be
+ *  ordered by < and summable.
+ *
+ *  The forest attaches to the graph as a listener, so the graph is changed as
+ *  usual (addLblEdge(), setLabel(), removeEdge(), removeVertex()). Edges are
+ *  ordered by labels and then by normalized edges, as in findMSTKruskal(), so
+ *  the forest is always the one Kruskal's algorithm would give. Unlabeled
+ *  edges are ignored.
+ *
+ *  The forest is kept in a link-cut tree where every tree edge is a node of
+ *  its own, so the heaviest edge on a tree path is found in amortized
+ *  O(log V):
+ *  - a new (or cheaper) edge joining two trees is linked; inside a tree it
+ *    replaces the heaviest edge of the cycle if it is lighter;
+ *  - a removed (or heavier) tree edge is cut, and the cheapest edge joining
+ *    the two parts is linked instead. It is looked for among edges of the
+ *    smaller part, which is found by searching both parts in turns.
+ *
+ *  The graph must outlive the forest.
+ ******************************************************************************/
+template <typename Graph>
+class DynamicMST : public UGraphListener {
+public:
+    typedef unsigned int UInt;
+    typedef typename Graph::Edge Edge;
+    typedef typename Edge::first_type Vertex;
+    typedef typename Graph::Label Weight;
+
+    /// Index meaning “no node”.
+    static const UInt NO_NODE = UInt(-1);
+
+public:
+    /// Builds the minimum spanning forest of the graph \a g and attaches to
+    /// the graph.
+    explicit DynamicMST(Graph& g)
+        : _g(g)
+    {
+        for (UInt v = 0; v < g.getVerticesNum(); ++v)
+            _vertNodes.push_back(makeNode());
+
+        // in Kruskal's order no edge replaces another one
+        std::vector<std::pair<Weight, Edge>> wedges;
+        typename Graph::EdgeIterPair es = g.getEdges();
+        for (; es.first != es.second; ++es.first)
+        {
+            Weight w;
+            if (g.getLabel(es.first->first, es.first->second, w))
+                wedges.push_back({w, Graph::makeNormalizedEdge(
+                                        es.first->first, es.first->second)});
+        }
+        std::sort(wedges.begin(), wedges.end());
+
+        for (const auto& we : wedges)
+            insertEdge(g.getVertexId(we.second.first),
+                       g.getVertexId(we.second.second), we.first);
+
+        _g.addListener(this);
+    }
+
+    ~DynamicMST() override
+    {
+        _g.removeListener(this);
+    }
+
+    // the forest is bound to a graph object
+    DynamicMST(const DynamicMST&) = delete;
+    DynamicMST& operator=(const DynamicMST&) = delete;
+
+public:
+    /// Returns edges of the forest, as findMSTKruskal() does.
+    std::set<Edge> getEdges() const
+    {
+        std::set<Edge> res;
+        for (const auto& te : _treeEdges)
+            res.insert(_nodes[te.second].e);
+
+        return res;
+    }
+
+    /// Returns the number of edges in the forest.
+    size_t getEdgesNum() const { return _treeEdges.size(); }
+
+    /// Returns the total weight of the forest.
+    Weight getWeight() const { return _weight; }
+
+    /// Returns true if the edge {s, d} belongs to the forest.
+    bool isTreeEdge(Vertex s, Vertex d) const
+    {
+        UInt si, di;
+        return _g.findVertexId(s, si) && _g.findVertexId(d, di)
+               && findTreeEdge(si, di) != NO_NODE;
+    }
+
+    /// Returns true if the vertices \a u and \a v are in the same tree.
+    /// If no such vertices, throws std::invalid_argument.
+    bool connected(Vertex u, Vertex v)
+    {
+        return findRoot(_vertNodes[_g.getVertexId(u)])
+               == findRoot(_vertNodes[_g.getVertexId(v)]);
+    }
+
+public:
+    // UGraphListener callbacks
+
+    void onVertexAdded(UInt /*id*/) override
+    {
+        _vertNodes.push_back(makeNode());
+    }
+
+    void onEdgeAdded(UInt si, UInt di) override
+    {
+        Weight w;
+        if (_g.getLabelById(si, di, w))
+            insertEdge(si, di, w);
+    }
+
+    void onEdgeRemoved(UInt si, UInt di) override
+    {
+        UInt x = findTreeEdge(si, di);
+        if (x == NO_NODE)
+            return;
+
+        cutTreeEdge(x);
+        reconnect(si, di);
+    }
+
+    void onVertexRemoved(UInt id, UInt movedId) override
+    {
+        // the vertex has no edges by now, so its node is a tree of its own
+        freeNode(_vertNodes[id]);
+        _vertNodes[id] = _vertNodes[movedId];
+        _vertNodes.pop_back();
+    }
+
+    void onCompacted(const std::vector<UInt>& newIds) override
+    {
+        // tree edges refer to vertex nodes, so only the IDs are remapped
+        std::vector<UInt> vertNodes(_g.getVerticesNum(), NO_NODE);
+        for (UInt id = 0; id < newIds.size(); ++id)
+        {
+            if (newIds[id] == VertexIdMap<Vertex>::NO_ID)
+                freeNode(_vertNodes[id]);
+            else
+                vertNodes[newIds[id]] = _vertNodes[id];
+        }
+        _vertNodes.swap(vertNodes);
+    }
+
+    void onEdgeLabelChanged(UInt si, UInt di) override
+    {
+        Weight w;
+        if (!_g.getLabelById(si, di, w))
+            return;
+
+        UInt x = findTreeEdge(si, di);
+        if (x == NO_NODE)
+        {
+            // the same as a new edge
+            insertEdge(si, di, w);
+            return;
+        }
+
+        if (!(_nodes[x].w < w))
+        {
+            // a cheaper tree edge stays; the path to it is the whole splay
+            // tree after access, so only its aggregate changes
+            access(x);
+            _weight = _weight - _nodes[x].w + w;
+            _nodes[x].w = w;
+            pull(x);
+            return;
+        }
+
+        cutTreeEdge(x);
+        reconnect(si, di);
+    }
+
+protected:
+    /// Node of the link-cut tree: a vertex or a tree edge.
+    struct Node {
+        UInt ch[2] = { NO_NODE, NO_NODE };  ///< Children in the splay tree.
+        UInt par = NO_NODE;                 ///< Splay or path parent.
+        UInt maxNode = NO_NODE;             ///< Heaviest edge in the subtree.
+        bool rev = false;                   ///< Subtree to be reversed.
+        bool isEdge = false;                ///< Edge node.
+        Weight w = Weight();                ///< Edge weight.
+        Edge e;                             ///< Normalized edge.
+        UInt ends[2] = { NO_NODE, NO_NODE };///< Vertex nodes of edge ends.
+    };
+
+    // Forest operations
+
+    /// Adds the labeled edge between vertices with IDs \a si and \a di to the
+    /// forest if it joins two trees or is lighter than the heaviest edge of
+    /// the cycle it makes.
+    void insertEdge(UInt si, UInt di, const Weight& w)
+    {
+        if (si == di)
+            return;
+
+        UInt nu = _vertNodes[si];
+        UInt nv = _vertNodes[di];
+        Edge e = Graph::makeNormalizedEdge(_g.getVertexById(si),
+                                           _g.getVertexById(di));
+        if (findRoot(nu) != findRoot(nv))
+        {
+            linkTreeEdge(nu, nv, w, e);
+            return;
+        }
+
+        UInt m = getPathMax(nu, nv);
+        if (std::tie(w, e) < std::tie(_nodes[m].w, _nodes[m].e))
+        {
+            cutTreeEdge(m);
+            linkTreeEdge(nu, nv, w, e);
+        }
+    }
+
+    /// Links the cheapest edge joining the tree of the vertex with ID \a si
+    /// to the tree of the vertex with ID \a di, if any.
+    void reconnect(UInt si, UInt di)
+    {
+        if (_marks.size() < _g.getVerticesNum())
+            _marks.resize(_g.getVerticesNum(), 0);
+        ++_epoch;
+
+        // both trees are searched by one vertex in turns until one is over
+        std::vector<UInt> parts[2] = { { si }, { di } };
+        size_t heads[2] = { 0, 0 };
+        _marks[si] = _epoch * 2;
+        _marks[di] = _epoch * 2 + 1;
+        int done = -1;
+        while (done < 0)
+        {
+            for (int p = 0; p < 2 && done < 0; ++p)
+            {
+                if (heads[p] == parts[p].size())
+                {
+                    done = p;
+                    break;
+                }
+
+                UInt x = parts[p][heads[p]++];
+                auto ns = getAdjEdgesOfId(_g, x, 0);
+                for (auto it = ns.first; it != ns.second; ++it)
+                {
+                    UInt y = _g.getAdjVertexId(it);
+                    if (_marks[y] != _epoch * 2 + p
+                            && findTreeEdge(x, y) != NO_NODE)
+                    {
+                        _marks[y] = _epoch * 2 + p;
+                        parts[p].push_back(y);
+                    }
+                }
+            }
+        }
+
+        // any edge leaving the complete part goes to the other one
+        const std::uint64_t inside = _epoch * 2 + done;
+        UInt bestX = NO_NODE, bestY = NO_NODE;
+        Weight bestW = Weight();
+        Edge bestE;
+        for (UInt x : parts[done])
+        {
+            auto ns = getAdjEdgesOfId(_g, x, 0);
+            for (auto it = ns.first; it != ns.second; ++it)
+            {
+                UInt y = _g.getAdjVertexId(it);
+                Weight w;
+                if (_marks[y] == inside || !_g.getLabelById(x, y, w))
+                    continue;
+
+                Edge e = Graph::makeNormalizedEdge(_g.getVertexById(x),
+                                                   _g.getVertexById(y));
+                if (bestX == NO_NODE || std::tie(w, e) < std::tie(bestW, bestE))
+                {
+                    bestX = x;
+                    bestY = y;
+                    bestW = w;
+                    bestE = e;
+                }
+            }
+        }
+
+        if (bestX != NO_NODE)
+            linkTreeEdge(_vertNodes[bestX], _vertNodes[bestY], bestW, bestE);
+    }
+
+    /// Links the vertex nodes \a nu and \a nv of different trees by a new
+    /// edge node.
+    void linkTreeEdge(UInt nu, UInt nv, const Weight& w, const Edge& e)
+    {
+        UInt x = makeNode();
+        _nodes[x].isEdge = true;
+        _nodes[x].w = w;
+        _nodes[x].e = e;
+        _nodes[x].ends[0] = nu;
+        _nodes[x].ends[1] = nv;
+        pull(x);
+
+        link(nu, x);
+        link(x, nv);
+        _treeEdges[makeKey(nu, nv)] = x;
+        _weight = _weight + w;
+    }
+
+    /// Cuts the edge node \a x out of the forest and frees it.
+    void cutTreeEdge(UInt x)
+    {
+        UInt nu = _nodes[x].ends[0];
+        UInt nv = _nodes[x].ends[1];
+        cut(nu, x);
+        cut(x, nv);
+        _treeEdges.erase(makeKey(nu, nv));
+        _weight = _weight - _nodes[x].w;
+        freeNode(x);
+    }
+
+    /// Returns the edge node of the tree edge between vertices with IDs \a si
+    /// and \a di, NO_NODE if the edge is not in the forest.
+    UInt findTreeEdge(UInt si, UInt di) const
+    {
+        auto it = _treeEdges.find(makeKey(_vertNodes[si], _vertNodes[di]));
+        return it == _treeEdges.end() ? NO_NODE : it->second;
+    }
+
+    /// Makes a key of a tree edge from vertex nodes of its ends, which, unlike
+    /// vertex IDs, do not change when vertices are removed.
+    static std::uint64_t makeKey(UInt nu, UInt nv)
+    {
+        if (nv < nu)
+            std::swap(nu, nv);
+        return (std::uint64_t(nu) << 32) | nv;
+    }
+
+    // Node pool
+
+    UInt makeNode()
+    {
+        if (_freeNodes.empty())
+        {
+            _nodes.push_back(Node());
+            return UInt(_nodes.size() - 1);
+        }
+
+        UInt x = _freeNodes.back();
+        _freeNodes.pop_back();
+        return x;
+    }
+
+    void freeNode(UInt x)
+    {
+        _nodes[x] = Node();
+        _freeNodes.push_back(x);
+    }
+
+    // Link-cut tree operations
+
+    /// Returns true if \a x is the root of its splay tree.
+    bool isSplayRoot(UInt x) const
+    {
+        UInt p = _nodes[x].par;
+        return p == NO_NODE || (_nodes[p].ch[0] != x && _nodes[p].ch[1] != x);
+    }
+
+    /// Pushes the pending reversal of \a x down to its children.
+    void push(UInt x)
+    {
+        Node& n = _nodes[x];
+        if (!n.rev)
+            return;
+
+        std::swap(n.ch[0], n.ch[1]);
+        for (UInt c : n.ch)
+            if (c != NO_NODE)
+                _nodes[c].rev = !_nodes[c].rev;
+        n.rev = false;
+    }
+
+    /// Recomputes the heaviest edge in the splay subtree of \a x.
+    void pull(UInt x)
+    {
+        Node& n = _nodes[x];
+        n.maxNode = n.isEdge ? x : NO_NODE;
+        for (UInt c : n.ch)
+        {
+            if (c == NO_NODE)
+                continue;
+
+            UInt m = _nodes[c].maxNode;
+            if (m != NO_NODE && (n.maxNode == NO_NODE
+                    || std::tie(_nodes[n.maxNode].w, _nodes[n.maxNode].e)
+                       < std::tie(_nodes[m].w, _nodes[m].e)))
+                n.maxNode = m;
+        }
+    }
+
+    void rotate(UInt x)
+    {
+        UInt p = _nodes[x].par;
+        UInt g = _nodes[p].par;
+        int dx = _nodes[p].ch[1] == x;
+
+        if (!isSplayRoot(p))
+            _nodes[g].ch[_nodes[g].ch[1] == p] = x;
+        _nodes[x].par = g;
+
+        UInt b = _nodes[x].ch[dx ^ 1];
+        _nodes[p].ch[dx] = b;
+        if (b != NO_NODE)
+            _nodes[b].par = p;
+
+        _nodes[x].ch[dx ^ 1] = p;
+        _nodes[p].par = x;
+        pull(p);
+        pull(x);
+    }
+
+    void splay(UInt x)
+    {
+        // reversals are pushed down from the splay root first
+        _path.clear();
+        for (UInt y = x; ; y = _nodes[y].par)
+        {
+            _path.push_back(y);
+            if (isSplayRoot(y))
+                break;
+        }
+        for (auto it = _path.rbegin(); it != _path.rend(); ++it)
+            push(*it);
+
+        while (!isSplayRoot(x))
+        {
+            UInt p = _nodes[x].par;
+            if (!isSplayRoot(p))
+            {
+                UInt g = _nodes[p].par;
+                bool zigzig = (_nodes[g].ch[0] == p) == (_nodes[p].ch[0] == x);
+                rotate(zigzig ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    /// Makes the path from the root to \a x preferred; \a x becomes the root
+    /// of its splay tree, which holds exactly that path.
+    void access(UInt x)
+    {
+        for (UInt last = NO_NODE, y = x; y != NO_NODE; last = y, y = _nodes[y].par)
+        {
+            splay(y);
+            _nodes[y].ch[1] = last;
+            pull(y);
+        }
+        splay(x);
+    }
+
+    void makeRoot(UInt x)
+    {
+        access(x);
+        _nodes[x].rev = !_nodes[x].rev;
+    }
+
+    UInt findRoot(UInt x)
+    {
+        access(x);
+        push(x);
+        while (_nodes[x].ch[0] != NO_NODE)
+        {
+            x = _nodes[x].ch[0];
+            push(x);
+        }
+        splay(x);
+
+        return x;
+    }
+
+    /// Links the root of the tree of \a x, made \a x, to \a y.
+    void link(UInt x, UInt y)
+    {
+        makeRoot(x);
+        _nodes[x].par = y;
+    }
+
+    /// Cuts the link between adjacent nodes \a x and \a y.
+    void cut(UInt x, UInt y)
+    {
+        makeRoot(x);
+        access(y);
+        _nodes[y].ch[0] = NO_NODE;
+        _nodes[x].par = NO_NODE;
+        pull(y);
+    }
+
+    /// Returns the heaviest edge node on the path between \a x and \a y.
+    UInt getPathMax(UInt x, UInt y)
+    {
+        makeRoot(x);
+        access(y);
+        return _nodes[y].maxNode;
+    }
+
+protected:
+    Graph& _g;                              ///< Graph spanned.
+    std::vector<Node> _nodes;               ///< Link-cut tree nodes.
+    std::vector<UInt> _freeNodes;           ///< Nodes to reuse.
+    std::vector<UInt> _vertNodes;           ///< Nodes by vertex IDs.
+    std::unordered_map<std::uint64_t, UInt> _treeEdges; ///< Edge nodes.
+    Weight _weight = Weight();              ///< Total weight.
+
+    std::vector<std::uint64_t> _marks;      ///< Parts found by reconnect().
+    std::uint64_t _epoch = 0;               ///< Current mark base.
+    std::vector<UInt> _path;                ///< Buffer of splay().
+}; // class DynamicMST
+
+template <typename Graph>
+const typename DynamicMST<Graph>::UInt DynamicMST<Graph>::NO_NODE;
+
+
+#endif // DYN_MST_HPP
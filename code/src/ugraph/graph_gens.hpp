@@ -0,0 +1,508 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains generators of large synthetic graphs.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+/// Every generator streams edges to a sink in chunks, so the whole edge set
+/// never has to be kept in memory. The work is split into blocks of a fixed
+/// size, each block draws its random numbers from its own generator seeded by
+/// the seed of the graph and the block number. Thus the same seed gives the
+/// same set of edges whatever the number of threads is (only the order of
+/// chunks may differ; collectGenEdges() and makeGenGraph() sort edges, so
+/// their results, including labels of repeated edges, are the same too).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GRAPH_GENS_HPP
+#define GRAPH_GENS_HPP
+
+#include <vector>
+#include <tuple>
+#include <mutex>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <functional>
+
+#include "lbl_ugraph.hpp"
+#include "par_utils.hpp"
+
+
+/// Generated edge (s, d, weight) with vertices numbered from 0.
+typedef std::tuple<unsigned int, unsigned int, double> GenEdge;
+
+/// Graph type made of generated edges.
+typedef EdgeLblUGraph<unsigned int, double> GenGraph;
+
+
+/*! ****************************************************************************
+ *  \brief Base class of graph generators: counter-based random numbers and
+ *  chunked output of edges.
+ *
+ *  A sink is called as sink(const GenEdge* edges, size_t edgesNum, threadIdx)
+ *  concurrently from several threads, so it must be thread-safe (e.g. use
+ *  threadIdx to choose a per-thread buffer). Generators may emit duplicate
+ *  edges and self-loops where the model allows them; graph builders
+ *  (UGraph::fromEdges()) remove duplicates.
+ ******************************************************************************/
+class GraphGen {
+public:
+    typedef unsigned int UInt;
+    typedef std::uint64_t UInt64;
+
+    /// Number of edges passed to a sink at once.
+    static const size_t CHUNK_SIZE = 1 << 14;
+
+public:
+    GraphGen(UInt64 seed) : _seed(seed) {}
+
+    /// Mixes bits of \a x (the finalizer of splitmix64).
+    static UInt64 mix(UInt64 x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    /// Makes a double in [0, 1) from random bits \a x.
+    static double toUnit(UInt64 x)
+    {
+        return double(x >> 11) * (1.0 / 9007199254740992.0);      // 2^-53
+    }
+
+    /// Returns a random number depending only on the seed and \a i.
+    UInt64 hashOf(UInt64 i) const { return mix(mix(_seed) ^ i); }
+
+    UInt64 getSeed() const { return _seed; }
+
+protected:
+    /// Sequential generator of a block.
+    class BlockRng {
+    public:
+        BlockRng(UInt64 seed, UInt64 block) : _state(mix(seed) ^ mix(~block)) {}
+
+        UInt64 next() { return mix(_state += 0x9e3779b97f4a7c15ULL); }
+        double nextUnit() { return toUnit(next()); }
+
+    protected:
+        UInt64 _state;
+    };
+
+    /// Collects edges of a block and passes them to the sink chunk by chunk.
+    template <typename Sink>
+    class ChunkWriter {
+    public:
+        ChunkWriter(Sink& sink, unsigned int tid) : _sink(sink), _tid(tid)
+        {
+            _buf.reserve(CHUNK_SIZE);
+        }
+
+        ~ChunkWriter() { flush(); }
+
+        void add(UInt s, UInt d, double w)
+        {
+            _buf.push_back(GenEdge(s, d, w));
+            if (_buf.size() == CHUNK_SIZE)
+                flush();
+        }
+
+        void flush()
+        {
+            if (!_buf.empty())
+                _sink(_buf.data(), _buf.size(), _tid);
+            _buf.clear();
+        }
+
+    protected:
+        Sink& _sink;
+        unsigned int _tid;
+        std::vector<GenEdge> _buf;
+    };
+
+protected:
+    UInt64 _seed;                   ///< Seed of the graph.
+}; // class GraphGen
+
+
+/*! ****************************************************************************
+ *  \brief Erdős–Rényi G(n, p) graph: each pair of distinct vertices is joined
+ *  with probability p; weights are uniform in [0, 1).
+ *
+ *  Absent pairs are skipped by geometric jumps (Batagelj & Brandes), so the
+ *  time is proportional to n + m rather than n^2.
+ ******************************************************************************/
+class ErdosRenyiGen : public GraphGen {
+public:
+    /// Rows of the adjacency matrix in a block.
+    static const UInt BLOCK_ROWS = 256;
+
+public:
+    ErdosRenyiGen(UInt n, double p, UInt64 seed)
+        : GraphGen(seed), _n(n), _p(p)
+    {
+        if (p < 0 || p > 1)
+            throw std::invalid_argument("Probability must be in [0, 1]");
+    }
+
+    UInt getVerticesNum() const { return _n; }
+
+    template <typename Sink>
+    void generate(Sink sink, unsigned int threadsNum = 0) const
+    {
+        if (_p == 0 || _n < 2)
+            return;
+
+        double lq = std::log(1.0 - _p);
+        parallelForBlocks((_n + BLOCK_ROWS - 1) / BLOCK_ROWS, threadsNum,
+            [&](size_t block, unsigned int tid)
+            {
+                BlockRng rng(_seed, block);
+                ChunkWriter<Sink> out(sink, tid);
+                UInt rowEnd = UInt(std::min<UInt64>(_n, (block + 1) * BLOCK_ROWS));
+                for (UInt v = UInt(block * BLOCK_ROWS); v < rowEnd; ++v)
+                {
+                    // pairs (v, w) with w < v
+                    for (UInt64 w = nextPair(rng, lq, UInt64(-1)); w < v;
+                         w = nextPair(rng, lq, w))
+                        out.add(v, UInt(w), rng.nextUnit());
+                }
+            });
+    }
+
+protected:
+    /// Returns the next present pair after \a w.
+    UInt64 nextPair(BlockRng& rng, double lq, UInt64 w) const
+    {
+        if (_p == 1)
+            return w + 1;
+
+        double jump = std::floor(std::log(1.0 - rng.nextUnit()) / lq);
+        if (jump > double(_n))
+            return _n;                  // beyond any row
+
+        return w + 1 + UInt64(jump);
+    }
+
+protected:
+    UInt _n;
+    double _p;
+}; // class ErdosRenyiGen
+
+
+/*! ****************************************************************************
+ *  \brief R-MAT (recursive matrix, Kronecker) graph with 2^scale vertices:
+ *  each edge descends scale levels of the adjacency matrix choosing quadrants
+ *  with probabilities a, b, c and 1 - a - b - c; weights are uniform in [0, 1).
+ *
+ *  Gives skewed degree distributions with many duplicates and self-loops in
+ *  the stream.
+ ******************************************************************************/
+class RMatGen : public GraphGen {
+public:
+    /// Edges in a block.
+    static const UInt BLOCK_EDGES = 1 << 16;
+
+public:
+    RMatGen(UInt scale, UInt64 edgesNum, UInt64 seed,
+            double a = 0.57, double b = 0.19, double c = 0.19)
+        : GraphGen(seed), _scale(scale), _edgesNum(edgesNum)
+        , _a(a), _b(b), _c(c)
+    {
+        if (scale > 31)
+            throw std::invalid_argument("Scale must not exceed 31");
+        if (a < 0 || b < 0 || c < 0 || a + b + c > 1)
+            throw std::invalid_argument("Invalid quadrant probabilities");
+    }
+
+    UInt getVerticesNum() const { return UInt(1) << _scale; }
+
+    template <typename Sink>
+    void generate(Sink sink, unsigned int threadsNum = 0) const
+    {
+        parallelForBlocks((_edgesNum + BLOCK_EDGES - 1) / BLOCK_EDGES, threadsNum,
+            [&](size_t block, unsigned int tid)
+            {
+                BlockRng rng(_seed, block);
+                ChunkWriter<Sink> out(sink, tid);
+                UInt64 end = std::min<UInt64>(_edgesNum, (block + 1) * BLOCK_EDGES);
+                for (UInt64 i = UInt64(block) * BLOCK_EDGES; i < end; ++i)
+                {
+                    UInt s = 0, d = 0;
+                    for (UInt lvl = 0; lvl < _scale; ++lvl)
+                    {
+                        double r = rng.nextUnit();
+                        UInt bs = (r >= _a + _b) ? 1 : 0;
+                        UInt bd = (r >= _a && r < _a + _b) || (r >= _a + _b + _c)
+                                ? 1 : 0;
+                        s = (s << 1) | bs;
+                        d = (d << 1) | bd;
+                    }
+                    out.add(s, d, rng.nextUnit());
+                }
+            });
+    }
+
+protected:
+    UInt _scale;
+    UInt64 _edgesNum;
+    double _a, _b, _c;
+}; // class RMatGen
+
+
+/*! ****************************************************************************
+ *  \brief Barabási–Albert graph: vertices 0, 1, ..., n - 1 come one by one,
+ *  each attaching k edges to earlier vertices chosen with probability
+ *  proportional to their degrees; weights are uniform in [0, 1).
+ *
+ *  Uses the parallel formulation by Sanders & Schulz: the i-th edge goes
+ *  from i / k to the vertex found at a uniformly random earlier position of
+ *  the (virtual) list of edge ends, and any position can be resolved from
+ *  the seed alone. Vertex 0 starts with self-loops.
+ ******************************************************************************/
+class BarabasiAlbertGen : public GraphGen {
+public:
+    /// Edges in a block.
+    static const UInt BLOCK_EDGES = 1 << 16;
+
+public:
+    BarabasiAlbertGen(UInt n, UInt k, UInt64 seed)
+        : GraphGen(seed), _n(n), _k(k)
+    {
+        if (k == 0)
+            throw std::invalid_argument("Number of edges per vertex must be positive");
+    }
+
+    UInt getVerticesNum() const { return _n; }
+
+    template <typename Sink>
+    void generate(Sink sink, unsigned int threadsNum = 0) const
+    {
+        UInt64 edgesNum = UInt64(_n) * _k;
+        parallelForBlocks((edgesNum + BLOCK_EDGES - 1) / BLOCK_EDGES, threadsNum,
+            [&](size_t block, unsigned int tid)
+            {
+                ChunkWriter<Sink> out(sink, tid);
+                UInt64 end = std::min<UInt64>(edgesNum, (block + 1) * BLOCK_EDGES);
+                for (UInt64 i = UInt64(block) * BLOCK_EDGES; i < end; ++i)
+                    out.add(UInt(i / _k), getEnd(2 * i + 1), toUnit(hashOf(~i)));
+            });
+    }
+
+protected:
+    /// Resolves the vertex at the position \a pos of the list of edge ends:
+    /// an even position 2i holds the source of the i-th edge, an odd one
+    /// copies a random earlier position.
+    UInt getEnd(UInt64 pos) const
+    {
+        while (pos % 2 == 1)
+            pos = hashOf(pos) % pos;
+
+        return UInt(pos / 2 / _k);
+    }
+
+protected:
+    UInt _n;
+    UInt _k;
+}; // class BarabasiAlbertGen
+
+
+/*! ****************************************************************************
+ *  \brief 2D or 3D grid of sizeX * sizeY * sizeZ vertices, each joined with
+ *  its neighbours along the axes; weights are uniform in [0, 1).
+ *
+ *  The vertex (x, y, z) has the number (z * sizeY + y) * sizeX + x.
+ ******************************************************************************/
+class GridGen : public GraphGen {
+public:
+    /// Vertices in a block.
+    static const UInt BLOCK_VERTS = 1 << 14;
+
+public:
+    GridGen(UInt sizeX, UInt sizeY, UInt sizeZ, UInt64 seed)
+        : GraphGen(seed), _sizeX(sizeX), _sizeY(sizeY), _sizeZ(sizeZ)
+    {
+        if (UInt64(sizeX) * sizeY * sizeZ > UInt64(UInt(-1)))
+            throw std::invalid_argument("Too many vertices");
+    }
+
+    UInt getVerticesNum() const { return _sizeX * _sizeY * _sizeZ; }
+
+    template <typename Sink>
+    void generate(Sink sink, unsigned int threadsNum = 0) const
+    {
+        UInt n = getVerticesNum();
+        UInt layer = _sizeX * _sizeY;
+        parallelForBlocks((UInt64(n) + BLOCK_VERTS - 1) / BLOCK_VERTS, threadsNum,
+            [&](size_t block, unsigned int tid)
+            {
+                ChunkWriter<Sink> out(sink, tid);
+                UInt end = UInt(std::min<UInt64>(n, (block + 1) * BLOCK_VERTS));
+                for (UInt v = UInt(block * BLOCK_VERTS); v < end; ++v)
+                {
+                    UInt x = v % _sizeX;
+                    UInt y = (v / _sizeX) % _sizeY;
+                    UInt z = v / layer;
+                    if (x + 1 < _sizeX)
+                        out.add(v, v + 1, toUnit(hashOf(UInt64(v) * 3)));
+                    if (y + 1 < _sizeY)
+                        out.add(v, v + _sizeX, toUnit(hashOf(UInt64(v) * 3 + 1)));
+                    if (z + 1 < _sizeZ)
+                        out.add(v, v + layer, toUnit(hashOf(UInt64(v) * 3 + 2)));
+                }
+            });
+    }
+
+protected:
+    UInt _sizeX, _sizeY, _sizeZ;
+}; // class GridGen
+
+
+/*! ****************************************************************************
+ *  \brief Random geometric graph: n points uniform in the unit square, two
+ *  points are joined if they are at most radius apart; the weight of an edge
+ *  is the Euclidean distance.
+ *
+ *  Points are bucketed into square cells of side not less than the radius, so
+ *  only points in neighbouring cells are compared. Points (but not edges) are
+ *  kept in memory.
+ ******************************************************************************/
+class RandomGeometricGen : public GraphGen {
+public:
+    RandomGeometricGen(UInt n, double radius, UInt64 seed)
+        : GraphGen(seed), _n(n), _radius(radius)
+    {
+        if (radius <= 0)
+            throw std::invalid_argument("Radius must be positive");
+    }
+
+    UInt getVerticesNum() const { return _n; }
+
+    /// Returns the coordinates of the point \a v.
+    void getPoint(UInt v, double& x, double& y) const
+    {
+        x = toUnit(hashOf(UInt64(v) * 2));
+        y = toUnit(hashOf(UInt64(v) * 2 + 1));
+    }
+
+    template <typename Sink>
+    void generate(Sink sink, unsigned int threadsNum = 0) const
+    {
+        // cells, sorted by counting
+        UInt cellsNum = UInt(std::min(1.0 / _radius, std::sqrt(double(_n)) + 1));
+        if (cellsNum == 0)
+            cellsNum = 1;
+
+        std::vector<double> xs(_n), ys(_n);
+        std::vector<UInt> cellOf(_n);
+        std::vector<UInt> starts(UInt64(cellsNum) * cellsNum + 1, 0);
+        for (UInt v = 0; v < _n; ++v)
+        {
+            getPoint(v, xs[v], ys[v]);
+            UInt cx = std::min(cellsNum - 1, UInt(xs[v] * cellsNum));
+            UInt cy = std::min(cellsNum - 1, UInt(ys[v] * cellsNum));
+            cellOf[v] = cy * cellsNum + cx;
+            ++starts[cellOf[v] + 1];
+        }
+        for (size_t c = 1; c < starts.size(); ++c)
+            starts[c] += starts[c - 1];
+
+        std::vector<UInt> points(_n);
+        std::vector<UInt> fill(starts.begin(), starts.end() - 1);
+        for (UInt v = 0; v < _n; ++v)
+            points[fill[cellOf[v]]++] = v;
+
+        // each row of cells is a block; a cell is compared with itself and
+        // with the half of its neighbours, so each pair is met once
+        const double r2 = _radius * _radius;
+        parallelForBlocks(cellsNum, threadsNum,
+            [&](size_t cy, unsigned int tid)
+            {
+                ChunkWriter<Sink> out(sink, tid);
+                static const int NEIGHBOURS[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+                for (UInt cx = 0; cx < cellsNum; ++cx)
+                {
+                    UInt c = UInt(cy) * cellsNum + cx;
+                    for (UInt i = starts[c]; i < starts[c + 1]; ++i)
+                    {
+                        UInt u = points[i];
+                        for (UInt j = i + 1; j < starts[c + 1]; ++j)
+                            addIfClose(out, u, points[j], xs, ys, r2);
+
+                        for (const int* nb : NEIGHBOURS)
+                        {
+                            long nx = long(cx) + nb[0], ny = long(cy) + nb[1];
+                            if (nx < 0 || nx >= long(cellsNum) || ny >= long(cellsNum))
+                                continue;
+
+                            UInt nc = UInt(ny) * cellsNum + UInt(nx);
+                            for (UInt j = starts[nc]; j < starts[nc + 1]; ++j)
+                                addIfClose(out, u, points[j], xs, ys, r2);
+                        }
+                    }
+                }
+            });
+    }
+
+protected:
+    template <typename Writer>
+    static void addIfClose(Writer& out, UInt u, UInt v,
+                           const std::vector<double>& xs,
+                           const std::vector<double>& ys, double r2)
+    {
+        double dx = xs[u] - xs[v], dy = ys[u] - ys[v];
+        double d2 = dx * dx + dy * dy;
+        if (d2 <= r2)
+            out.add(u, v, std::sqrt(d2));
+    }
+
+protected:
+    UInt _n;
+    double _radius;
+}; // class RandomGeometricGen
+
+
+/// Runs the generator \a gen on \a threadsNum threads (0 means all available
+/// cores) and collects all its edges in memory. Edges are sorted, so their
+/// order does not depend on the order in which threads have passed chunks.
+template <typename Gen>
+std::vector<GenEdge> collectGenEdges(const Gen& gen, unsigned int threadsNum = 0)
+{
+    std::vector<GenEdge> res;
+    std::mutex mtx;
+    gen.generate([&](const GenEdge* edges, size_t edgesNum, unsigned int)
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            res.insert(res.end(), edges, edges + edgesNum);
+        }, threadsNum);
+
+    parallelSort(res.begin(), res.end(), threadsNum, std::less<GenEdge>());
+    return res;
+}
+
+
+/// Makes a graph from edges of the generator \a gen. Isolated vertices are
+/// added too, so the graph has exactly gen.getVerticesNum() vertices. Of the
+/// repeated edges, the one first in the sorted order gives the label.
+template <typename Gen>
+GenGraph makeGenGraph(const Gen& gen, unsigned int threadsNum = 0)
+{
+    std::vector<GenEdge> edges = collectGenEdges(gen, threadsNum);
+    GenGraph g = GenGraph::fromEdges(edges.begin(), edges.end(), threadsNum);
+    for (unsigned int v = 0; v < gen.getVerticesNum(); ++v)
+        g.addVertex(v);
+
+    return g;
+}
+
+
+#endif // GRAPH_GENS_HPP
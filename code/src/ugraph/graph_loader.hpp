@@ -0,0 +1,483 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains parallel loaders of labeled graphs from edge lists and
+///             DOT files.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+/// A text is split into chunks at line boundaries, the chunks are parsed on
+/// several threads, and the collected edges are passed to the bulk builder
+/// EdgeLblUGraph::fromBulkEdges(), so repeated edges keep their first label
+/// as if the edges were added one by one in the order of the text.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef GRAPH_LOADER_HPP
+#define GRAPH_LOADER_HPP
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <exception>
+#include <type_traits>
+#include <cstdlib>
+#include <cstddef>
+
+#include "lbl_ugraph.hpp"
+#include "mapped_file.hpp"
+#include "par_utils.hpp"
+
+
+/*! ****************************************************************************
+ *  \brief Parses values of various types from ranges of characters.
+ *
+ *  Integers are parsed manually, floating point values by strtod() on a short
+ *  local copy, characters and strings are taken as they are, values of other
+ *  types fall back to their operator>>. Each method returns false if the
+ *  whole range is not a valid value.
+ ******************************************************************************/
+class TextValueParser {
+public:
+    static bool parseValue(const char* b, const char* e, char& v)
+    {
+        if (e - b != 1)
+            return false;
+
+        v = *b;
+        return true;
+    }
+
+    static bool parseValue(const char* b, const char* e, std::string& v)
+    {
+        v.assign(b, e);
+        return true;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value, bool>::type
+        parseValue(const char* b, const char* e, T& v)
+    {
+        typedef unsigned long long ULL;
+
+        bool neg = false;
+        if (b != e && (*b == '-' || *b == '+'))
+        {
+            neg = (*b == '-');
+            if (neg && !std::is_signed<T>::value)
+                return false;
+            ++b;
+        }
+        if (b == e)
+            return false;
+
+        const ULL limit = neg ? ULL(std::numeric_limits<T>::max()) + 1
+                              : ULL(std::numeric_limits<T>::max());
+        ULL acc = 0;
+        for (; b != e; ++b)
+        {
+            unsigned int d = unsigned(*b - '0');
+            if (d > 9 || acc > (limit - d) / 10)
+                return false;
+            acc = acc * 10 + d;
+        }
+
+        // negation is done in the unsigned type to reach the minimum value
+        v = neg ? T(0 - acc) : T(acc);
+        return true;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+        parseValue(const char* b, const char* e, T& v)
+    {
+        // strtod() needs a terminated string
+        char buf[64];
+        size_t n = size_t(e - b);
+        if (n == 0 || n >= sizeof(buf))
+            return false;
+
+        std::copy(b, e, buf);
+        buf[n] = '\0';
+
+        char* end;
+        v = T(std::strtod(buf, &end));
+        return end == buf + n;
+    }
+
+    /// Slow path for other types.
+    template <typename T>
+    static typename std::enable_if<!std::is_arithmetic<T>::value, bool>::type
+        parseValue(const char* b, const char* e, T& v)
+    {
+        std::istringstream ss(std::string(b, e));
+        ss >> v;
+        return !ss.fail() && ss.peek() == std::char_traits<char>::eof();
+    }
+}; // class TextValueParser
+
+
+/*! ****************************************************************************
+ *  \brief Parallel parser of labeled graphs in text formats.
+ *
+ *  \tparam Vertex represents a type for vertices.
+ *  \tparam EdgeLbl represents a type for edge labeling.
+ *
+ *  Supported formats:
+ *  - EDGE_LIST: a line "u v w" gives an edge {u, v} labeled w, a line "u v"
+ *  gives an unlabeled edge, a line "u" gives a vertex; tokens are separated
+ *  by spaces or tabs, empty lines and lines starting with '#' or '%' are
+ *  skipped;
+ *  - DOT: the subset EdgeLblUGraphDotVisitor writes: lines "u -- v" with an
+ *  optional attribute list [label="w", ...] give edges, lines "u" give
+ *  vertices, lines opening or closing the graph and other statements
+ *  (e.g. "label=...;" and "node [...];") are skipped. Vertices may be quoted.
+ ******************************************************************************/
+template <typename Vertex, typename EdgeLbl>
+class GraphTextParser {
+public:
+    typedef EdgeLblUGraph<Vertex, EdgeLbl> Graph;
+    typedef typename Graph::BulkEdge BulkEdge;
+
+    /// Supported formats.
+    enum Format { EDGE_LIST, DOT };
+
+public:
+    /// Parses the text \a data of \a size chars in the format \a fmt using
+    /// \a threadsNum threads (0 means all available cores).
+    /// Throws std::invalid_argument if a line can't be parsed.
+    static Graph parse(const char* data, size_t size, Format fmt,
+                       unsigned int threadsNum = 0)
+    {
+        threadsNum = getThreadsNum(threadsNum);
+
+        // several chunks per thread even out uneven lines; chunks begin at
+        // line starts
+        size_t chunksNum = std::max<size_t>(1, std::min<size_t>(
+                                                threadsNum * 4, size / 4096));
+        std::vector<size_t> bounds(chunksNum + 1);
+        bounds[0] = 0;
+        for (size_t c = 1; c < chunksNum; ++c)
+        {
+            size_t pos = std::max(bounds[c - 1], size * c / chunksNum);
+            while (pos < size && pos > 0 && data[pos - 1] != '\n')
+                ++pos;
+            bounds[c] = pos;
+        }
+        bounds[chunksNum] = size;
+
+        // errors are passed from workers to the calling thread
+        std::vector<Chunk> chunks(chunksNum);
+        std::vector<std::exception_ptr> errors(chunksNum);
+        parallelForBlocks(chunksNum, threadsNum,
+            [&](size_t c, unsigned int)
+            {
+                try
+                {
+                    parseChunk(data + bounds[c], data + bounds[c + 1], fmt,
+                               chunks[c]);
+                }
+                catch (...)
+                {
+                    errors[c] = std::current_exception();
+                }
+            });
+
+        for (const std::exception_ptr& err : errors)
+        {
+            if (err)
+                std::rethrow_exception(err);
+        }
+
+        // merges chunks in order of the text
+        size_t edgesNum = 0;
+        for (const Chunk& ch : chunks)
+            edgesNum += ch.edges.size();
+
+        std::vector<BulkEdge> recs;
+        recs.reserve(edgesNum);
+        for (Chunk& ch : chunks)
+        {
+            for (BulkEdge& r : ch.edges)
+            {
+                r.pos = recs.size();
+                recs.push_back(r);
+            }
+            ch.edges.clear();
+            ch.edges.shrink_to_fit();
+        }
+
+        Graph g = Graph::fromBulkEdges(recs, threadsNum);
+        for (const Chunk& ch : chunks)
+        {
+            for (const Vertex& v : ch.vertices)
+                g.addVertex(v);
+        }
+
+        return g;
+    }
+
+protected:
+    /// Result of parsing a chunk.
+    struct Chunk {
+        std::vector<BulkEdge> edges;
+        std::vector<Vertex> vertices;       ///< Vertices given alone.
+    };
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    static const char* skipSpaces(const char* b, const char* e)
+    {
+        while (b != e && isSpace(*b))
+            ++b;
+        return b;
+    }
+
+    static void throwBadLine(const char* b, const char* e)
+    {
+        throw std::invalid_argument("Can't parse graph line: " + std::string(b, e));
+    }
+
+    /// Parses lines of the text [\a b, \a e) into \a ch.
+    static void parseChunk(const char* b, const char* e, Format fmt, Chunk& ch)
+    {
+        while (b != e)
+        {
+            const char* eol = b;
+            while (eol != e && *eol != '\n')
+                ++eol;
+
+            if (fmt == EDGE_LIST)
+                parseEdgeListLine(b, eol, ch);
+            else
+                parseDotLine(b, eol, ch);
+
+            b = (eol == e) ? e : eol + 1;
+        }
+    }
+
+    /// Reads the next token delimited by spaces.
+    static bool nextToken(const char*& b, const char* e,
+                          const char*& tb, const char*& te)
+    {
+        b = skipSpaces(b, e);
+        tb = b;
+        while (b != e && !isSpace(*b))
+            ++b;
+        te = b;
+        return tb != te;
+    }
+
+    static void parseEdgeListLine(const char* b, const char* e, Chunk& ch)
+    {
+        const char* lineBeg = b;
+        const char *t1b, *t1e, *t2b, *t2e, *t3b, *t3e, *t4b, *t4e;
+        if (!nextToken(b, e, t1b, t1e) || *t1b == '#' || *t1b == '%')
+            return;                                     // empty or comment
+
+        Vertex s, d;
+        if (!TextValueParser::parseValue(t1b, t1e, s))
+            throwBadLine(lineBeg, e);
+
+        if (!nextToken(b, e, t2b, t2e))
+        {
+            ch.vertices.push_back(s);
+            return;
+        }
+
+        if (!TextValueParser::parseValue(t2b, t2e, d))
+            throwBadLine(lineBeg, e);
+
+        BulkEdge r{Graph::makeNormalizedEdge(s, d), 0, EdgeLbl(), false};
+        if (nextToken(b, e, t3b, t3e))
+        {
+            if (!TextValueParser::parseValue(t3b, t3e, r.lbl)
+                || nextToken(b, e, t4b, t4e))
+                throwBadLine(lineBeg, e);
+            r.labeled = true;
+        }
+
+        ch.edges.push_back(r);
+    }
+
+    /// Reads a DOT identifier: either quoted (with escapes undone into
+    /// \a buf) or bare, up to a space or one of "[];". Sets [\a tb, \a te) to
+    /// the identifier without quotes.
+    static bool readDotId(const char*& b, const char* e, const char*& tb,
+                          const char*& te, std::string& buf)
+    {
+        b = skipSpaces(b, e);
+        if (b == e)
+            return false;
+
+        if (*b != '"')
+        {
+            tb = b;
+            while (b != e && !isSpace(*b) && *b != '[' && *b != ']' && *b != ';'
+                   && *b != ',' && *b != '=')
+                ++b;
+            te = b;
+            return tb != te;
+        }
+
+        // quoted; escapes are rare, so the text is used directly if possible
+        ++b;
+        tb = b;
+        bool escaped = false;
+        while (b != e && *b != '"')
+        {
+            if (*b == '\\' && b + 1 != e)
+            {
+                escaped = true;
+                ++b;
+            }
+            ++b;
+        }
+        if (b == e)
+            return false;                               // no closing quote
+        te = b++;
+
+        if (escaped)
+        {
+            buf.clear();
+            for (const char* p = tb; p != te; ++p)
+            {
+                if (*p == '\\')
+                    ++p;
+                buf += *p;
+            }
+            tb = buf.data();
+            te = tb + buf.size();
+        }
+
+        return true;
+    }
+
+    static void parseDotLine(const char* b, const char* e, Chunk& ch)
+    {
+        const char* lineBeg = b;
+        b = skipSpaces(b, e);
+        while (e != b && (isSpace(e[-1]) || e[-1] == ';'))
+            --e;                                        // trailing ';'
+        if (b == e || *b == '}' || e[-1] == '{' || (e - b >= 2 && b[0] == '/'
+                                                    && b[1] == '/'))
+            return;                                     // not a graph element
+
+        std::string sBuf, dBuf, lBuf;
+        const char *sb, *se, *db, *de;
+        if (!readDotId(b, e, sb, se, sBuf))
+            throwBadLine(lineBeg, e);
+
+        const char* p = skipSpaces(b, e);
+        if (p != e && *p == '=')
+            return;                                     // graph attribute
+
+        Vertex s;
+        bool isEdge = (e - p >= 2 && p[0] == '-' && (p[1] == '-' || p[1] == '>'));
+        if (!isEdge)
+        {
+            // a statement like "node [...]" or a vertex with attributes
+            if (isDotKeyword(sb, se))
+                return;
+            if (!TextValueParser::parseValue(sb, se, s))
+                throwBadLine(lineBeg, e);
+            ch.vertices.push_back(s);
+            return;
+        }
+
+        b = p + 2;
+        Vertex d;
+        if (!readDotId(b, e, db, de, dBuf)
+            || !TextValueParser::parseValue(sb, se, s)
+            || !TextValueParser::parseValue(db, de, d))
+            throwBadLine(lineBeg, e);
+
+        BulkEdge r{Graph::makeNormalizedEdge(s, d), 0, EdgeLbl(), false};
+
+        // looks for the label in the attribute list
+        b = skipSpaces(b, e);
+        if (b != e && *b == '[')
+        {
+            ++b;
+            const char *kb, *ke, *vb, *ve;
+            while (readDotId(b, e, kb, ke, sBuf))
+            {
+                b = skipSpaces(b, e);
+                if (b == e || *b != '=')
+                    throwBadLine(lineBeg, e);
+                ++b;
+                if (!readDotId(b, e, vb, ve, lBuf))
+                    throwBadLine(lineBeg, e);
+
+                if (ke - kb == 5 && std::string(kb, ke) == "label")
+                {
+                    if (!TextValueParser::parseValue(vb, ve, r.lbl))
+                        throwBadLine(lineBeg, e);
+                    r.labeled = true;
+                }
+
+                b = skipSpaces(b, e);
+                if (b != e && (*b == ',' || *b == ';'))
+                    ++b;
+                else
+                    break;
+            }
+            b = skipSpaces(b, e);
+            if (b == e || *b != ']')
+                throwBadLine(lineBeg, e);
+        }
+
+        ch.edges.push_back(r);
+    }
+
+    static bool isDotKeyword(const char* b, const char* e)
+    {
+        std::string w(b, e);
+        return w == "node" || w == "edge" || w == "graph" || w == "digraph"
+                || w == "subgraph" || w == "strict";
+    }
+}; // class GraphTextParser
+
+
+/// Loads a labeled graph from the edge list file \a fn (see
+/// GraphTextParser::EDGE_LIST) using \a threadsNum threads (0 means all
+/// available cores). The file is memory-mapped, not read.
+/// Throws std::invalid_argument if the file can't be read or parsed.
+template <typename Vertex, typename EdgeLbl>
+EdgeLblUGraph<Vertex, EdgeLbl> loadEdgeListFile(const std::string& fn,
+                                                unsigned int threadsNum = 0)
+{
+    typedef GraphTextParser<Vertex, EdgeLbl> Parser;
+
+    MappedFile mf(fn);
+    return Parser::parse(mf.getData(), mf.getSize(), Parser::EDGE_LIST,
+                         threadsNum);
+}
+
+
+/// Loads a labeled graph from the DOT file \a fn (see GraphTextParser::DOT),
+/// e.g. written by EdgeLblUGraphDotWriter, using \a threadsNum threads (0
+/// means all available cores).
+/// Throws std::invalid_argument if the file can't be read or parsed.
+template <typename Vertex, typename EdgeLbl>
+EdgeLblUGraph<Vertex, EdgeLbl> loadDotFile(const std::string& fn,
+                                           unsigned int threadsNum = 0)
+{
+    typedef GraphTextParser<Vertex, EdgeLbl> Parser;
+
+    MappedFile mf(fn);
+    return Parser::parse(mf.getData(), mf.getSize(), Parser::DOT, threadsNum);
+}
+
+
+#endif // GRAPH_LOADER_HPP
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains an open-addressing hash map for edge labels.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef LBL_HASH_MAP_HPP
+#define LBL_HASH_MAP_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+
+/*! ****************************************************************************
+ *  \brief Open-addressing hash map from undirected edges, given by IDs of
+ *  their ends, to edge labels.
+ *
+ *  \tparam EdgeLbl represents a type for edge labeling.
+ *
+ *  An edge {s, d} is packed into one 64-bit key with the smaller ID in the
+ *  high half, so {s, d} and {d, s} are the same key. Slots live in a single
+ *  array probed linearly, thus a lookup usually touches one cache line and
+ *  never follows pointers.
+ ******************************************************************************/
+template <typename EdgeLbl>
+class EdgeLabelHashMap {
+public:
+    typedef unsigned int UInt;
+    typedef std::uint64_t Key;
+
+public:
+
+    /// Makes a key for the edge {s, d}.
+    static Key makeKey(UInt s, UInt d)
+    {
+        if (d < s)
+            std::swap(s, d);
+
+        return (Key(s) << 32) | Key(d);
+    }
+
+    /// Associates the label \a lbl with the edge {s, d} if the edge has no
+    /// label yet. Returns true if the label has been inserted.
+    bool insert(UInt s, UInt d, const EdgeLbl& lbl)
+    {
+        if ((_size + 1) * 4 > _slots.size() * 3)        // load factor 3/4
+            rehash(_slots.empty() ? 16 : _slots.size() * 2);
+
+        Key k = makeKey(s, d);
+        size_t i = findSlot(k);
+        if (_slots[i].key == k)
+            return false;
+
+        _slots[i].key = k;
+        _slots[i].lbl = lbl;
+        ++_size;
+
+        return true;
+    }
+
+    /// Associates the label \a lbl with the edge {s, d}, replacing the old
+    /// label if any. Returns true if the edge has had no label.
+    bool assign(UInt s, UInt d, const EdgeLbl& lbl)
+    {
+        if (insert(s, d, lbl))
+            return true;
+
+        _slots[findSlot(makeKey(s, d))].lbl = lbl;
+        return false;
+    }
+
+    /// Removes the label of the edge {s, d}. Returns false if there is no one.
+    ///
+    /// No tombstones are left: the following keys of the probe cluster are
+    /// shifted back into the hole unless their home slots are past it.
+    bool erase(UInt s, UInt d)
+    {
+        if (_size == 0)
+            return false;
+
+        Key k = makeKey(s, d);
+        size_t hole = findSlot(k);
+        if (_slots[hole].key != k)
+            return false;
+
+        size_t mask = _slots.size() - 1;
+        for (size_t i = (hole + 1) & mask; _slots[i].key != EMPTY;
+             i = (i + 1) & mask)
+        {
+            // the key stays if its home is cyclically in (hole, i]
+            size_t home = hash(_slots[i].key) & mask;
+            if (((i - home) & mask) < ((i - hole) & mask))
+                continue;
+
+            _slots[hole] = _slots[i];
+            hole = i;
+        }
+
+        _slots[hole] = Slot();
+        --_size;
+
+        return true;
+    }
+
+    /// Looks for the label of the edge {s, d}. Returns true and sets \a lbl if
+    /// the label exists, false otherwise.
+    bool find(UInt s, UInt d, EdgeLbl& lbl) const
+    {
+        if (_size == 0)
+            return false;
+
+        Key k = makeKey(s, d);
+        const Slot& slot = _slots[findSlot(k)];
+        if (slot.key != k)
+            return false;
+
+        lbl = slot.lbl;
+        return true;
+    }
+
+    /// Returns the number of labeled edges.
+    size_t getSize() const { return _size; }
+
+    /// Calls \a fn(s, d, lbl) for every labeled edge {s, d}, s <= d, in the
+    /// order of slots.
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const Slot& slot : _slots)
+        {
+            if (slot.key != EMPTY)
+                fn(UInt(slot.key >> 32), UInt(slot.key), slot.lbl);
+        }
+    }
+
+    /// Prepares the map for \a n labels.
+    void reserve(size_t n)
+    {
+        size_t cap = 16;
+        while (cap * 3 < n * 4)
+            cap *= 2;
+
+        if (cap > _slots.size())
+            rehash(cap);
+    }
+
+protected:
+    /// Key of an empty slot (no pair of real IDs gives it).
+    static const Key EMPTY = ~Key(0);
+
+    struct Slot {
+        Key key = EMPTY;
+        EdgeLbl lbl = EdgeLbl();
+    };
+
+    /// Mixes key bits (the finalizer of splitmix64).
+    static size_t hash(Key k)
+    {
+        k ^= k >> 30;
+        k *= 0xbf58476d1ce4e5b9ULL;
+        k ^= k >> 27;
+        k *= 0x94d049bb133111ebULL;
+        k ^= k >> 31;
+        return size_t(k);
+    }
+
+    /// Returns the slot containing the key \a k or the empty slot where it
+    /// must be placed. The table must not be empty.
+    size_t findSlot(Key k) const
+    {
+        size_t mask = _slots.size() - 1;
+        size_t i = hash(k) & mask;
+        while (_slots[i].key != k && _slots[i].key != EMPTY)
+            i = (i + 1) & mask;
+
+        return i;
+    }
+
+    /// Rebuilds the table with \a cap slots (a power of two).
+    void rehash(size_t cap)
+    {
+        std::vector<Slot> old(cap);
+        old.swap(_slots);
+
+        for (const Slot& slot : old)
+        {
+            if (slot.key != EMPTY)
+                _slots[findSlot(slot.key)] = slot;
+        }
+    }
+
+protected:
+    std::vector<Slot> _slots;       ///< Table, its size is a power of two.
+    size_t _size = 0;               ///< Number of labels.
+}; // class EdgeLabelHashMap
+
+template <typename EdgeLbl>
+const typename EdgeLabelHashMap<EdgeLbl>::Key EdgeLabelHashMap<EdgeLbl>::EMPTY;
+
+
+#endif // LBL_HASH_MAP_HPP
@@ -16,9 +16,11 @@
 #ifndef LBL_UGRAPH_HPP
 #define LBL_UGRAPH_HPP
 
-#include "ugraph.hpp"
+#include <tuple>
+#include <memory>
 
-#include <map>
+#include "ugraph.hpp"
+#include "lbl_hash_map.hpp"
 
 /*! ****************************************************************************
  *  \brief The EdgeLblUGraph class represents a undirected graph with labels on
@@ -26,23 +28,126 @@
  *
  *  \tparam Vertex represents a type for vertices. See requirements for UGraph.
  *  \tparam EdgeLbl represents a type for edge labeling.
+ *  \tparam Alloc is the allocator for nodes, see UGraph.
+ *
+ *  Labels are kept in an open-addressing hash map keyed by IDs of edge ends,
+ *  so getting a label takes O(1) besides finding the IDs.
  ******************************************************************************/
-template <typename Vertex, typename EdgeLbl>
+template <typename Vertex, typename EdgeLbl,
+          typename Alloc = std::allocator<Vertex>>
 class EdgeLblUGraph
-        : public UGraph<Vertex>
+        : public UGraph<Vertex, Alloc>
 {
 public:
     // Aliases
-    typedef UGraph<Vertex> Base;
+    typedef UGraph<Vertex, Alloc> Base;
     typedef typename Base::Edge Edge;
+    typedef typename Base::UInt UInt;
+    typedef typename Base::AdjListCIter AdjListCIter;
+
+    /// Type of edge labels.
+    typedef EdgeLbl Label;
+
+    /// Labeled edge given as a tuple (s, d, label).
+    typedef std::tuple<Vertex, Vertex, EdgeLbl> LblEdge;
 
     // Local datatype definitions
 
     /// Labeling function type for graph edges.
-    typedef std::map<typename Base::Edge, EdgeLbl> EdgeLabeling;
-    typedef typename EdgeLabeling::const_iterator EdgeLabelingCIter;
+    typedef EdgeLabelHashMap<EdgeLbl> EdgeLabeling;
 
 public:
+    EdgeLblUGraph() = default;
+
+    /// Makes an empty graph allocating its nodes by \a alloc. Labels are kept
+    /// in a flat table and do not use it.
+    explicit EdgeLblUGraph(const Alloc& alloc)
+        : Base(alloc)
+    {
+    }
+
+public:
+    /// \brief Builds a graph from the semirange [\a first, \a last) of labeled
+    /// edges.
+    ///
+    /// An element gives the ends and the label of an edge by std::get<0>(),
+    /// std::get<1>() and std::get<2>() (see LblEdge). As in addLblEdge(), the
+    /// first label of a repeated edge wins. See UGraph::fromEdges() for the
+    /// rest.
+    template <typename EdgeIt>
+    static EdgeLblUGraph fromEdges(EdgeIt first, EdgeIt last,
+                                   unsigned int threadsNum = 1)
+    {
+        std::vector<BulkEdge> recs;
+        recs.reserve(size_t(std::distance(first, last)));
+        for (; first != last; ++first)
+            recs.push_back({Base::makeNormalizedEdge(std::get<0>(*first),
+                                                     std::get<1>(*first)),
+                            recs.size(), std::get<2>(*first), true});
+
+        return fromBulkEdges(recs, threadsNum);
+    }
+
+    /// The same as above for the array of \a edgesNum labeled edges.
+    static EdgeLblUGraph fromEdges(const LblEdge* edges, size_t edgesNum,
+                                   unsigned int threadsNum = 1)
+    {
+        return fromEdges(edges, edges + edgesNum, threadsNum);
+    }
+
+    /// \brief Edge record for bulk building, labeled or not.
+    ///
+    /// The position in the input decides which label of a repeated edge wins.
+    struct BulkEdge {
+        Edge e;                 ///< Normalized edge.
+        size_t pos;             ///< Position in the input.
+        EdgeLbl lbl;
+        bool labeled;
+    };
+
+    /// \brief Builds a graph from the records \a recs (which are reordered).
+    ///
+    /// As with addEdge() and addLblEdge() in the order of positions, the label
+    /// of an edge is the first label given for it, if any.
+    static EdgeLblUGraph fromBulkEdges(std::vector<BulkEdge>& recs,
+                                       unsigned int threadsNum = 1)
+    {
+        // labeled records of an edge go first, in order of positions
+        parallelSort(recs.begin(), recs.end(), threadsNum,
+            [](const BulkEdge& a, const BulkEdge& b)
+            {
+                if (a.e != b.e)
+                    return a.e < b.e;
+                if (a.labeled != b.labeled)
+                    return a.labeled;
+                return a.pos < b.pos;
+            });
+        recs.erase(std::unique(recs.begin(), recs.end(),
+                       [](const BulkEdge& a, const BulkEdge& b)
+                       {
+                           return a.e == b.e;
+                       }),
+                   recs.end());
+
+        std::vector<Edge> edges;
+        edges.reserve(recs.size());
+        for (const BulkEdge& r : recs)
+            edges.push_back(r.e);
+
+        EdgeLblUGraph g;
+        g.buildFromSortedEdges(edges, threadsNum);
+
+        g._edgeLabeling.reserve(recs.size());
+        for (const BulkEdge& r : recs)
+        {
+            if (r.labeled)
+                g._edgeLabeling.insert(g.getVertexId(r.e.first),
+                                       g.getVertexId(r.e.second), r.lbl);
+        }
+
+        return g;
+    }
+
     // Graph structure modifying methods.
 
     /// \brief Adds into this graph a new edge made of two vertices and label it.
@@ -52,10 +157,109 @@ public:
     /// the current call of the function UPDATES the associated label.
     Edge addLblEdge(Vertex s, Vertex d, EdgeLbl lbl)
     {
-        Edge e = Base::addEdge(s, d);
-        _edgeLabeling.insert({e, lbl});
+        // listeners are notified when the label is in place
+        UInt si, di;
+        bool added = Base::addEdgeIntrn(s, d, si, di);
+        if (!added)
+        {
+            si = Base::getVertexId(s);
+            di = Base::getVertexId(d);
+        }
 
-        return e;
+        bool labeled = _edgeLabeling.insert(si, di, lbl);
+        if (added)
+            Base::_listeners.notify([si, di](UGraphListener* l)
+                                    { l->onEdgeAdded(si, di); });
+        else if (labeled)
+            Base::_listeners.notify([si, di](UGraphListener* l)
+                                    { l->onEdgeLabelChanged(si, di); });
+
+        return Base::makeNormalizedEdge(s, d);
+    }
+
+    /// Sets the label of the existing edge {s, d} to \a lbl, replacing the
+    /// old one if any. Returns false if there is no such edge.
+    bool setLabel(Vertex s, Vertex d, EdgeLbl lbl)
+    {
+        if (!Base::isEdgeExists(s, d))
+            return false;
+
+        UInt si = Base::getVertexId(s);
+        UInt di = Base::getVertexId(d);
+        _edgeLabeling.assign(si, di, lbl);
+        Base::_listeners.notify([si, di](UGraphListener* l)
+                                { l->onEdgeLabelChanged(si, di); });
+
+        return true;
+    }
+
+    /// Removes the edge {s, d} with its label. See UGraph::removeEdge().
+    bool removeEdge(Vertex s, Vertex d)
+    {
+        UInt si, di;
+        if (!Base::removeEdgeIntrn(s, d, si, di))
+            return false;
+
+        _edgeLabeling.erase(si, di);
+        Base::_listeners.notify([si, di](UGraphListener* l)
+                                { l->onEdgeRemoved(si, di); });
+        return true;
+    }
+
+    /// Removes the vertex \a v with all its edges and their labels. Labels of
+    /// the vertex taking the ID of \a v are rekeyed unless the tombstone mode
+    /// is on. See UGraph::removeVertex().
+    bool removeVertex(Vertex v)
+    {
+        if (!Base::isVertexExists(v))
+            return false;
+
+        for (const Vertex& n : Base::getNeighbours(v))
+            removeEdge(v, n);
+
+        if (Base::makeTombstoneIntrn(v))
+            return true;
+
+        std::pair<UInt, UInt> ids = Base::removeIsolatedVertexIntrn(v);
+        if (ids.first != ids.second)
+        {
+            Vertex moved = Base::getVertexById(ids.first);
+            for (const Vertex& n : Base::getNeighbours(moved))
+            {
+                // a self-loop is rekeyed by its first half
+                UInt ni = Base::getVertexId(n);
+                UInt oldNi = (ni == ids.first) ? ids.second : ni;
+                EdgeLbl lbl;
+                if (_edgeLabeling.find(ids.second, oldNi, lbl))
+                {
+                    _edgeLabeling.erase(ids.second, oldNi);
+                    _edgeLabeling.insert(ids.first, ni, lbl);
+                }
+            }
+        }
+
+        Base::notifyVertexRemoved(ids);
+        return true;
+    }
+
+    /// Drops tombstones and rebuilds the storage, labels are rekeyed by new
+    /// IDs into a table of a fitting size. See UGraph::compact().
+    void compact()
+    {
+        std::vector<UInt> newIds = Base::compactIntrn();
+
+        EdgeLabelHashMap<EdgeLbl> labeling;
+        labeling.reserve(_edgeLabeling.getSize());
+        _edgeLabeling.forEach([&](UInt s, UInt d, const EdgeLbl& lbl)
+        {
+            if (newIds.empty())
+                labeling.insert(s, d, lbl);
+            else
+                labeling.insert(newIds[s], newIds[d], lbl);
+        });
+        _edgeLabeling = std::move(labeling);
+
+        Base::notifyCompacted(newIds);
     }
 
     /// For a given edge \a e tries to find an associated label and returns it
@@ -67,15 +271,24 @@ public:
     //bool getLabel(const Edge& e, EdgeLbl& lbl) const
     bool getLabel(Vertex s, Vertex d, EdgeLbl& lbl) const
     {
-        Edge e = Base::makeNormalizedEdge(s, d);
-        EdgeLabelingCIter it = _edgeLabeling.find(e);
-        if(it != _edgeLabeling.end())
-        {
-            lbl = it->second;
-            return true;
-        }
+        UInt si, di;
+        if (!Base::findVertexId(s, si) || !Base::findVertexId(d, di))
+            return false;
+
+        return _edgeLabeling.find(si, di, lbl);
+    }
 
-        return false;
+    /// The same as getLabel() for the edge given by IDs of its ends.
+    bool getLabelById(UInt si, UInt di, EdgeLbl& lbl) const
+    {
+        return _edgeLabeling.find(si, di, lbl);
+    }
+
+    /// Returns the label of the edge an adjacency iterator \a it (obtained by
+    /// getAdjEdges()) points to, if any.
+    bool getAdjLabel(const AdjListCIter& it, EdgeLbl& lbl) const
+    {
+        return getLabel(it->first, it->second, lbl);
     }
 
 protected:
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains a read-only memory-mapped file.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+/*! ****************************************************************************
+ *  \brief Read-only file mapped into memory.
+ *
+ *  Uses mmap() where available; elsewhere reads the file into memory, so
+ *  loading works the same way, though not without copying.
+ ******************************************************************************/
+class MappedFile {
+public:
+    /// Maps the file \a fn. Throws std::invalid_argument if it fails.
+    explicit MappedFile(const std::string& fn)
+    {
+#ifdef MAPPED_FILE_USE_MMAP
+        int fd = ::open(fn.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::invalid_argument("Can't open file");
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::invalid_argument("Can't get file size");
+        }
+
+        _size = size_t(st.st_size);
+        if (_size != 0)
+        {
+            void* p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::invalid_argument("Can't map file");
+            }
+            _data = static_cast<const char*>(p);
+        }
+        ::close(fd);                // the mapping stays valid
+#else
+        std::ifstream f(fn.c_str(), std::ios::binary);
+        if (!f.is_open())
+            throw std::invalid_argument("Can't open file");
+
+        _buf.assign(std::istreambuf_iterator<char>(f),
+                    std::istreambuf_iterator<char>());
+        _data = _buf.data();
+        _size = _buf.size();
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifdef MAPPED_FILE_USE_MMAP
+        if (_data)
+            ::munmap(const_cast<char*>(_data), _size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* getData() const { return _data; }
+    size_t getSize() const { return _size; }
+
+protected:
+    const char* _data = nullptr;
+    size_t _size = 0;
+#ifndef MAPPED_FILE_USE_MMAP
+    std::vector<char> _buf;
+#endif
+}; // class MappedFile
+
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of the pool of small memory blocks for
+///             nodes of tree-based containers and the allocator using it.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       23.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+
+/*! ****************************************************************************
+ *  \brief Pool of small memory blocks carved out of big chunks.
+ *
+ *  Blocks are rounded up to size classes of ALIGNMENT bytes. A freed block goes
+ *  to the free list of its class and is reused first; new blocks are cut from
+ *  the current chunk one after another, so nodes allocated in a row lie close
+ *  in memory. Chunks grow twice up to MAX_CHUNK_SIZE and are returned to the
+ *  system only when the pool is destroyed, at one stroke. Blocks larger than
+ *  MAX_BLOCK_SIZE (e.g. bucket arrays of hash maps) go directly to the global
+ *  operator new.
+ *
+ *  The pool is not thread-safe.
+ ******************************************************************************/
+class NodePool {
+public:
+    /// Alignment and granularity of blocks.
+    static const size_t ALIGNMENT = alignof(std::max_align_t);
+
+    /// The largest size of blocks taken from chunks.
+    static const size_t MAX_BLOCK_SIZE = 256;
+
+    /// Sizes of the first and of the largest chunks.
+    static const size_t MIN_CHUNK_SIZE = 64 * 1024;
+    static const size_t MAX_CHUNK_SIZE = 16 * 1024 * 1024;
+
+public:
+    NodePool()
+        : _freeLists(MAX_BLOCK_SIZE / ALIGNMENT, nullptr)
+    {
+    }
+
+    ~NodePool()
+    {
+        for (void* c : _chunks)
+            ::operator delete(c);
+    }
+
+    // blocks belong to the pool object
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+public:
+    /// Returns a block of \a size bytes.
+    void* allocate(size_t size)
+    {
+        if (size > MAX_BLOCK_SIZE)
+            return ::operator new(size);
+
+        size_t cls = getClass(size);
+        if (_freeLists[cls])
+        {
+            FreeBlock* b = _freeLists[cls];
+            _freeLists[cls] = b->next;
+            return b;
+        }
+
+        size_t bytes = (cls + 1) * ALIGNMENT;
+        if (size_t(_end - _cur) < bytes)
+            addChunk();
+
+        void* p = _cur;
+        _cur += bytes;
+        return p;
+    }
+
+    /// Takes back the block \a p of \a size bytes.
+    void deallocate(void* p, size_t size)
+    {
+        if (size > MAX_BLOCK_SIZE)
+        {
+            ::operator delete(p);
+            return;
+        }
+
+        size_t cls = getClass(size);
+        FreeBlock* b = static_cast<FreeBlock*>(p);
+        b->next = _freeLists[cls];
+        _freeLists[cls] = b;
+    }
+
+    /// Returns the number of chunks.
+    size_t getChunksNum() const { return _chunks.size(); }
+
+    /// Returns the number of bytes taken from the system for chunks.
+    size_t getReservedBytes() const { return _reserved; }
+
+protected:
+    /// Header of a free block.
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /// Returns the index of the size class of \a size bytes.
+    static size_t getClass(size_t size)
+    {
+        return size == 0 ? 0 : (size - 1) / ALIGNMENT;
+    }
+
+    /// Starts a new chunk; the rest of the current one is left unused.
+    void addChunk()
+    {
+        size_t size = _chunks.empty() ? MIN_CHUNK_SIZE
+                                      : _chunkSize * 2;
+        if (size > MAX_CHUNK_SIZE)
+            size = MAX_CHUNK_SIZE;
+
+        _chunks.reserve(_chunks.size() + 1);
+        _cur = static_cast<char*>(::operator new(size));
+        _chunks.push_back(_cur);
+        _end = _cur + size;
+        _chunkSize = size;
+        _reserved += size;
+    }
+
+protected:
+    std::vector<FreeBlock*> _freeLists;     ///< Free blocks by size classes.
+    std::vector<void*> _chunks;             ///< Chunks to be freed.
+    char* _cur = nullptr;                   ///< Free part of the last chunk.
+    char* _end = nullptr;                   ///< End of the last chunk.
+    size_t _chunkSize = 0;                  ///< Size of the last chunk.
+    size_t _reserved = 0;                   ///< Total size of chunks.
+}; // class NodePool
+
+
+/*! ****************************************************************************
+ *  \brief Allocator taking memory from a shared NodePool.
+ *
+ *  \tparam T is the type of allocated objects; its alignment must not exceed
+ *  NodePool::ALIGNMENT.
+ *
+ *  A default-constructed allocator creates a pool of its own, and the pool
+ *  lives while any allocator or container sharing it does. So a container
+ *  (or a graph, see UGraph) constructed with a default allocator keeps all
+ *  its nodes in a private pool, and freeing them is cheap. A copy of a
+ *  container gets a new pool, while moves and swaps carry the pool along
+ *  (a moved-from container keeps sharing it and stays usable).
+ *  Pass a shared pool explicitly to keep several containers in one.
+ ******************************************************************************/
+template <typename T>
+class PoolAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    static_assert(alignof(T) <= NodePool::ALIGNMENT,
+                  "Type is overaligned for NodePool");
+
+public:
+    PoolAllocator()
+        : _pool(std::make_shared<NodePool>())
+    {
+    }
+
+    /// Makes an allocator using the pool \a pool.
+    explicit PoolAllocator(std::shared_ptr<NodePool> pool)
+        : _pool(std::move(pool))
+    {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other)
+        : _pool(other.getPool())
+    {
+    }
+
+    PoolAllocator(const PoolAllocator&) = default;
+    PoolAllocator& operator=(const PoolAllocator&) = default;
+
+    // containers move their allocators along with nodes, so a moved-from
+    // allocator must still refer to the pool for the container to be reused
+    PoolAllocator(PoolAllocator&& other)
+        : _pool(other._pool)
+    {
+    }
+
+    PoolAllocator& operator=(PoolAllocator&& other)
+    {
+        _pool = other._pool;
+        return *this;
+    }
+
+public:
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(_pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        _pool->deallocate(p, n * sizeof(T));
+    }
+
+    /// Copies of containers do not share pools with the originals.
+    PoolAllocator select_on_container_copy_construction() const
+    {
+        return PoolAllocator();
+    }
+
+    /// Returns the pool.
+    const std::shared_ptr<NodePool>& getPool() const { return _pool; }
+
+protected:
+    std::shared_ptr<NodePool> _pool;        ///< Source of memory.
+}; // class PoolAllocator
+
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b)
+{
+    return a.getPool() == b.getPool();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+
+#endif // NODE_POOL_HPP
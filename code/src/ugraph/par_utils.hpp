@@ -0,0 +1,334 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains helpers for running loops on several threads.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef PAR_UTILS_HPP
+#define PAR_UTILS_HPP
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+
+/// Returns the number of threads to use if \a threadsNum is 0 (which means
+/// “as many as the hardware supports”), otherwise \a threadsNum itself.
+inline unsigned int getThreadsNum(unsigned int threadsNum = 0)
+{
+    if (threadsNum != 0)
+        return threadsNum;
+
+    unsigned int hw = std::thread::hardware_concurrency();
+    return (hw != 0) ? hw : 1;
+}
+
+
+/// Splits the semirange [\a begin, \a end) into \a threadsNum contiguous
+/// chunks of nearly equal size and calls fn(chunkBegin, chunkEnd, threadIdx)
+/// for each of them on its own thread. The calling thread processes the first
+/// chunk itself and then waits for all others.
+///
+/// If \a threadsNum is 0, the hardware concurrency is used. As in ThreadTeam,
+/// the first exception thrown by \a fn on any thread (or by starting a thread)
+/// is rethrown after all started threads have been joined.
+template <typename Fn>
+void parallelFor(size_t begin, size_t end, unsigned int threadsNum, Fn fn)
+{
+    threadsNum = getThreadsNum(threadsNum);
+    size_t n = (end > begin) ? end - begin : 0;
+    if (threadsNum > n)
+        threadsNum = (n > 0) ? unsigned(n) : 1;
+
+    if (threadsNum == 1)
+    {
+        fn(begin, end, 0u);
+        return;
+    }
+
+    size_t chunk = n / threadsNum;
+    size_t rest = n % threadsNum;
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto keepError = [&]()
+    {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+            error = std::current_exception();
+    };
+
+    // every thread gets its own copy of fn, as std::thread would make
+    auto runChunk = [&](Fn f, size_t b, size_t e, unsigned int t)
+    {
+        try
+        {
+            f(b, e, t);
+        }
+        catch (...)
+        {
+            keepError();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    try
+    {
+        workers.reserve(threadsNum - 1);
+
+        // the first chunk is left for the calling thread
+        size_t firstEnd = begin + chunk + (rest > 0 ? 1 : 0);
+        size_t cur = firstEnd;
+        for (unsigned int t = 1; t < threadsNum; ++t)
+        {
+            size_t len = chunk + (t < rest ? 1 : 0);
+            workers.emplace_back(runChunk, fn, cur, cur + len, t);
+            cur += len;
+        }
+
+        runChunk(fn, begin, firstEnd, 0u);
+    }
+    catch (...)
+    {
+        // a thread could not be started, the rest of chunks are skipped
+        keepError();
+    }
+
+    for (std::thread& w : workers)
+        w.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+
+/// Calls fn(block, threadIdx) for each block 0, 1, ..., \a blocksNum - 1 on
+/// \a threadsNum threads (0 means all available cores). Blocks are handed out
+/// one at a time, so uneven blocks do not leave threads idle.
+template <typename Fn>
+void parallelForBlocks(size_t blocksNum, unsigned int threadsNum, Fn fn)
+{
+    std::atomic<size_t> next(0);
+    parallelFor(0, getThreadsNum(threadsNum), threadsNum,
+        [&](size_t, size_t, unsigned int tid)
+        {
+            for (size_t b = next++; b < blocksNum; b = next++)
+                fn(b, tid);
+        });
+}
+
+
+/// Sorts the semirange [\a first, \a last) using \a threadsNum threads
+/// (0 means all available cores) and the comparator \a comp.
+///
+/// The range is split into chunks sorted in parallel, then neighbouring chunks
+/// are merged pairwise, also in parallel, until one chunk remains.
+template <typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, unsigned int threadsNum,
+                  Compare comp)
+{
+    threadsNum = getThreadsNum(threadsNum);
+    size_t n = size_t(last - first);
+    if (threadsNum == 1 || n < 2 * size_t(threadsNum))
+    {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    // bounds of chunks sorted by individual threads
+    std::vector<size_t> bounds(threadsNum + 1);
+    for (unsigned int t = 0; t <= threadsNum; ++t)
+        bounds[t] = n * t / threadsNum;
+
+    parallelFor(0, threadsNum, threadsNum,
+        [&](size_t beg, size_t end, unsigned int)
+        {
+            for (size_t c = beg; c < end; ++c)
+                std::sort(first + bounds[c], first + bounds[c + 1], comp);
+        });
+
+    // merges pairs of neighbouring chunks until one chunk remains
+    while (bounds.size() > 2)
+    {
+        size_t pairsNum = (bounds.size() - 1) / 2;
+        parallelFor(0, pairsNum, threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t p = beg; p < end; ++p)
+                    std::inplace_merge(first + bounds[2 * p],
+                                       first + bounds[2 * p + 1],
+                                       first + bounds[2 * p + 2], comp);
+            });
+
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            merged.push_back(bounds[i]);
+        if (merged.back() != bounds.back())
+            merged.push_back(bounds.back());
+        bounds.swap(merged);
+    }
+}
+
+
+/*! ****************************************************************************
+ *  \brief Team of worker threads for algorithms made of many short parallel
+ *  steps, where starting threads for every step (as parallelFor() does) would
+ *  cost more than the step itself.
+ *
+ *  The threads are started once and sleep between steps. The calling thread
+ *  takes part in each step as the thread 0. The first exception thrown by a
+ *  step function on any thread is rethrown by run() after all threads finish.
+ ******************************************************************************/
+class ThreadTeam {
+public:
+    /// Starts \a threadsNum - 1 workers (0 means all available cores).
+    explicit ThreadTeam(unsigned int threadsNum = 0)
+        : _threadsNum(::getThreadsNum(threadsNum))
+    {
+        // if a thread fails to start, the ones started are stopped, as
+        // joinable threads must not be destroyed
+        _workers.reserve(_threadsNum - 1);
+        try
+        {
+            for (unsigned int t = 1; t < _threadsNum; ++t)
+                _workers.emplace_back(&ThreadTeam::workerLoop, this, t);
+        }
+        catch (...)
+        {
+            stopWorkers();
+            throw;
+        }
+    }
+
+    ThreadTeam(const ThreadTeam&) = delete;
+    ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+    ~ThreadTeam()
+    {
+        stopWorkers();
+    }
+
+    /// Returns the number of threads including the calling one.
+    unsigned int getThreadsNum() const { return _threadsNum; }
+
+    /// Calls fn(threadIdx) on every thread of the team and waits for all.
+    void run(std::function<void(unsigned int)> fn)
+    {
+        if (_threadsNum == 1)
+        {
+            fn(0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = std::move(fn);
+            _pending = _threadsNum - 1;
+            _error = nullptr;
+            ++_generation;
+        }
+        _startCv.notify_all();
+
+        runTask(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _doneCv.wait(lock, [this] { return _pending == 0; });
+        _task = nullptr;
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+
+    /// Calls fn(block, threadIdx) for each block 0, 1, ..., \a blocksNum - 1,
+    /// handing blocks out one at a time as parallelForBlocks() does.
+    template <typename Fn>
+    void runBlocks(size_t blocksNum, Fn fn)
+    {
+        std::atomic<size_t> next(0);
+        run([&](unsigned int tid)
+            {
+                for (size_t b = next++; b < blocksNum; b = next++)
+                    fn(b, tid);
+            });
+    }
+
+protected:
+    /// Makes the workers quit and waits for them.
+    void stopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _startCv.notify_all();
+        for (std::thread& w : _workers)
+            w.join();
+    }
+
+    /// Runs the current task on the thread \a tid, keeping its exception.
+    void runTask(unsigned int tid)
+    {
+        try
+        {
+            _task(tid);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_error)
+                _error = std::current_exception();
+        }
+    }
+
+    /// Waits for tasks and runs them until the team is destroyed.
+    void workerLoop(unsigned int tid)
+    {
+        size_t seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _startCv.wait(lock, [&] { return _stop || _generation != seen; });
+                if (_stop)
+                    return;
+                seen = _generation;
+            }
+
+            runTask(tid);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_pending == 0)
+                _doneCv.notify_one();
+        }
+    }
+
+protected:
+    unsigned int _threadsNum;                   ///< Threads including caller.
+    std::vector<std::thread> _workers;          ///< Threads 1, 2, ...
+    std::mutex _mutex;                          ///< Guards the fields below.
+    std::condition_variable _startCv;           ///< Signals a new task.
+    std::condition_variable _doneCv;            ///< Signals the task's end.
+    std::function<void(unsigned int)> _task;    ///< Current task.
+    size_t _generation = 0;                     ///< Number of started tasks.
+    unsigned int _pending = 0;                  ///< Workers still running.
+    bool _stop = false;                         ///< Makes workers quit.
+    std::exception_ptr _error;                  ///< First exception of a task.
+}; // class ThreadTeam
+
+
+#endif // PAR_UTILS_HPP
@@ -20,8 +20,94 @@
 
 #include <set>
 #include <map>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <memory>
 //#include <cstddef> // size_t
 
+#include "vertex_ids.hpp"
+#include "par_utils.hpp"
+
+
+
+/*! ****************************************************************************
+ *  \brief Interface of objects observing modifications of a graph, such as
+ *  indices kept up to date with it (see UGraph::addListener()).
+ *
+ *  Vertices are passed by their dense IDs. Callbacks do nothing by default.
+ ******************************************************************************/
+class UGraphListener {
+public:
+    typedef unsigned int UInt;
+
+public:
+    virtual ~UGraphListener() {}
+
+    /// Called after a new vertex with the ID \a id has been added.
+    virtual void onVertexAdded(UInt /*id*/) {}
+
+    /// Called after a new edge {si, di} has been added.
+    virtual void onEdgeAdded(UInt /*si*/, UInt /*di*/) {}
+
+    /// Called after the edge {si, di} has been removed.
+    virtual void onEdgeRemoved(UInt /*si*/, UInt /*di*/) {}
+
+    /// Called after the vertex with the ID \a id, having no edges by then,
+    /// has been removed. To keep IDs dense, the vertex with the last ID
+    /// \a movedId has got the ID \a id, unless they are equal.
+    virtual void onVertexRemoved(UInt /*id*/, UInt /*movedId*/) {}
+
+    /// Called by labeled graphs after the label of the existing edge {si, di}
+    /// has been set or changed.
+    virtual void onEdgeLabelChanged(UInt /*si*/, UInt /*di*/) {}
+
+    /// Called after compact() has dropped tombstones and renumbered vertices:
+    /// \a newIds maps old IDs to new ones, VertexIdMap::NO_ID for tombstones.
+    virtual void onCompacted(const std::vector<UInt>& /*newIds*/) {}
+}; // class UGraphListener
+
+
+/*! ****************************************************************************
+ *  \brief List of listeners attached to a graph.
+ *
+ *  Listeners observe a particular graph object, so a copy of the list is
+ *  always empty: copied or moved graphs start without listeners.
+ ******************************************************************************/
+class UGraphListeners {
+public:
+    UGraphListeners() {}
+    UGraphListeners(const UGraphListeners&) {}
+    UGraphListeners& operator=(const UGraphListeners&) { return *this; }
+
+    /// Adds the listener \a l if it has not been added yet.
+    void add(UGraphListener* l)
+    {
+        if (std::find(_items.begin(), _items.end(), l) == _items.end())
+            _items.push_back(l);
+    }
+
+    /// Removes the listener \a l.
+    void remove(UGraphListener* l)
+    {
+        _items.erase(std::remove(_items.begin(), _items.end(), l), _items.end());
+    }
+
+    /// Calls fn(listener) for all listeners in order of their addition.
+    template <typename Fn>
+    void notify(Fn fn) const
+    {
+        for (UGraphListener* l : _items)
+            fn(l);
+    }
+
+protected:
+    std::vector<UGraphListener*> _items;    ///< Listeners.
+}; // class UGraphListeners
+
 
 
 /*! ****************************************************************************
@@ -29,16 +115,37 @@
  *
  *  \tparam Vertex represents a type for vertices. Will be used as a node ID by
  *  copy, so choose it cleverly. Must be comparable.
+ *  \tparam Alloc is the allocator (rebound as needed) for nodes of the vertex
+ *  set, of the adjacency list and of the map of IDs. With PoolAllocator, a
+ *  graph keeps its nodes in a NodePool, so they lie close in memory and are
+ *  freed at one stroke.
+ *
+ *  Each vertex is also given a dense ID (0, 1, 2, ... in order of addition),
+ *  so algorithms can keep per-vertex data in vectors rather than in maps.
+ *
+ *  For high-degree vertices (hubs) the graph keeps an additional hash map from
+ *  neighbours' IDs to the half-edges, so checking an edge existence (and thus
+ *  adding an edge) and removing an edge do not scan the whole adjacency range
+ *  of a hub. Removing a vertex therefore takes O(deg) half-edge erasures.
+ *
+ *  Removed vertices give their IDs to the vertex with the last ID, unless the
+ *  tombstone mode is on: then the ID of a removed vertex stays reserved (a
+ *  tombstone) until compact(), so IDs of other vertices do not change.
  ******************************************************************************/
-template <typename Vertex>
+template <typename Vertex, typename Alloc = std::allocator<Vertex>>
 class UGraph {
 public:
     // type definitions
 
+    typedef unsigned int UInt;
+
     typedef std::pair<Vertex, Vertex> Edge;
 
+    /// Allocator of nodes.
+    typedef Alloc Allocator;
+
     /// Set of vertices.
-    typedef std::set<Vertex> VerticesSet;
+    typedef std::set<Vertex, std::less<Vertex>, Alloc> VerticesSet;
 
     /// Iterator type for vertices.
     typedef typename VerticesSet::iterator VertexIter;
@@ -46,6 +153,10 @@ public:
     /// Pair of vertex iterators.
     typedef std::pair<VertexIter, VertexIter> VertexIterPair;
 
+    /// Mapping vertices to their dense IDs.
+    typedef VertexIdMap<Vertex,
+                typename DefaultVertexIdMap<Vertex, Alloc>::Type> VertexIds;
+
     // TODO: there need to define const iterator types.
 
     // Edge Iterators must be defined customly!
@@ -55,7 +166,9 @@ public:
     ///
     /// Consists of exactly twice more elements than the number of edges in a
     /// graph (think of why).
-    typedef std::multimap<Vertex, Vertex> AdjList;
+    typedef std::multimap<Vertex, Vertex, std::less<Vertex>,
+                typename std::allocator_traits<Alloc>::template
+                    rebind_alloc<std::pair<const Vertex, Vertex>>> AdjList;
     typedef typename AdjList::iterator AdjListIter;
     typedef typename AdjList::const_iterator AdjListCIter;
     typedef std::pair<AdjListCIter, AdjListCIter> AdjListCIterPair;
@@ -173,6 +286,64 @@ public:
     /// Pair of edge iterators.
     typedef std::pair<EdgeIter, EdgeIter> EdgeIterPair;
 
+    /// Half-edges of a hub by neighbours' IDs; for a self-loop, its first half.
+    typedef std::unordered_map<UInt, AdjListCIter> HubNeighbours;
+
+    /// Neighbours of hub vertices, by hub ID.
+    typedef std::unordered_map<UInt, HubNeighbours> HubIndex;
+
+    /// Default degree starting from which a vertex is indexed as a hub.
+    static const UInt DEF_HUB_THRESHOLD = 64;
+
+
+public:
+    UGraph()
+        : UGraph(Alloc())
+    {
+    }
+
+    /// Makes an empty graph allocating its nodes by \a alloc.
+    explicit UGraph(const Alloc& alloc)
+        : _vertices(alloc)
+        , _edges(alloc)
+        , _vertexIds(alloc)
+    {
+    }
+
+    /// Copies the graph; the hub index is rebuilt since it refers to nodes of
+    /// the adjacency list. Listeners are not copied.
+    UGraph(const UGraph& other)
+        : UGraph(std::allocator_traits<Alloc>::
+                     select_on_container_copy_construction(
+                         other.getAllocator()))
+    {
+        *this = other;
+    }
+
+    /// Copies the graph keeping own listeners.
+    UGraph& operator=(const UGraph& other)
+    {
+        if (this == &other)
+            return *this;
+
+        _vertices = other._vertices;
+        _edges = other._edges;
+        _vertexIds = other._vertexIds;
+        _degrees = other._degrees;
+        _tombstoneMode = other._tombstoneMode;
+        _tombstones = other._tombstones;
+        _tombstonesNum = other._tombstonesNum;
+        setHubThreshold(other._hubThreshold);
+
+        return *this;
+    }
+
+    // moving keeps nodes and so the iterators of the hub index
+    UGraph(UGraph&&) = default;
+    UGraph& operator=(UGraph&&) = default;
+
+    /// Returns the allocator of nodes.
+    Alloc getAllocator() const { return _vertices.get_allocator(); }
 
 public:
     // Helpers
@@ -187,13 +358,63 @@ public:
         return {d, s};
     }
 
+    /// \brief Builds a graph from the semirange [\a first, \a last) of edges.
+    ///
+    /// An element gives the ends of an edge by std::get<0>() and std::get<1>(),
+    /// so both std::pair and std::tuple fit. Edges are sorted (by \a threadsNum
+    /// threads, 0 means all available cores) and deduplicated at once, then the
+    /// storage is filled from the sorted data without searching in trees.
+    /// Unlike addEdge(), vertices get their IDs in ascending order.
+    template <typename EdgeIt>
+    static UGraph fromEdges(EdgeIt first, EdgeIt last,
+                            unsigned int threadsNum = 1)
+    {
+        std::vector<Edge> edges;
+        edges.reserve(size_t(std::distance(first, last)));
+        for (; first != last; ++first)
+            edges.push_back(makeNormalizedEdge(std::get<0>(*first),
+                                               std::get<1>(*first)));
+
+        parallelSort(edges.begin(), edges.end(), threadsNum, std::less<Edge>());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        UGraph g;
+        g.buildFromSortedEdges(edges, threadsNum);
+
+        return g;
+    }
+
+    /// The same as above for the array of \a edgesNum edges.
+    static UGraph fromEdges(const Edge* edges, size_t edgesNum,
+                            unsigned int threadsNum = 1)
+    {
+        return fromEdges(edges, edges + edgesNum, threadsNum);
+    }
+
 
     // Graph structure modifying methods.
 
     /// Adds into this graph a new vertex \a v and returns it by value.
+    ///
+    /// A vertex added again while its tombstone exists gets its old ID back.
     Vertex addVertex(Vertex v)
     {
-        _vertices.insert(v);
+        if (_vertices.insert(v).second)
+        {
+            UInt id = _vertexIds.intern(v);
+            if (id < _degrees.size())
+            {
+                // listeners have seen it as an isolated vertex all the time
+                _tombstones[id] = false;
+                --_tombstonesNum;
+                return v;
+            }
+
+            _degrees.push_back(0);
+            if (_tombstoneMode || !_tombstones.empty())
+                _tombstones.push_back(false);
+            _listeners.notify([id](UGraphListener* l) { l->onVertexAdded(id); });
+        }
         return v;
     }
 
@@ -204,20 +425,87 @@ public:
     /// do nothing else as just return an edge object.
     Edge addEdge(Vertex s, Vertex d)
     {
-        if(!isEdgeExists(s, d))      // need to add
-        {
-            // add two collinear edges
-            _edges.insert({s, d});
-            _edges.insert({d, s});
+        UInt si, di;
+        if (addEdgeIntrn(s, d, si, di))
+            _listeners.notify([si, di](UGraphListener* l)
+                              { l->onEdgeAdded(si, di); });
 
-            // add edges vertices too
-            addVertex(s);
-            addVertex(d);
-        }
-        //Edge e(s, d);
-        Edge e = makeNormalizedEdge(s, d);
+        return makeNormalizedEdge(s, d);
+    }
+
+    /// \brief Removes the edge {s, d} from this graph.
+    /// \return true if the edge has been removed, false if there is no such
+    /// edge.
+    ///
+    /// Ends that are hubs are handled in O(1) besides finding the IDs, others
+    /// in O(deg) < getHubThreshold(). Vertices stay in the graph even if they
+    /// have no more edges.
+    bool removeEdge(Vertex s, Vertex d)
+    {
+        UInt si, di;
+        if (!removeEdgeIntrn(s, d, si, di))
+            return false;
+
+        _listeners.notify([si, di](UGraphListener* l)
+                          { l->onEdgeRemoved(si, di); });
+        return true;
+    }
+
+    /// \brief Removes the vertex \a v with all its edges from this graph.
+    /// \return true if the vertex has been removed, false if there is no such
+    /// vertex.
+    ///
+    /// To keep IDs dense, the vertex having the last ID gets the ID of \a v
+    /// (see UGraphListener::onVertexRemoved()). In the tombstone mode, the ID
+    /// of \a v is kept as a tombstone instead, and listeners see an isolated
+    /// vertex until compact(). Takes O(deg(v)) edge removals.
+    bool removeVertex(Vertex v)
+    {
+        if (!isVertexExists(v))
+            return false;
+
+        // the second half of a self-loop is not found and skipped
+        for (const Vertex& n : getNeighbours(v))
+            removeEdge(v, n);
+
+        if (!makeTombstoneIntrn(v))
+            notifyVertexRemoved(removeIsolatedVertexIntrn(v));
+        return true;
+    }
+
+    /// \brief Switches the tombstone mode on or off.
+    ///
+    /// With many removals and additions, tombstones save renumbering vertices
+    /// (and rekeying data attached to IDs) on every removal. Existing
+    /// tombstones stay until compact().
+    void setTombstoneMode(bool on)
+    {
+        _tombstoneMode = on;
+        if (on)
+            _tombstones.resize(_degrees.size(), false);
+    }
+
+    /// Returns true if the tombstone mode is on.
+    bool isTombstoneMode() const { return _tombstoneMode; }
+
+    /// Returns the number of tombstones.
+    size_t getTombstonesNum() const { return _tombstonesNum; }
+
+    /// Returns true if the ID \a id belongs to a removed vertex.
+    bool isTombstone(UInt id) const
+    {
+        return _tombstonesNum != 0 && _tombstones[id];
+    }
 
-        return e;
+    /// \brief Drops tombstones and rebuilds the storage.
+    ///
+    /// Live vertices are renumbered densely keeping their order, then the tree
+    /// nodes are reallocated in key order and the vectors are shrunk, so long
+    /// running graphs get back compact storage. Listeners are notified by
+    /// UGraphListener::onCompacted() if IDs have changed.
+    void compact()
+    {
+        notifyCompacted(compactIntrn());
     }
 
     /// Method determines whether an edge {s, d} exists in this graph.
@@ -226,8 +514,31 @@ public:
     ///
     /// Graph guarantees that is a vertex {a, b} exists then its counterpart
     /// {b, a} exists too.
+    ///
+    /// If one of the vertices is a hub, takes amortized O(1) besides finding
+    /// the IDs; otherwise scans neighbours of the vertex with smaller degree.
     bool isEdgeExists(Vertex s, Vertex d) const
     {
+        UInt si, di;
+        if (!findVertexId(s, si) || !findVertexId(d, di))
+            return false;
+
+        // looks up in the hash map of a hub, if any
+        auto hub = _hubs.find(si);
+        if (hub != _hubs.end())
+            return hub->second.count(di) != 0;
+
+        hub = _hubs.find(di);
+        if (hub != _hubs.end())
+            return hub->second.count(si) != 0;
+
+        // scans the shorter adjacency range
+        if (_degrees[di] < _degrees[si])
+        {
+            std::swap(s, d);
+            std::swap(si, di);
+        }
+
         auto itlow = _edges.lower_bound(s);
         auto itup = _edges.upper_bound(s);
         for (auto it = itlow; it != itup; ++it)
@@ -239,16 +550,88 @@ public:
         return false;
     }
 
+    /// Returns the degree of the vertex \a v (a self-loop counts twice).
+    UInt getDegree(Vertex v) const
+    {
+        UInt vi;
+        if (!findVertexId(v, vi))
+            return 0;
+
+        return _degrees[vi];
+    }
+
+    /// Returns true if the vertex \a v is indexed as a hub.
+    bool isHub(Vertex v) const
+    {
+        UInt vi;
+        return findVertexId(v, vi) && _hubs.find(vi) != _hubs.end();
+    }
+
+    /// Sets the degree starting from which vertices are indexed as hubs and
+    /// rebuilds the index. UInt(-1) switches the index off.
+    void setHubThreshold(UInt threshold)
+    {
+        _hubThreshold = threshold;
+        _hubs.clear();
+        for (UInt vi = 0; vi < _degrees.size(); ++vi)
+        {
+            if (_degrees[vi] >= _hubThreshold)
+                makeHub(vi);
+        }
+    }
+
+    /// Returns the degree starting from which vertices are indexed as hubs.
+    UInt getHubThreshold() const { return _hubThreshold; }
+
+    /// Attaches the listener \a l, which is then notified of new vertices and
+    /// edges. The listener must be removed before it is destroyed; it is not
+    /// copied along with the graph.
+    void addListener(UGraphListener* l) { _listeners.add(l); }
+
+    /// Detaches the listener \a l.
+    void removeListener(UGraphListener* l) { _listeners.remove(l); }
+
     bool isVertexExists(Vertex v) const
     {
         return (_vertices.find(v) != _vertices.end());
     }
 
+    /// Looks for the ID of the vertex \a v. Returns true and sets \a id if
+    /// the vertex exists, false otherwise.
+    bool findVertexId(Vertex v, UInt& id) const
+    {
+        return _vertexIds.findId(v, id) && !isTombstone(id);
+    }
+
+    /// Returns the ID of the vertex \a v.
+    /// If no such a vertex (or it is a tombstone), throws an exception.
+    UInt getVertexId(Vertex v) const
+    {
+        UInt id = _vertexIds.getId(v);
+        if (isTombstone(id))
+            throw std::invalid_argument("No such vertex");
+
+        return id;
+    }
+
+    /// Returns the vertex having the ID \a id.
+    Vertex getVertexById(UInt id) const { return _vertexIds.getVertex(id); }
+
+    /// Returns the ID of the neighbour an adjacency iterator \a it (obtained
+    /// by getAdjEdges()) points to.
+    UInt getAdjVertexId(const AdjListCIter& it) const
+    {
+        return _vertexIds.getId(it->second);
+    }
+
 
 
 public:
     // setters/getters
-    size_t getVerticesNum() const { return _vertices.size(); }
+
+    /// Returns the number of vertices, including tombstones, so all IDs are
+    /// less than it; tombstones look like isolated vertices to algorithms.
+    size_t getVerticesNum() const { return _degrees.size(); }
     size_t getEdgesNum() const { return _edges.size() / 2; }
 
 
@@ -274,9 +657,308 @@ public:
     }
 
 
+protected:
+    /// Adds the edge {s, d} with its vertices unless it exists, without
+    /// notifying listeners of the edge. Returns true and sets IDs \a si and
+    /// \a di of the ends if the edge is new.
+    bool addEdgeIntrn(Vertex s, Vertex d, UInt& si, UInt& di)
+    {
+        if (isEdgeExists(s, d))
+            return false;
+
+        // add edges vertices too
+        addVertex(s);
+        addVertex(d);
+
+        // add two collinear edges
+        AdjListCIter sd = _edges.insert({s, d});
+        AdjListCIter ds = _edges.insert({d, s});
+
+        si = _vertexIds.getId(s);
+        di = _vertexIds.getId(d);
+        addHalfEdgeToIndex(si, di, sd);
+        addHalfEdgeToIndex(di, si, ds);
+
+        return true;
+    }
+
+    /// Removes the edge {s, d} without notifying listeners. Returns true and
+    /// sets IDs \a si and \a di of the ends if the edge has existed.
+    bool removeEdgeIntrn(Vertex s, Vertex d, UInt& si, UInt& di)
+    {
+        if (!findVertexId(s, si) || !findVertexId(d, di))
+            return false;
+
+        AdjListCIter half = findHalfEdge(s, si, d);
+        if (half == _edges.end())
+            return false;
+
+        // halves of a self-loop are always adjacent
+        if (si == di)
+            _edges.erase(std::next(half));
+        else
+            _edges.erase(findHalfEdge(d, di, s));
+        _edges.erase(half);
+
+        removeHalfEdgeFromIndex(si, di);
+        removeHalfEdgeFromIndex(di, si);
+
+        return true;
+    }
+
+    /// Returns the half-edge (s, d), where \a si is the ID of s, or the end
+    /// of the adjacency list if there is no such one.
+    AdjListCIter findHalfEdge(Vertex s, UInt si, Vertex d) const
+    {
+        auto hub = _hubs.find(si);
+        if (hub != _hubs.end())
+        {
+            UInt di;
+            if (!findVertexId(d, di))
+                return _edges.end();
+
+            auto n = hub->second.find(di);
+            return n == hub->second.end() ? _edges.end() : n->second;
+        }
+
+        auto itup = _edges.upper_bound(s);
+        for (auto it = _edges.lower_bound(s); it != itup; ++it)
+        {
+            if (it->second == d)
+                return it;
+        }
+
+        return _edges.end();
+    }
+
+    /// Makes the vertex \a v having no edges a tombstone if the tombstone mode
+    /// is on. Returns false if the mode is off.
+    bool makeTombstoneIntrn(Vertex v)
+    {
+        if (!_tombstoneMode)
+            return false;
+
+        UInt id = _vertexIds.getId(v);
+        _vertices.erase(v);
+        _hubs.erase(id);
+        _tombstones[id] = true;
+        ++_tombstonesNum;
+
+        return true;
+    }
+
+    /// Removes the vertex \a v having no edges without notifying listeners.
+    /// The vertex with the last ID takes the ID of \a v. Returns the pair
+    /// (ID of \a v, former ID of the moved vertex).
+    std::pair<UInt, UInt> removeIsolatedVertexIntrn(Vertex v)
+    {
+        UInt id = _vertexIds.getId(v);
+        UInt lastId = UInt(_degrees.size() - 1);
+
+        _vertexIds.remove(v);
+        _vertices.erase(v);
+        _hubs.erase(id);
+        _degrees[id] = _degrees[lastId];
+        _degrees.pop_back();
+        if (!_tombstones.empty())
+        {
+            // the moved vertex may be a tombstone itself
+            _tombstones[id] = _tombstones[lastId];
+            _tombstones.pop_back();
+        }
+
+        if (id != lastId)
+        {
+            // the moved vertex is renamed in its own hub index and in the ones
+            // of its neighbours
+            auto hub = _hubs.find(lastId);
+            if (hub != _hubs.end())
+            {
+                HubNeighbours ns;
+                ns.swap(hub->second);
+                _hubs.erase(hub);
+                _hubs[id].swap(ns);
+            }
+
+            AdjListCIterPair adj = getAdjEdges(_vertexIds.getVertex(id));
+            for (auto it = adj.first; it != adj.second; ++it)
+            {
+                auto nhub = _hubs.find(getAdjVertexId(it));
+                if (nhub == _hubs.end())
+                    continue;
+
+                auto n = nhub->second.find(lastId);
+                if (n != nhub->second.end())
+                {
+                    AdjListCIter half = n->second;
+                    nhub->second.erase(n);
+                    nhub->second.emplace(id, half);
+                }
+            }
+        }
+
+        return {id, lastId};
+    }
+
+    /// Drops tombstones and rebuilds the storage without notifying listeners.
+    /// Returns new IDs indexed by old ones if IDs have changed, an empty
+    /// vector otherwise.
+    std::vector<UInt> compactIntrn()
+    {
+        // as for a copy, e.g. a new pool for PoolAllocator, so the old one is
+        // released as a whole
+        Alloc alloc = std::allocator_traits<Alloc>::
+                          select_on_container_copy_construction(getAllocator());
+
+        std::vector<UInt> newIds;
+        if (_tombstonesNum != 0)
+            newIds.assign(_degrees.size(), VertexIds::NO_ID);
+
+        VertexIds ids(alloc);
+        ids.reserve(_vertices.size());
+        std::vector<UInt> degrees;
+        degrees.reserve(_vertices.size());
+        for (UInt id = 0; id < _degrees.size(); ++id)
+        {
+            if (isTombstone(id))
+                continue;
+
+            UInt newId = ids.intern(_vertexIds.getVertex(id));
+            if (!newIds.empty())
+                newIds[id] = newId;
+            degrees.push_back(_degrees[id]);
+        }
+
+        _vertexIds = std::move(ids);
+        _degrees.swap(degrees);
+        std::vector<bool>(_tombstoneMode ? _degrees.size() : 0, false)
+            .swap(_tombstones);
+        _tombstonesNum = 0;
+
+        // copies in key order place neighbouring nodes close in memory
+        AdjList edges(alloc);
+        for (const auto& h : _edges)
+            edges.emplace_hint(edges.end(), h);
+        _edges.swap(edges);
+
+        VerticesSet vertices(_vertices.begin(), _vertices.end(),
+                             std::less<Vertex>(), alloc);
+        _vertices.swap(vertices);
+
+        setHubThreshold(_hubThreshold);
+
+        return newIds;
+    }
+
+    /// Notifies listeners of renumbering by compactIntrn(), if any.
+    void notifyCompacted(const std::vector<UInt>& newIds)
+    {
+        if (!newIds.empty())
+            _listeners.notify([&newIds](UGraphListener* l)
+                              { l->onCompacted(newIds); });
+    }
+
+    /// Notifies listeners of the removal of a vertex, see
+    /// removeIsolatedVertexIntrn().
+    void notifyVertexRemoved(std::pair<UInt, UInt> ids)
+    {
+        _listeners.notify([ids](UGraphListener* l)
+                          { l->onVertexRemoved(ids.first, ids.second); });
+    }
+
+    /// Returns neighbours of the vertex \a v (a self-loop gives \a v twice),
+    /// so edges can be removed while going through them.
+    std::vector<Vertex> getNeighbours(Vertex v) const
+    {
+        std::vector<Vertex> res;
+        AdjListCIterPair adj = getAdjEdges(v);
+        for (auto it = adj.first; it != adj.second; ++it)
+            res.push_back(it->second);
+
+        return res;
+    }
+
+    /// Fills an empty graph with normalized, sorted and unique \a edges.
+    void buildFromSortedEdges(const std::vector<Edge>& edges,
+                              unsigned int threadsNum)
+    {
+        // both halves of each edge, a self-loop gives two equal ones
+        std::vector<Edge> halves;
+        halves.reserve(edges.size() * 2);
+        for (const Edge& e : edges)
+        {
+            halves.push_back(e);
+            halves.push_back({e.second, e.first});
+        }
+        parallelSort(halves.begin(), halves.end(), threadsNum,
+                     std::less<Edge>());
+
+        // sorted keys make each insertion at the end hint take O(1)
+        for (const Edge& h : halves)
+            _edges.emplace_hint(_edges.end(), h);
+
+        // every vertex starts a run of its halves, the run length is its degree
+        _vertexIds.reserve(halves.size());
+        for (size_t i = 0; i < halves.size(); )
+        {
+            size_t j = i + 1;
+            while (j < halves.size() && halves[j].first == halves[i].first)
+                ++j;
+
+            _vertices.emplace_hint(_vertices.end(), halves[i].first);
+            _vertexIds.intern(halves[i].first);
+            _degrees.push_back(UInt(j - i));
+            i = j;
+        }
+
+        setHubThreshold(_hubThreshold);
+    }
+
+    /// Accounts the half-edge (si, di) at \a half in degrees and in the hub
+    /// index.
+    void addHalfEdgeToIndex(UInt si, UInt di, AdjListCIter half)
+    {
+        UInt deg = ++_degrees[si];
+        auto hub = _hubs.find(si);
+        if (hub != _hubs.end())
+            hub->second.emplace(di, half);
+        else if (deg >= _hubThreshold)
+            makeHub(si);
+    }
+
+    /// Removes the half-edge (si, di) from degrees and from the hub index.
+    /// A hub stays indexed until the index is rebuilt.
+    void removeHalfEdgeFromIndex(UInt si, UInt di)
+    {
+        --_degrees[si];
+        auto hub = _hubs.find(si);
+        if (hub != _hubs.end())
+            hub->second.erase(di);
+    }
+
+    /// Builds a hash map of neighbours for the vertex with ID \a vi.
+    void makeHub(UInt vi)
+    {
+        HubNeighbours& ns = _hubs[vi];
+        ns.reserve(_degrees[vi] * 2);
+
+        // emplace() keeps the first half of a self-loop
+        AdjListCIterPair adj = getAdjEdges(_vertexIds.getVertex(vi));
+        for (auto it = adj.first; it != adj.second; ++it)
+            ns.emplace(_vertexIds.getId(it->second), it);
+    }
+
 protected:
     VerticesSet _vertices;      ///< Set of vertices.
     AdjList _edges;             ///< Adjacency list for representing edges.
+    VertexIds _vertexIds;       ///< Dense IDs of vertices.
+    std::vector<UInt> _degrees; ///< Degrees of vertices by IDs.
+    HubIndex _hubs;             ///< Neighbours of hubs.
+    UInt _hubThreshold = DEF_HUB_THRESHOLD; ///< Degree of a hub.
+    UGraphListeners _listeners; ///< Observers of modifications.
+    bool _tombstoneMode = false;        ///< Removal leaves tombstones.
+    std::vector<bool> _tombstones;      ///< Tombstone flags by IDs.
+    size_t _tombstonesNum = 0;          ///< Number of tombstones.
 }; // class UGraph
 
 
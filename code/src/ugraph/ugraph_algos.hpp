@@ -23,9 +23,33 @@
 
 #include <vector>
 #include <algorithm>
+#include <limits>
 
 #include "lbl_ugraph.hpp"
+#include "csr_ugraph.hpp"
+#include "dense_ugraph.hpp"
 #include "disj_set.hpp"
+#include "vertex_heaps.hpp"
+
+
+/// Returns the neighbours of the vertex with ID \a id of the graph \a g by
+/// Graph::getAdjEdgesById(), which frozen graphs provide to avoid looking up
+/// the vertex.
+template<typename Graph>
+auto getAdjEdgesOfId(const Graph& g, unsigned int id, int /*preferred*/)
+    -> decltype(g.getAdjEdgesById(id))
+{
+    return g.getAdjEdgesById(id);
+}
+
+/// Returns the neighbours of the vertex with ID \a id of the graph \a g by
+/// the vertex itself, for graphs without Graph::getAdjEdgesById().
+template<typename Graph>
+typename Graph::AdjListCIterPair
+    getAdjEdgesOfId(const Graph& g, unsigned int id, long /*fallback*/)
+{
+    return g.getAdjEdges(g.getVertexById(id));
+}
 
 
 /*! ****************************************************************************
@@ -38,6 +62,7 @@ template<typename Vertex>
 class VertexPriorityQueue {
 public:
     typedef unsigned int UInt;
+    typedef UInt WeightType;
     //typedef std::pair<UInt, Vertex> WeightedVertex;
     typedef std::pair<Vertex, UInt> VertexWeight;
     //typedef std::set<WeightedVertex> PQSet;
@@ -46,6 +71,12 @@ public:
 
 public:
 
+    /// Does nothing: the queue is node-based. Presents for compatibility with
+    /// indexed heaps.
+    void reserve(size_t /*n*/)
+    {
+    }
+
     /// For the given vertex \a v sets new weight to \a weight.
     /// If no vertex exists, inserts a new pair (v, weight).
     void set(Vertex v, UInt weight)
@@ -105,17 +136,19 @@ public:
         return { wv.second, wv.first };
     }
 
-//    /// Pops the minimum element of the pq.
-//    /// If a queue is empty, throws an exception.
-//    void popMin()
-//    {
-//        if (isEmpty())
-//            throw std::out_of_range("Queue is empty");
+    /// Pops the minimum element of the pq and returns it.
+    /// If a queue is empty, throws an exception.
+    VertexWeight popMin()
+    {
+        if (isEmpty())
+            throw std::out_of_range("Queue is empty");
+
+        auto wv = *(_pqset.begin());
+        _pqset.erase(_pqset.begin());
+        _pqmap.erase(wv.second);
 
-//        auto wv = *(_pqset.begin());
-//        _pqset.erase(_pqset.begin());
-//        _pqmap.erase(wv.second);
-//    }
+        return { wv.second, wv.first };
+    }
 
 
     /// Removes the given vertex \a v.
@@ -161,9 +194,17 @@ protected:
 
 
 /// Finds a MST for the given graph \a g using Prim's algorithm.
-template<typename Vertex, typename EdgeLbl>
-std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
-    findMSTPrim(const EdgeLblUGraph<Vertex, EdgeLbl>& g)
+///
+/// \tparam PQ is a priority queue type over vertex IDs: IndexedDaryHeap (by
+/// default, over the label type, see LabelHeap), IndexedPairingHeap or
+/// VertexPriorityQueue<unsigned int>.
+/// \tparam Graph is a labeled graph type, either EdgeLblUGraph or
+/// CsrEdgeLblUGraph (anything providing their iteration interface).
+///
+/// Usage: findMSTPrim(g) or findMSTPrim<IndexedPairingHeap<>>(g).
+template<typename PQ = ByLabel, typename Graph>
+std::set<typename Graph::Edge>
+    findMSTPrim(const Graph& g)
 {
     // Implement using fast Prim approach
     // For each vertex, need to store the distance from itself to the growing spanning
@@ -171,69 +212,68 @@ std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
 
     // some type aliases
     typedef unsigned int UInt;
-    //typedef std::pair<UInt, Vertex> WeightedVertex;
-    typedef typename VertexPriorityQueue<Vertex>::VertexWeight VertexWeight;
-    typedef EdgeLblUGraph<Vertex, EdgeLbl> Graph;
+    typedef typename Graph::Edge::first_type Vertex;
+    typedef typename Graph::Label EdgeLbl;
+    typedef typename LabelHeap<EdgeLbl, PQ>::Type Heap;
+    typedef typename Heap::WeightType Weight;
+    typedef typename Heap::VertexWeight VertexWeight;
     typedef typename Graph::AdjListCIterPair AdjListCIterPair;
-    typedef std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge> SetOfEdges;
+    typedef std::set<typename Graph::Edge> SetOfEdges;
 
-    typedef DisjointSetForest<Vertex> DisjointSetForestOfVertices;
+    const UInt NO_ID = UInt(-1);
+    const UInt vertsNum = UInt(g.getVerticesNum());
+    std::vector<UInt> previous(vertsNum, NO_ID);
+                                            // stores ID of previous vertex in
+                                            // the way to the current (by ID)
 
-    std::map<Vertex, Vertex> previous;      // stores previous vertex in the way
-                                            // to the current
+    SetOfEdges res;         // resulting set
+    if (vertsNum == 0)
+        return res;
 
     auto vs = g.getVertices();              // gets vertices
-    Vertex initVert = (*vs.first);          // initial vertex
+    UInt initId = g.getVertexId(*vs.first); // initial vertex
 
-    // initialize PQ with vertices
-    VertexPriorityQueue<Vertex> pqVertices;
-    pqVertices.insert(initVert, 0);
+    // initialize PQ with vertices IDs
+    Heap pqVertices;
+    pqVertices.reserve(vertsNum);
+    pqVertices.insert(initId, 0);
 
     // now skip the very first
-    for(auto it = ++(vs.first); it != vs.second; ++it)
+    for (UInt id = 0; id < vertsNum; ++id)
     {
-        pqVertices.insert(*it, UInt(-1));
+        if (id != initId)
+            pqVertices.insert(id, std::numeric_limits<Weight>::max());
     }
 
-    SetOfEdges res;         // resulting set
-
     // iterates all over the vertices with lowest marks
     while(!pqVertices.isEmpty())
     {
-        VertexWeight vw = pqVertices.getMin();
-        Vertex activeVertex = vw.first;
-        AdjListCIterPair neighbors = g.getAdjEdges(activeVertex);
+        // extract current minimum from PQ and add a edge
+        VertexWeight vw = pqVertices.popMin();
+        UInt activeId = vw.first;
+        Vertex activeVertex = g.getVertexById(activeId);
+
+        UInt prevId = previous[activeId];
+        if (prevId != NO_ID)
+            res.insert(Graph::makeNormalizedEdge(g.getVertexById(prevId), activeVertex));
 
+        AdjListCIterPair neighbors = getAdjEdgesOfId(g, activeId, 0);
         for(auto it = neighbors.first; it != neighbors.second; ++it)
         {
-            auto edge = *it;
-            //UInt curWeight = pqVertices.getWeight(edge.second);
-            UInt curWeight;
-            if (pqVertices.getWeight(edge.second, curWeight))   // if not reached
+            UInt nid = g.getAdjVertexId(it);
+            Weight curWeight;
+            if (pqVertices.getWeight(nid, curWeight))   // if not reached
             {
-                int newWeight;
-                g.getLabel(edge.first, edge.second, newWeight);
-                if (curWeight > newWeight)
+                EdgeLbl newWeight;
+                if (!g.getAdjLabel(it, newWeight))
+                    throw std::invalid_argument("Unlabeled edge found");
+                if (curWeight > Weight(newWeight))
                 {
-                    pqVertices.set(edge.second, newWeight);
-                    previous[edge.second] = edge.first;
+                    pqVertices.set(nid, Weight(newWeight));
+                    previous[nid] = activeId;
                 }
             }
-
-            int b = 0;
         }
-
-        // extract current minimum from PQ and add a edge
-        pqVertices.remove(activeVertex);
-
-        auto prevIt = previous.find(activeVertex);
-        if (prevIt != previous.end())
-            res.insert(Graph::makeNormalizedEdge(prevIt->second, activeVertex));
-            //res.insert({*prevIt, vw.first});
-            //
-
-
-        int a = 0;
     }
 
     return res;
@@ -257,25 +297,24 @@ std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
 
 /// Finds a MST for the given graph \a g using Kruskal's algorithm.
 /// Here we consider an efficient implementation with using find-union DS.
-template<typename Vertex, typename EdgeLbl>
-std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
-    findMSTKruskal(const EdgeLblUGraph<Vertex, EdgeLbl>& g)
+///
+/// \tparam Graph is a labeled graph type, see findMSTPrim().
+template<typename Graph>
+std::set<typename Graph::Edge>
+    findMSTKruskal(const Graph& g)
 {
     // type aliases for convenience
-    typedef EdgeLblUGraph<Vertex, EdgeLbl> Graph;
     typedef typename Graph::Edge Edge;
+    typedef typename Edge::first_type Vertex;
+    typedef typename Graph::Label EdgeLbl;
     typedef std::set<Edge> SetOfEdges;
 
-    typedef typename Graph::VertexIterPair VertexIterPair;
-    typedef typename Graph::VertexIter VertexIter;
-
     typedef std::pair<EdgeLbl, Edge> WeightedEdge;
     typedef std::vector<WeightedEdge> WEdgeVector;
 
-    typedef DisjointSetForest<Vertex> DSFVertices;
-    typedef typename DSFVertices::Node DSFNode;
-    typedef std::map<Vertex, DSFNode*> Vertex2DSFNode;
-
+    // sets are identified by vertex IDs
+    typedef FlatDisjointSetForest DSFVertices;
+    typedef typename DSFVertices::Handle DSFHandle;
 
 
     WEdgeVector wedges;
@@ -296,18 +335,9 @@ std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
 
     std::sort(wedges.begin(), wedges.end());
 
-    // create singltones for vertices
+    // create singltones for vertices (handle == vertex ID)
     DSFVertices dsf;                    // disjoint-sets        forest
-    Vertex2DSFNode verts2nodes;         // map vertex to a node in ^^^
-
-    //g.getVertices()
-    VertexIterPair vs = g.getVertices();
-    for (VertexIter it = vs.first; it != vs.second; ++it)
-    {
-        Vertex v = *it;
-        DSFNode* vn = dsf.makeSet(v);
-        verts2nodes.insert({v, vn});
-    }
+    dsf.reserve(g.getVerticesNum());
 
     SetOfEdges res;
 
@@ -316,8 +346,8 @@ std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
     {
         Vertex u = we.second.first;
         Vertex v = we.second.second;
-        DSFNode* un = dsf.find(verts2nodes[u]);
-        DSFNode* vn = dsf.find(verts2nodes[v]);
+        DSFHandle un = dsf.find(g.getVertexId(u));
+        DSFHandle vn = dsf.find(g.getVertexId(v));
         if (un != vn)                    // both ends aren't in the same set
         {
             res.insert(Graph::makeNormalizedEdge(u, v));
@@ -329,4 +359,434 @@ std::set<typename EdgeLblUGraph<Vertex, EdgeLbl>::Edge>
 }
 
 
+/*! ****************************************************************************
+ *  \brief Dijkstra's single-source shortest paths search over a labeled graph
+ *  with non-negative labels, which are edge lengths.
+ *
+ *  \tparam Graph is a labeled graph type, see findMSTPrim().
+ *  \tparam PQ is a priority queue type over vertex IDs, see findMSTPrim();
+ *  its weight type is the type of distances. By default, it is IndexedDaryHeap
+ *  over the label type, see LabelHeap.
+ *
+ *  The search keeps its arrays between runs and resets only the entries
+ *  touched by the previous run, so a run that stops early at a target costs
+ *  time proportional to the explored part of the graph rather than to V.
+ *  Vertices enter the queue when they are reached for the first time, and
+ *  decrease-key is done by PQ::set(), as in Prim's algorithm.
+ ******************************************************************************/
+template<typename Graph,
+         typename PQ = typename LabelHeap<typename Graph::Label>::Type>
+class DijkstraSearch {
+public:
+    typedef unsigned int UInt;
+    typedef typename Graph::Edge::first_type Vertex;
+    typedef typename Graph::Label EdgeLbl;
+    typedef typename PQ::WeightType Weight;
+
+    /// ID meaning “no vertex”.
+    static const UInt NO_ID = UInt(-1);
+
+public:
+    /// Prepares a search over the graph \a g, which must outlive the search
+    /// and must not change while it is used.
+    explicit DijkstraSearch(const Graph& g)
+        : _g(g)
+        , _dist(g.getVerticesNum(), getInfinity())
+        , _prev(g.getVerticesNum(), NO_ID)
+        , _root(g.getVerticesNum(), NO_ID)
+        , _settled(g.getVerticesNum(), 0)
+    {
+        _pq.reserve(g.getVerticesNum());
+    }
+
+    /// Returns the distance of unreached vertices.
+    static Weight getInfinity() { return std::numeric_limits<Weight>::max(); }
+
+    /// Finds shortest paths from the vertex \a source to all vertices.
+    void run(Vertex source)
+    {
+        runMulti(std::vector<Vertex>(1, source));
+    }
+
+    /// Finds a shortest path from the vertex \a source to the vertex
+    /// \a target, stopping as soon as the target is settled.
+    /// Returns true if the target is reachable.
+    ///
+    /// Only the vertices settled before the target get final distances.
+    bool run(Vertex source, Vertex target)
+    {
+        return runMulti(std::vector<Vertex>(1, source), &target);
+    }
+
+    /// Finds shortest paths from the nearest of vertices \a sources to all
+    /// vertices or, if \a target is given, to the target only (see above).
+    /// Returns true if the target, if any, is reachable.
+    bool runMulti(const std::vector<Vertex>& sources,
+                  const Vertex* target = nullptr)
+    {
+        reset();
+
+        UInt targetId = target ? _g.getVertexId(*target) : NO_ID;
+        for (Vertex s : sources)
+        {
+            UInt id = _g.getVertexId(s);
+            if (_root[id] != NO_ID)
+                continue;               // a repeated source
+
+            touch(id, Weight(), NO_ID, id);
+            _pq.set(id, Weight());
+        }
+
+        while (!_pq.isEmpty())
+        {
+            UInt activeId = _pq.popMin().first;
+            _settled[activeId] = 1;
+            if (activeId == targetId)
+                break;
+
+            relaxEdges(activeId);
+        }
+
+        // leaves the queue empty for the next run
+        while (!_pq.isEmpty())
+            _pq.popMin();
+
+        return targetId == NO_ID || _settled[targetId];
+    }
+
+    /// Returns true if the vertex \a v was settled by the last run, i.e. its
+    /// shortest distance is known.
+    bool isReached(Vertex v) const
+    {
+        return _settled[_g.getVertexId(v)] != 0;
+    }
+
+    /// Returns the distance to the vertex \a v found by the last run, or
+    /// getInfinity() if the vertex was not reached.
+    Weight getDistance(Vertex v) const
+    {
+        UInt id = _g.getVertexId(v);
+        return _settled[id] ? _dist[id] : getInfinity();
+    }
+
+    /// Returns the source the vertex \a v is reached from.
+    /// If the vertex was not reached, throws an exception.
+    Vertex getSource(Vertex v) const
+    {
+        UInt id = _g.getVertexId(v);
+        if (!_settled[id])
+            throw std::invalid_argument("Vertex is not reached");
+
+        return _g.getVertexById(_root[id]);
+    }
+
+    /// Returns the vertices of a shortest path from a source to the vertex
+    /// \a v, both ends included, or an empty vector if \a v was not reached.
+    std::vector<Vertex> getPath(Vertex v) const
+    {
+        std::vector<Vertex> path;
+        UInt id = _g.getVertexId(v);
+        if (!_settled[id])
+            return path;
+
+        for (; id != NO_ID; id = _prev[id])
+            path.push_back(_g.getVertexById(id));
+        std::reverse(path.begin(), path.end());
+
+        return path;
+    }
+
+    /// Returns distances found by the last run indexed by vertex IDs; entries
+    /// of vertices that were not settled are undefined.
+    const std::vector<Weight>& getDistances() const { return _dist; }
+
+protected:
+    /// Updates the data of the vertex \a id and remembers it for reset().
+    void touch(UInt id, Weight dist, UInt prev, UInt root)
+    {
+        if (_root[id] == NO_ID)
+            _touched.push_back(id);
+
+        _dist[id] = dist;
+        _prev[id] = prev;
+        _root[id] = root;
+    }
+
+    /// Restores initial values of entries touched by the last run.
+    void reset()
+    {
+        for (UInt id : _touched)
+        {
+            _dist[id] = getInfinity();
+            _prev[id] = NO_ID;
+            _root[id] = NO_ID;
+            _settled[id] = 0;
+        }
+        _touched.clear();
+    }
+
+    /// Relaxes the edges going from the settled vertex \a activeId.
+    void relaxEdges(UInt activeId)
+    {
+        const Weight activeDist = _dist[activeId];
+        auto neighbors = getAdjEdgesOfId(_g, activeId, 0);
+        for (auto it = neighbors.first; it != neighbors.second; ++it)
+        {
+            UInt nid = _g.getAdjVertexId(it);
+            if (_settled[nid])
+                continue;
+
+            EdgeLbl lbl;
+            if (!_g.getAdjLabel(it, lbl))
+                throw std::invalid_argument("Unlabeled edge found");
+            if (lbl < EdgeLbl())
+                throw std::invalid_argument("Negative edge label found");
+
+            // saturates instead of overflowing
+            Weight len = Weight(lbl);
+            Weight newDist = (len > getInfinity() - activeDist)
+                    ? getInfinity() : activeDist + len;
+            if (newDist < _dist[nid])
+            {
+                touch(nid, newDist, activeId, _root[activeId]);
+                _pq.set(nid, newDist);
+            }
+        }
+    }
+
+protected:
+    const Graph& _g;                        ///< Graph to search in.
+    std::vector<Weight> _dist;              ///< Distances by IDs.
+    std::vector<UInt> _prev;                ///< Previous vertices on paths.
+    std::vector<UInt> _root;                ///< Sources of paths.
+    std::vector<unsigned char> _settled;    ///< 1 for settled vertices.
+    std::vector<UInt> _touched;             ///< IDs changed by the last run.
+    PQ _pq;                                 ///< Queue of reached vertices.
+}; // class DijkstraSearch
+
+template<typename Graph, typename PQ>
+const typename DijkstraSearch<Graph, PQ>::UInt
+    DijkstraSearch<Graph, PQ>::NO_ID;
+
+
+/// Finds distances of shortest paths from the vertex \a source to all vertices
+/// of the graph \a g using Dijkstra's algorithm.
+///
+/// Returns distances indexed by vertex IDs, unreachable vertices have the
+/// maximum value of the weight type.
+///
+/// \tparam PQ and \tparam Graph are as for DijkstraSearch; ByLabel stands
+/// for the default PQ.
+///
+/// Usage: findShortestDistances(g, s) or
+/// findShortestDistances<IndexedDaryHeap<double>>(g, s).
+template<typename PQ = ByLabel, typename Graph>
+std::vector<typename LabelHeap<typename Graph::Label, PQ>::Type::WeightType>
+    findShortestDistances(const Graph& g,
+                          typename Graph::Edge::first_type source)
+{
+    DijkstraSearch<Graph, typename LabelHeap<typename Graph::Label, PQ>::Type>
+        search(g);
+    search.run(source);
+    return search.getDistances();
+}
+
+/// Finds distances of shortest paths from the nearest of vertices \a sources
+/// to all vertices of the graph \a g, see above.
+template<typename PQ = ByLabel, typename Graph>
+std::vector<typename LabelHeap<typename Graph::Label, PQ>::Type::WeightType>
+    findShortestDistances(const Graph& g,
+                          const std::vector<typename Graph::Edge::first_type>& sources)
+{
+    DijkstraSearch<Graph, typename LabelHeap<typename Graph::Label, PQ>::Type>
+        search(g);
+    search.runMulti(sources);
+    return search.getDistances();
+}
+
+/// Finds a shortest path from the vertex \a source to the vertex \a target of
+/// the graph \a g using Dijkstra's algorithm with early exit.
+///
+/// Returns vertices of the path, both ends included, or an empty vector if
+/// the target is unreachable. Sets \a dist to the length of the path if given.
+/// To run many queries over the same graph, use DijkstraSearch directly.
+template<typename PQ = ByLabel, typename Graph>
+std::vector<typename Graph::Edge::first_type>
+    findShortestPath(const Graph& g,
+                     typename Graph::Edge::first_type source,
+                     typename Graph::Edge::first_type target,
+                     typename LabelHeap<typename Graph::Label, PQ>::Type::WeightType*
+                         dist = nullptr)
+{
+    DijkstraSearch<Graph, typename LabelHeap<typename Graph::Label, PQ>::Type>
+        search(g);
+    search.run(source, target);
+    if (dist)
+        *dist = search.getDistance(target);
+    return search.getPath(target);
+}
+
+
+/// Counts triangles of the dense graph \a g using \a threads threads (0 means
+/// all available cores).
+///
+/// For each edge {u, v} with u < v, common neighbours w > v are counted by
+/// ANDing the rows of u and v, so every triangle is counted once. Self-loops
+/// are ignored.
+template<typename Vertex>
+size_t countTrianglesDense(const DenseUGraph<Vertex>& g, unsigned int threads = 1)
+{
+    typedef unsigned int UInt;
+
+    const size_t vertsNum = g.getVerticesNum();
+    const size_t wordsNum = g.getWordsPerRow();
+    std::vector<size_t> counts(getThreadsNum(threads), 0);
+
+    // rows are handed out one by one, as the work decreases with u
+    parallelForBlocks(vertsNum, threads,
+        [&](size_t u, unsigned int tid)
+        {
+            const std::uint64_t* ru = g.getRow(UInt(u));
+            size_t cnt = 0;
+            for (size_t v = findNextBit(ru, wordsNum, u + 1, vertsNum);
+                 v < vertsNum; v = findNextBit(ru, wordsNum, v + 1, vertsNum))
+            {
+                const std::uint64_t* rv = g.getRow(UInt(v));
+
+                // the word of v is masked to keep only w > v
+                size_t wi = v / BITSET_WORD_BITS;
+                std::uint64_t above = (v % BITSET_WORD_BITS == BITSET_WORD_BITS - 1)
+                        ? 0 : ~0ULL << (v % BITSET_WORD_BITS + 1);
+                cnt += popcountWord(ru[wi] & rv[wi] & above);
+                cnt += size_t(countOnesAnd(ru + wi + 1, rv + wi + 1,
+                                           wordsNum - wi - 1));
+            }
+            counts[tid] += cnt;
+        });
+
+    size_t res = 0;
+    for (size_t c : counts)
+        res += c;
+    return res;
+}
+
+
+/// Counts triangles of the sparse graph \a g using \a threads threads (0 means
+/// all available cores).
+///
+/// Edges are oriented from the lower-degree end to the higher-degree one, so
+/// every vertex has few outgoing edges, and every triangle is found once by
+/// merging sorted out-lists of the ends of an oriented edge. Self-loops and
+/// multiple edges are ignored.
+///
+/// \tparam Graph is a graph type with dense vertex IDs: UGraph, CsrUGraph,
+/// DenseUGraph or their labeled versions.
+template<typename Graph>
+size_t countTrianglesSparse(const Graph& g, unsigned int threads = 1)
+{
+    typedef unsigned int UInt;
+    typedef std::vector<UInt> IdVector;
+
+    const UInt vertsNum = UInt(g.getVerticesNum());
+
+    // neighbours of every vertex by IDs
+    std::vector<IdVector> adj(vertsNum);
+    auto vs = g.getVertices();
+    for (auto vit = vs.first; vit != vs.second; ++vit)
+    {
+        UInt u = g.getVertexId(*vit);
+        auto ns = g.getAdjEdges(*vit);
+        for (auto it = ns.first; it != ns.second; ++it)
+        {
+            UInt v = g.getAdjVertexId(it);
+            if (v != u)
+                adj[u].push_back(v);
+        }
+    }
+
+    for (IdVector& ns : adj)
+    {
+        std::sort(ns.begin(), ns.end());
+        ns.erase(std::unique(ns.begin(), ns.end()), ns.end());
+    }
+
+    // u precedes v if it has a smaller degree, ties are broken by IDs
+    auto precedes = [&adj](UInt u, UInt v)
+    {
+        return adj[u].size() < adj[v].size()
+               || (adj[u].size() == adj[v].size() && u < v);
+    };
+
+    std::vector<IdVector> out(vertsNum);
+    for (UInt u = 0; u < vertsNum; ++u)
+        for (UInt v : adj[u])
+            if (precedes(u, v))
+                out[u].push_back(v);        // stays sorted
+
+    std::vector<size_t> counts(getThreadsNum(threads), 0);
+    parallelFor(0, vertsNum, threads,
+        [&](size_t beg, size_t end, unsigned int tid)
+        {
+            size_t cnt = 0;
+            for (size_t u = beg; u < end; ++u)
+                for (UInt v : out[u])
+                {
+                    // merges sorted out-lists of u and v
+                    const IdVector& a = out[u];
+                    const IdVector& b = out[v];
+                    size_t i = 0, j = 0;
+                    while (i < a.size() && j < b.size())
+                    {
+                        if (a[i] < b[j])
+                            ++i;
+                        else if (b[j] < a[i])
+                            ++j;
+                        else
+                        {
+                            ++cnt;
+                            ++i;
+                            ++j;
+                        }
+                    }
+                }
+            counts[tid] += cnt;
+        });
+
+    size_t res = 0;
+    for (size_t c : counts)
+        res += c;
+    return res;
+}
+
+
+/// Counts triangles of the graph \a g using \a threads threads (0 means all
+/// available cores).
+///
+/// If the graph is dense enough (see DenseUGraph::isDenseEnough() for the
+/// meaning of \a densityThreshold), it is converted to a bit matrix and
+/// countTrianglesDense() is used, otherwise countTrianglesSparse() is used.
+template<typename Graph>
+size_t countTriangles(const Graph& g, unsigned int threads = 1,
+                      double densityThreshold =
+                            DenseUGraph<int>::DEF_DENSITY_THRESHOLD)
+{
+    typedef typename Graph::Edge::first_type Vertex;
+    typedef DenseUGraph<Vertex> DenseGraph;
+
+    if (DenseGraph::isDenseEnough(g.getVerticesNum(), g.getEdgesNum(),
+                                  densityThreshold))
+        return countTrianglesDense(DenseGraph::fromGraph(g), threads);
+
+    return countTrianglesSparse(g, threads);
+}
+
+/// A dense graph is already a bit matrix, so it needs no conversion.
+template<typename Vertex>
+size_t countTriangles(const DenseUGraph<Vertex>& g, unsigned int threads = 1,
+                      double /*densityThreshold*/ = 0)
+{
+    return countTrianglesDense(g, threads);
+}
+
+
 #endif // UGRAPH_ALGOS_HPP
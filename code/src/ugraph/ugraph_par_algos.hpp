@@ -0,0 +1,856 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains implementations of parallel algorithms for undirected
+///             graphs.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef UGRAPH_PAR_ALGOS_HPP
+#define UGRAPH_PAR_ALGOS_HPP
+
+#include <vector>
+#include <set>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <limits>
+
+#include "ugraph.hpp"
+#include "ugraph_algos.hpp"
+#include "disj_set.hpp"
+#include "conc_disj_set.hpp"
+#include "par_utils.hpp"
+
+
+/// Collects all edges of the graph \a g as pairs of vertex IDs.
+template<typename Graph>
+std::vector<std::pair<unsigned int, unsigned int>> makeIdEdgeList(const Graph& g)
+{
+    typedef unsigned int UInt;
+
+    std::vector<std::pair<UInt, UInt>> res;
+    res.reserve(g.getEdgesNum());
+
+    typename Graph::EdgeIterPair es = g.getEdges();
+    for (; es.first != es.second; ++es.first)
+    {
+        auto e = *es.first;
+        res.push_back({g.getVertexId(e.first), g.getVertexId(e.second)});
+    }
+
+    return res;
+}
+
+
+/// Replaces representatives of vertices in \a labels (vertex IDs, indexed by
+/// vertex IDs) by dense component numbers 0, 1, ..., k - 1 given in order of
+/// the smallest vertex IDs of components.
+inline void renumberComponents(std::vector<unsigned int>& labels)
+{
+    typedef unsigned int UInt;
+
+    const UInt NO_COMP = UInt(-1);
+    std::vector<UInt> comps(labels.size(), NO_COMP);
+    UInt compsNum = 0;
+    for (UInt& l : labels)
+    {
+        UInt& c = comps[l];
+        if (c == NO_COMP)
+            c = compsNum++;
+        l = c;
+    }
+}
+
+/// Finds connected components of the graph \a g using \a threadsNum threads
+/// (0 means all available cores).
+///
+/// Edges are merged into a ConcurrentDisjointSetForest by all threads at once.
+///
+/// \return A vector indexed by vertex IDs, whose elements are numbers of
+/// components 0, 1, ..., k - 1. Components are numbered in order of their
+/// smallest vertex IDs.
+template<typename Graph>
+std::vector<unsigned int> connectedComponents(const Graph& g,
+                                              unsigned int threadsNum = 0)
+{
+    typedef unsigned int UInt;
+    typedef std::pair<UInt, UInt> IdEdge;
+
+    const UInt vertsNum = UInt(g.getVerticesNum());
+    std::vector<IdEdge> edges = makeIdEdgeList(g);
+
+    ConcurrentDisjointSetForest dsf(vertsNum);
+    parallelFor(0, edges.size(), threadsNum,
+        [&](size_t beg, size_t end, unsigned int)
+        {
+            for (size_t i = beg; i < end; ++i)
+                dsf.merge(edges[i].first, edges[i].second);
+        });
+
+    // representatives are found in parallel, as the forest is complete now
+    std::vector<UInt> res(vertsNum);
+    parallelFor(0, vertsNum, threadsNum,
+        [&](size_t beg, size_t end, unsigned int)
+        {
+            for (size_t v = beg; v < end; ++v)
+                res[v] = dsf.find(UInt(v));
+        });
+
+    renumberComponents(res);
+    return res;
+}
+
+/// Finds connected components of the graph \a g by the Shiloach–Vishkin
+/// algorithm using \a threadsNum threads (0 means all available cores).
+///
+/// Every vertex keeps a label, initially its own ID. Rounds alternate two
+/// parallel phases until no label changes: hooking, where for each edge the
+/// root with the larger label is linked to the smaller label, and shortcutting,
+/// where labels are replaced by labels of labels until they point to roots.
+/// Unlike connectedComponents(), no locks or CAS loops are needed; the number
+/// of rounds is small for graphs of small diameter.
+///
+/// \return The same as connectedComponents().
+template<typename Graph>
+std::vector<unsigned int> connectedComponentsSV(const Graph& g,
+                                                unsigned int threadsNum = 0)
+{
+    typedef unsigned int UInt;
+    typedef std::pair<UInt, UInt> IdEdge;
+
+    const UInt vertsNum = UInt(g.getVerticesNum());
+    std::vector<IdEdge> edges = makeIdEdgeList(g);
+
+    std::unique_ptr<std::atomic<UInt>[]> comp(new std::atomic<UInt>[vertsNum]);
+    parallelFor(0, vertsNum, threadsNum,
+        [&](size_t beg, size_t end, unsigned int)
+        {
+            for (size_t v = beg; v < end; ++v)
+                comp[v].store(UInt(v), std::memory_order_relaxed);
+        });
+
+    std::atomic<bool> changed(true);
+    while (changed.load())
+    {
+        changed.store(false);
+
+        // hooking: races only decide which of the smaller labels wins
+        parallelFor(0, edges.size(), threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                bool ch = false;
+                for (size_t i = beg; i < end; ++i)
+                {
+                    UInt cu = comp[edges[i].first].load(std::memory_order_relaxed);
+                    UInt cv = comp[edges[i].second].load(std::memory_order_relaxed);
+                    if (cu == cv)
+                        continue;
+
+                    UInt hi = std::max(cu, cv);
+                    if (comp[hi].load(std::memory_order_relaxed) == hi)
+                    {
+                        comp[hi].store(std::min(cu, cv), std::memory_order_relaxed);
+                        ch = true;
+                    }
+                }
+                if (ch)
+                    changed.store(true);
+            });
+
+        // shortcutting: labels only decrease, so the chains are finite
+        parallelFor(0, vertsNum, threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t v = beg; v < end; ++v)
+                {
+                    UInt c = comp[v].load(std::memory_order_relaxed);
+                    UInt cc = comp[c].load(std::memory_order_relaxed);
+                    while (c != cc)
+                    {
+                        c = cc;
+                        cc = comp[c].load(std::memory_order_relaxed);
+                    }
+                    comp[v].store(c, std::memory_order_relaxed);
+                }
+            });
+    }
+
+    std::vector<UInt> res(vertsNum);
+    for (UInt v = 0; v < vertsNum; ++v)
+        res[v] = comp[v].load(std::memory_order_relaxed);
+
+    renumberComponents(res);
+    return res;
+}
+
+
+/*! ****************************************************************************
+ *  \brief Labeled edge together with IDs of its ends, used by parallel MST
+ *  algorithms.
+ *
+ *  Edges are ordered by labels, and edges with equal labels by the normalized
+ *  edges themselves, which is the order findMSTKruskal() processes them in.
+ *  Therefore all MST algorithms using this order give the same edge set.
+ ******************************************************************************/
+template <typename Vertex, typename EdgeLbl>
+struct WeightedIdEdge {
+    typedef std::pair<Vertex, Vertex> Edge;
+
+    EdgeLbl lbl;                ///< Label (weight).
+    Edge edge;                  ///< Normalized edge.
+    unsigned int u;             ///< ID of edge.first.
+    unsigned int v;             ///< ID of edge.second.
+
+    bool operator<(const WeightedIdEdge& rhv) const
+    {
+        if (lbl < rhv.lbl)
+            return true;
+        if (rhv.lbl < lbl)
+            return false;
+        return edge < rhv.edge;
+    }
+}; // struct WeightedIdEdge
+
+
+/// Collects all edges of the labeled graph \a g together with their labels
+/// and IDs of their ends. If an edge has no label, throws an exception.
+template<typename Graph>
+std::vector<WeightedIdEdge<typename Graph::Edge::first_type, typename Graph::Label>>
+    makeWeightedIdEdgeList(const Graph& g)
+{
+    typedef WeightedIdEdge<typename Graph::Edge::first_type,
+                           typename Graph::Label> WEdge;
+
+    std::vector<WEdge> res;
+    res.reserve(g.getEdgesNum());
+
+    typename Graph::EdgeIterPair es = g.getEdges();
+    for (; es.first != es.second; ++es.first)
+    {
+        auto e = *es.first;
+        WEdge we;
+        if (!g.getLabel(e.first, e.second, we.lbl))
+            throw std::invalid_argument("Unlabeled edge found");
+
+        we.edge = Graph::makeNormalizedEdge(e.first, e.second);
+        we.u = g.getVertexId(we.edge.first);
+        we.v = g.getVertexId(we.edge.second);
+        res.push_back(we);
+    }
+
+    return res;
+}
+
+
+/*! ****************************************************************************
+ *  \brief Implements Filter-Kruskal algorithm over a vector of weighted edges.
+ *
+ *  \tparam WEdge is a type of weighted edges, see WeightedIdEdge.
+ *
+ *  The range of edges is partitioned around a pivot into light and heavy
+ *  halves; the light half is processed first (recursively), then the heavy
+ *  edges whose ends are already in one component are filtered out, and only
+ *  the rest is processed. Small ranges are sorted (in parallel) and processed
+ *  as in the plain Kruskal algorithm.
+ ******************************************************************************/
+template <typename WEdge>
+class FilterKruskal {
+public:
+    typedef unsigned int UInt;
+    typedef typename std::vector<WEdge>::iterator WEdgeIter;
+
+public:
+    FilterKruskal(size_t vertsNum, unsigned int threadsNum, size_t baseSize)
+        : _threadsNum(getThreadsNum(threadsNum))
+        , _baseSize(baseSize < 3 ? 3 : baseSize)
+        , _mergesLeft(vertsNum > 0 ? vertsNum - 1 : 0)
+    {
+        _dsf.reserve(vertsNum);
+    }
+
+    /// Processes the edges [first, last) and returns the edges of the spanning
+    /// forest.
+    std::vector<WEdge> run(WEdgeIter first, WEdgeIter last)
+    {
+        process(first, last);
+        return _res;
+    }
+
+protected:
+    void process(WEdgeIter first, WEdgeIter last)
+    {
+        if (_mergesLeft == 0 || first == last)
+            return;
+
+        if (size_t(last - first) <= _baseSize)
+        {
+            kruskal(first, last);
+            return;
+        }
+
+        // median of three as a pivot
+        WEdge a = *first, b = *(first + (last - first) / 2), c = *(last - 1);
+        WEdge pivot = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+                              : ((a < c) ? a : ((b < c) ? c : b));
+
+        WEdgeIter mid = std::partition(first, last,
+            [&pivot](const WEdge& we) { return !(pivot < we); });
+
+        process(first, mid);
+        process(filter(mid, last), last);
+    }
+
+    /// Plain Kruskal for a small range.
+    void kruskal(WEdgeIter first, WEdgeIter last)
+    {
+        parallelSort(first, last, _threadsNum, std::less<WEdge>());
+        for (WEdgeIter it = first; it != last && _mergesLeft > 0; ++it)
+        {
+            UInt ru = _dsf.find(it->u);
+            UInt rv = _dsf.find(it->v);
+            if (ru != rv)
+            {
+                _res.push_back(*it);
+                _dsf.merge(ru, rv);
+                --_mergesLeft;
+            }
+        }
+    }
+
+    /// Moves edges connecting different components to the end of the range
+    /// [first, last) and returns the beginning of them.
+    WEdgeIter filter(WEdgeIter first, WEdgeIter last)
+    {
+        size_t n = size_t(last - first);
+        std::vector<char> keep(n);
+        parallelFor(0, n, _threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t i = beg; i < end; ++i)
+                {
+                    const WEdge& we = *(first + i);
+                    keep[i] = _dsf.findConst(we.u) != _dsf.findConst(we.v);
+                }
+            });
+
+        // stable compaction towards the end
+        WEdgeIter dst = last;
+        for (size_t i = n; i > 0; --i)
+        {
+            if (keep[i - 1])
+                *(--dst) = *(first + (i - 1));
+        }
+
+        return dst;
+    }
+
+protected:
+    FlatDisjointSetForest _dsf;         ///< Components found so far.
+    std::vector<WEdge> _res;            ///< Chosen edges.
+    unsigned int _threadsNum;           ///< Number of threads.
+    size_t _baseSize;                   ///< Max size of a range for Kruskal.
+    size_t _mergesLeft;                 ///< Merges left to a spanning tree.
+}; // class FilterKruskal
+
+
+/// Finds a MST for the given graph \a g using Filter-Kruskal algorithm with
+/// \a threadsNum threads (0 means all available cores).
+///
+/// \param baseSize is the maximum number of edges in a range that is sorted
+/// instead of being partitioned further.
+///
+/// The result is the same as the one of findMSTKruskal().
+template<typename Graph>
+std::set<typename Graph::Edge>
+    findMSTFilterKruskal(const Graph& g, unsigned int threadsNum = 0,
+                         size_t baseSize = 1024)
+{
+    typedef WeightedIdEdge<typename Graph::Edge::first_type,
+                           typename Graph::Label> WEdge;
+
+    std::vector<WEdge> wedges = makeWeightedIdEdgeList(g);
+
+    FilterKruskal<WEdge> fk(g.getVerticesNum(), threadsNum, baseSize);
+    std::set<typename Graph::Edge> res;
+    for (const WEdge& we : fk.run(wedges.begin(), wedges.end()))
+        res.insert(we.edge);
+
+    return res;
+}
+
+
+/// Finds a MST (a minimum spanning forest for a disconnected graph) for the
+/// given graph \a g using Borůvka's algorithm with \a threadsNum threads
+/// (0 means all available cores).
+///
+/// Each round, edges are scanned in parallel (every thread takes its own range
+/// of them) to find the cheapest edge leaving each component; components keep
+/// their candidates in atomics updated by CAS. Then the components are
+/// contracted along the chosen edges with the union-find, edges inside
+/// components are dropped and the next round begins. Ties are broken by the
+/// order of WeightedIdEdge, so the result is the same as the one of
+/// findMSTKruskal().
+template<typename Graph>
+std::set<typename Graph::Edge>
+    findMSTBoruvka(const Graph& g, unsigned int threadsNum = 0)
+{
+    typedef unsigned int UInt;
+    typedef WeightedIdEdge<typename Graph::Edge::first_type,
+                           typename Graph::Label> WEdge;
+
+    const UInt NO_EDGE = UInt(-1);
+    const UInt vertsNum = UInt(g.getVerticesNum());
+    threadsNum = getThreadsNum(threadsNum);
+
+    std::vector<WEdge> wedges = makeWeightedIdEdgeList(g);
+    std::set<typename Graph::Edge> res;
+
+    FlatDisjointSetForest dsf;
+    dsf.reserve(vertsNum);
+    std::vector<UInt> comp(vertsNum);               // component of a vertex
+    std::unique_ptr<std::atomic<UInt>[]> cheapest(new std::atomic<UInt>[vertsNum]);
+    std::vector<char> keep;
+
+    while (true)
+    {
+        // components of vertices and reset of candidates
+        parallelFor(0, vertsNum, threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t v = beg; v < end; ++v)
+                {
+                    comp[v] = dsf.findConst(UInt(v));
+                    cheapest[v].store(NO_EDGE, std::memory_order_relaxed);
+                }
+            });
+
+        // drops edges inside components, they will never be chosen
+        keep.assign(wedges.size(), 0);
+        parallelFor(0, wedges.size(), threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t i = beg; i < end; ++i)
+                    keep[i] = comp[wedges[i].u] != comp[wedges[i].v];
+            });
+
+        size_t kept = 0;
+        for (size_t i = 0; i < wedges.size(); ++i)
+            if (keep[i])
+                wedges[kept++] = wedges[i];
+        wedges.resize(kept);
+
+        if (wedges.empty())
+            break;
+
+        // the cheapest outgoing edge for every component
+        parallelFor(0, wedges.size(), threadsNum,
+            [&](size_t beg, size_t end, unsigned int)
+            {
+                for (size_t i = beg; i < end; ++i)
+                {
+                    for (UInt c : {comp[wedges[i].u], comp[wedges[i].v]})
+                    {
+                        UInt cur = cheapest[c].load(std::memory_order_relaxed);
+                        while ((cur == NO_EDGE || wedges[i] < wedges[cur])
+                               && !cheapest[c].compare_exchange_weak(cur, UInt(i)))
+                        {
+                        }
+                    }
+                }
+            });
+
+        // contraction along the chosen edges
+        for (UInt c = 0; c < vertsNum; ++c)
+        {
+            UInt e = cheapest[c].load(std::memory_order_relaxed);
+            if (comp[c] != c || e == NO_EDGE)
+                continue;
+
+            const WEdge& we = wedges[e];
+            if (dsf.find(we.u) != dsf.find(we.v))
+            {
+                dsf.merge(we.u, we.v);
+                res.insert(we.edge);
+            }
+        }
+    }
+
+    return res;
+}
+
+
+/*! ****************************************************************************
+ *  \brief Parallel delta-stepping single-source shortest paths search over a
+ *  labeled graph with non-negative labels, which are edge lengths (Meyer and
+ *  Sanders).
+ *
+ *  \tparam Graph is a labeled graph type, see findMSTPrim().
+ *  \tparam Weight is a type of distances, the label type by default (see
+ *  LabelWeight), as for DijkstraSearch.
+ *
+ *  Vertices with tentative distances in [i * delta, (i + 1) * delta) form the
+ *  bucket i. Buckets are processed in increasing order: light edges (not
+ *  longer than delta) of the current bucket are relaxed repeatedly while it
+ *  gets new vertices, then heavy edges of all vertices removed from it are
+ *  relaxed once. Each step is done by all threads of a ThreadTeam at once:
+ *  vertices are handed out in blocks, distances are lowered by CAS, and every
+ *  thread puts the improved vertices to its own buckets, so no locks are
+ *  needed. As tentative distances never exceed the current bucket's bound by
+ *  more than the longest edge, buckets are kept in a cyclic array. Its length
+ *  is limited by MAX_CYCLE: if delta is much smaller than the longest edge,
+ *  a slot of the array keeps several buckets which are taken out of it one
+ *  by one.
+ *
+ *  The search copies the graph into its own arrays once, with light edges of
+ *  every vertex going first, so a search may be run from many sources.
+ *  Distances are the same as the ones found by DijkstraSearch (exactly for
+ *  integer weights).
+ ******************************************************************************/
+template<typename Graph,
+         typename Weight = typename LabelWeight<typename Graph::Label>::Type>
+class DeltaSteppingSearch {
+public:
+    typedef unsigned int UInt;
+    typedef typename Graph::Edge::first_type Vertex;
+    typedef typename Graph::Label EdgeLbl;
+
+    /// Number of frontier vertices handed out to a thread at once.
+    static const size_t BLOCK_SIZE = 256;
+
+    /// The largest number of slots of cyclic arrays of buckets.
+    static const size_t MAX_CYCLE = 4096;
+
+public:
+    /// Prepares a search over the graph \a g with the bucket width \a delta
+    /// using \a threadsNum threads (0 means all available cores).
+    ///
+    /// If \a delta is 0, it is chosen as the maximum edge length divided by
+    /// the average degree, which keeps buckets reasonably populated.
+    explicit DeltaSteppingSearch(const Graph& g, Weight delta = Weight(),
+                                 unsigned int threadsNum = 0)
+        : _g(g)
+        , _team(threadsNum)
+        , _dist(new std::atomic<Weight>[g.getVerticesNum()])
+        , _buckets(_team.getThreadsNum())
+    {
+        build();
+        _delta = (delta > Weight()) ? delta : chooseDelta();
+        findLightEnds();
+
+        // tentative distances always lie within maxWeight of the current
+        // bucket, so that many buckets plus one are alive at once; the ratio
+        // is taken in doubles as it may not fit size_t
+        double alive = double(_maxWeight) / double(_delta) + 2;
+        size_t bucketsNum = (alive < double(MAX_CYCLE)) ? size_t(alive)
+                                                        : MAX_CYCLE;
+        for (std::vector<IdVector>& bs : _buckets)
+            bs.resize(bucketsNum);
+
+        _marks.assign(g.getVerticesNum(), 0);
+        _settledMarks.assign(g.getVerticesNum(), 0);
+        for (size_t v = 0; v < g.getVerticesNum(); ++v)
+            _dist[v].store(getInfinity(), std::memory_order_relaxed);
+    }
+
+    /// Returns the distance of unreached vertices.
+    static Weight getInfinity() { return std::numeric_limits<Weight>::max(); }
+
+    /// Returns the bucket width.
+    Weight getDelta() const { return _delta; }
+
+    /// Finds shortest paths from the vertex \a source to all vertices.
+    void run(Vertex source)
+    {
+        UInt srcId = _g.getVertexId(source);
+        const size_t vertsNum = _g.getVerticesNum();
+        _team.runBlocks((vertsNum + BLOCK_SIZE - 1) / BLOCK_SIZE,
+            [&](size_t b, unsigned int)
+            {
+                size_t end = std::min(vertsNum, (b + 1) * BLOCK_SIZE);
+                for (size_t v = b * BLOCK_SIZE; v < end; ++v)
+                    _dist[v].store(getInfinity(), std::memory_order_relaxed);
+            });
+
+        _dist[srcId].store(Weight(), std::memory_order_relaxed);
+        _buckets[0][0].push_back(srcId);
+
+        const size_t cycle = _buckets[0].size();
+        size_t cur = 0;                         // current bucket number
+        std::vector<UInt> frontier, settled;
+        while (findNextBucket(cur))
+        {
+            ++_epoch;
+            settled.clear();
+
+            // light edges until the bucket stays empty
+            while (takeBucket(cur % cycle, cur, frontier))
+            {
+                for (UInt v : frontier)
+                    if (_settledMarks[v] != _epoch)
+                    {
+                        _settledMarks[v] = _epoch;
+                        settled.push_back(v);
+                    }
+
+                relaxFrontier(frontier, true);
+            }
+
+            // heavy edges lead to later buckets only, while the slot of this
+            // one may still keep them
+            relaxFrontier(settled, false);
+            ++cur;
+        }
+    }
+
+    /// Returns the distance to the vertex \a v found by the last run, or
+    /// getInfinity() if the vertex was not reached.
+    Weight getDistance(Vertex v) const
+    {
+        return _dist[_g.getVertexId(v)].load(std::memory_order_relaxed);
+    }
+
+    /// Returns distances found by the last run indexed by vertex IDs.
+    std::vector<Weight> getDistances() const
+    {
+        std::vector<Weight> res(_g.getVerticesNum());
+        for (size_t v = 0; v < res.size(); ++v)
+            res[v] = _dist[v].load(std::memory_order_relaxed);
+        return res;
+    }
+
+protected:
+    typedef std::vector<UInt> IdVector;
+
+    /// Copies edges of the graph to _targets/_weights grouped by vertices
+    /// and sorted by length, so light edges of each vertex go first whatever
+    /// delta is.
+    void build()
+    {
+        const size_t vertsNum = _g.getVerticesNum();
+        _offsets.assign(vertsNum + 1, 0);
+        _lightEnds.assign(vertsNum, 0);
+
+        // counts neighbours, then places them by the prefix sums
+        _team.runBlocks((vertsNum + BLOCK_SIZE - 1) / BLOCK_SIZE,
+            [&](size_t b, unsigned int)
+            {
+                size_t end = std::min(vertsNum, (b + 1) * BLOCK_SIZE);
+                for (size_t v = b * BLOCK_SIZE; v < end; ++v)
+                {
+                    auto ns = getAdjEdgesOfId(_g, UInt(v), 0);
+                    _offsets[v + 1] = UInt(std::distance(ns.first, ns.second));
+                }
+            });
+        for (size_t v = 0; v < vertsNum; ++v)
+            _offsets[v + 1] += _offsets[v];
+
+        _targets.resize(_offsets[vertsNum]);
+        _weights.resize(_offsets[vertsNum]);
+        std::vector<Weight> maxWeights(_team.getThreadsNum(), Weight());
+        _team.runBlocks((vertsNum + BLOCK_SIZE - 1) / BLOCK_SIZE,
+            [&](size_t b, unsigned int tid)
+            {
+                std::vector<std::pair<Weight, UInt>> edges;
+                size_t end = std::min(vertsNum, (b + 1) * BLOCK_SIZE);
+                for (size_t v = b * BLOCK_SIZE; v < end; ++v)
+                {
+                    edges.clear();
+                    auto ns = getAdjEdgesOfId(_g, UInt(v), 0);
+                    for (auto it = ns.first; it != ns.second; ++it)
+                    {
+                        EdgeLbl lbl;
+                        if (!_g.getAdjLabel(it, lbl))
+                            throw std::invalid_argument("Unlabeled edge found");
+                        if (lbl < EdgeLbl())
+                            throw std::invalid_argument("Negative edge label found");
+                        edges.push_back({Weight(lbl), _g.getAdjVertexId(it)});
+                    }
+
+                    std::sort(edges.begin(), edges.end());
+                    UInt pos = _offsets[v];
+                    for (const auto& e : edges)
+                    {
+                        _weights[pos] = e.first;
+                        _targets[pos++] = e.second;
+                    }
+                    if (!edges.empty())
+                        maxWeights[tid] = std::max(maxWeights[tid], edges.back().first);
+                }
+            });
+
+        _maxWeight = *std::max_element(maxWeights.begin(), maxWeights.end());
+    }
+
+    /// Chooses delta as the maximum edge length divided by the average
+    /// degree, at least the minimal positive value.
+    Weight chooseDelta()
+    {
+        double avgDeg = _offsets.back()
+                        / double(std::max<size_t>(_g.getVerticesNum(), 1));
+        Weight delta = Weight(double(_maxWeight) / std::max(avgDeg, 1.0));
+        return (delta > Weight()) ? delta : Weight(1);
+    }
+
+    /// Sets ends of light edges of all vertices for the chosen delta.
+    void findLightEnds()
+    {
+        const size_t vertsNum = _g.getVerticesNum();
+        for (size_t v = 0; v < vertsNum; ++v)
+            _lightEnds[v] = UInt(std::upper_bound(_weights.begin() + _offsets[v],
+                                                  _weights.begin() + _offsets[v + 1],
+                                                  _delta) - _weights.begin());
+    }
+
+    /// Moves to \a cur the number of the first bucket starting from \a cur
+    /// whose slot is not empty. Returns false if all buckets are empty.
+    bool findNextBucket(size_t& cur)
+    {
+        const size_t cycle = _buckets[0].size();
+        for (size_t i = 0; i < cycle; ++i)
+            for (const std::vector<IdVector>& bs : _buckets)
+                if (!bs[(cur + i) % cycle].empty())
+                {
+                    cur += i;
+                    return true;
+                }
+
+        return false;
+    }
+
+    /// Collects vertices of the bucket number \a num kept in the cyclic slot
+    /// \a slot of all threads into \a frontier, skipping the ones that have
+    /// moved to other buckets and repeated ones. Vertices of later buckets
+    /// sharing the slot are left in it. Returns false if none.
+    bool takeBucket(size_t slot, size_t num, IdVector& frontier)
+    {
+        const size_t cycle = _buckets[0].size();
+        frontier.clear();
+        ++_markEpoch;
+        for (std::vector<IdVector>& bs : _buckets)
+        {
+            size_t kept = 0;
+            for (UInt v : bs[slot])
+            {
+                size_t vNum = size_t(_dist[v].load(std::memory_order_relaxed)
+                                     / _delta);
+                if (vNum == num)
+                {
+                    if (_marks[v] != _markEpoch)
+                    {
+                        _marks[v] = _markEpoch;
+                        frontier.push_back(v);
+                    }
+                }
+                else if (vNum > num && vNum % cycle == slot)
+                    bs[slot][kept++] = v;
+            }
+            bs[slot].resize(kept);
+        }
+
+        return !frontier.empty();
+    }
+
+    /// Relaxes light (if \a light) or heavy edges of the vertices \a vs by all
+    /// threads.
+    void relaxFrontier(const IdVector& vs, bool light)
+    {
+        const size_t cycle = _buckets[0].size();
+        _team.runBlocks((vs.size() + BLOCK_SIZE - 1) / BLOCK_SIZE,
+            [&](size_t b, unsigned int tid)
+            {
+                std::vector<IdVector>& myBuckets = _buckets[tid];
+                size_t end = std::min(vs.size(), (b + 1) * BLOCK_SIZE);
+                for (size_t i = b * BLOCK_SIZE; i < end; ++i)
+                {
+                    UInt u = vs[i];
+                    Weight du = _dist[u].load(std::memory_order_relaxed);
+                    UInt first = light ? _offsets[u] : _lightEnds[u];
+                    UInt last = light ? _lightEnds[u] : _offsets[u + 1];
+                    for (UInt p = first; p < last; ++p)
+                    {
+                        if (_weights[p] > getInfinity() - du)
+                            continue;           // too long to be a distance
+
+                        Weight nd = du + _weights[p];
+                        UInt v = _targets[p];
+
+                        // lowers the distance unless another thread has
+                        // found a better one
+                        Weight cur = _dist[v].load(std::memory_order_relaxed);
+                        while (nd < cur && !_dist[v].compare_exchange_weak(cur, nd,
+                                                     std::memory_order_relaxed))
+                        {
+                        }
+                        if (nd < cur)
+                            myBuckets[size_t(nd / _delta) % cycle].push_back(v);
+                    }
+                }
+            });
+    }
+
+protected:
+    const Graph& _g;                                ///< Graph to search in.
+    ThreadTeam _team;                               ///< Worker threads.
+    std::unique_ptr<std::atomic<Weight>[]> _dist;   ///< Distances by IDs.
+
+    /// Cyclic arrays of buckets of every thread.
+    std::vector<std::vector<IdVector>> _buckets;
+
+    std::vector<UInt> _offsets;         ///< Adjacency ranges, V + 1 items.
+    std::vector<UInt> _lightEnds;       ///< Ends of light edges of vertices.
+    std::vector<UInt> _targets;         ///< Neighbours' IDs.
+    std::vector<Weight> _weights;       ///< Edge lengths, ascending per vertex.
+    Weight _maxWeight = Weight();       ///< Longest edge.
+    Weight _delta = Weight();           ///< Bucket width.
+
+    std::vector<size_t> _marks;         ///< Dedups vertices of a frontier.
+    size_t _markEpoch = 0;              ///< Current frontier's mark.
+    std::vector<size_t> _settledMarks;  ///< Dedups vertices of a bucket.
+    size_t _epoch = 0;                  ///< Current bucket's mark.
+}; // class DeltaSteppingSearch
+
+template<typename Graph, typename Weight>
+const size_t DeltaSteppingSearch<Graph, Weight>::BLOCK_SIZE;
+
+template<typename Graph, typename Weight>
+const size_t DeltaSteppingSearch<Graph, Weight>::MAX_CYCLE;
+
+
+/// Finds distances of shortest paths from the vertex \a source to all vertices
+/// of the graph \a g by parallel delta-stepping with the bucket width \a delta
+/// (0 chooses it automatically) using \a threadsNum threads (0 means all
+/// available cores).
+///
+/// Returns distances indexed by vertex IDs, the same as the ones returned by
+/// findShortestDistances(). \tparam Weight is as for DeltaSteppingSearch;
+/// ByLabel stands for the default one.
+template<typename Weight = ByLabel, typename Graph>
+std::vector<typename LabelWeight<typename Graph::Label, Weight>::Type>
+    findShortestDistancesDelta(const Graph& g,
+                    typename Graph::Edge::first_type source,
+                    typename LabelWeight<typename Graph::Label, Weight>::Type
+                        delta = 0,
+                    unsigned int threadsNum = 0)
+{
+    DeltaSteppingSearch<Graph,
+                        typename LabelWeight<typename Graph::Label, Weight>::Type>
+        search(g, delta, threadsNum);
+    search.run(source);
+    return search.getDistances();
+}
+
+
+#endif // UGRAPH_PAR_ALGOS_HPP
@@ -0,0 +1,545 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains implementations of traversals of undirected graphs:
+///             depth-first and breadth-first searches with visitors and the
+///             parallel direction-optimizing breadth-first search.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef UGRAPH_TRAVERSAL_HPP
+#define UGRAPH_TRAVERSAL_HPP
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+
+#include "ugraph_algos.hpp"
+#include "vertex_bitset.hpp"
+#include "par_utils.hpp"
+
+
+/*! ****************************************************************************
+ *  \brief Visitor for traverseDfs() and traverseBfs() with callbacks doing
+ *  nothing.
+ *
+ *  A user visitor derives from it and hides the callbacks it needs; they are
+ *  resolved at compile time, so unused ones cost nothing. Vertices are passed
+ *  by their IDs (see Graph::getVertexById()).
+ ******************************************************************************/
+struct TraversalVisitor {
+    typedef unsigned int UInt;
+
+    /// Called for the vertex \a root a traversal starts from.
+    void startVertex(UInt /*root*/) {}
+
+    /// Called when the vertex \a v is reached for the first time. \a level is
+    /// its distance in edges from the root for BFS and its depth in the
+    /// search tree for DFS.
+    void discoverVertex(UInt /*v*/, UInt /*level*/) {}
+
+    /// Called for an edge (u, v) by which the vertex v is discovered.
+    void treeEdge(UInt /*u*/, UInt /*v*/) {}
+
+    /// Called for any other edge (u, v) examined from the vertex u, including
+    /// the one back to u's parent; so most edges are reported from both ends.
+    void nonTreeEdge(UInt /*u*/, UInt /*v*/) {}
+
+    /// Called when all edges of the vertex \a v have been examined.
+    void finishVertex(UInt /*v*/) {}
+
+    /// Returning true stops the traversal.
+    bool isDone() const { return false; }
+}; // struct TraversalVisitor
+
+
+/// Traverses the graph \a g depth-first from the vertex with ID \a root,
+/// skipping vertices marked in \a visited and marking the visited ones.
+/// The search is iterative, so deep graphs do not overflow the call stack.
+///
+/// Returns false if the visitor has stopped the traversal.
+template<typename Graph, typename Visitor>
+bool traverseDfsFromId(const Graph& g, unsigned int root, Visitor& vis,
+                       VertexBitset& visited)
+{
+    typedef unsigned int UInt;
+    typedef decltype(getAdjEdgesOfId(g, 0, 0)) AdjRange;
+
+    // a stack of vertices being examined with their remaining neighbours
+    std::vector<std::pair<UInt, AdjRange>> stack;
+
+    vis.startVertex(root);
+    visited.set(root);
+    vis.discoverVertex(root, 0);
+    stack.push_back({root, getAdjEdgesOfId(g, root, 0)});
+    while (!stack.empty())
+    {
+        if (vis.isDone())
+            return false;
+
+        UInt u = stack.back().first;
+        AdjRange& rest = stack.back().second;
+        if (rest.first == rest.second)
+        {
+            vis.finishVertex(u);
+            stack.pop_back();
+            continue;
+        }
+
+        UInt v = g.getAdjVertexId(rest.first);
+        ++rest.first;
+        if (visited.test(v))
+        {
+            vis.nonTreeEdge(u, v);
+            continue;
+        }
+
+        visited.set(v);
+        vis.treeEdge(u, v);
+        vis.discoverVertex(v, UInt(stack.size()));
+        stack.push_back({v, getAdjEdgesOfId(g, v, 0)});
+    }
+
+    return !vis.isDone();
+}
+
+/// Traverses the graph \a g depth-first from the vertex \a root calling
+/// callbacks of the visitor \a vis (see TraversalVisitor).
+template<typename Graph, typename Visitor>
+void traverseDfs(const Graph& g, typename Graph::Edge::first_type root,
+                 Visitor& vis)
+{
+    VertexBitset visited(g.getVerticesNum());
+    traverseDfsFromId(g, g.getVertexId(root), vis, visited);
+}
+
+/// Traverses all components of the graph \a g depth-first, starting from
+/// unvisited vertices in order of their IDs.
+template<typename Graph, typename Visitor>
+void traverseDfsAll(const Graph& g, Visitor& vis)
+{
+    VertexBitset visited(g.getVerticesNum());
+    for (unsigned int v = 0; v < g.getVerticesNum(); ++v)
+        if (!visited.test(v) && !traverseDfsFromId(g, v, vis, visited))
+            return;
+}
+
+
+/// Traverses the graph \a g breadth-first level by level from the vertex with
+/// ID \a root, skipping vertices marked in \a visited and marking the visited
+/// ones. Returns false if the visitor has stopped the traversal.
+template<typename Graph, typename Visitor>
+bool traverseBfsFromId(const Graph& g, unsigned int root, Visitor& vis,
+                       VertexBitset& visited)
+{
+    typedef unsigned int UInt;
+
+    std::vector<UInt> frontier(1, root), next;
+
+    vis.startVertex(root);
+    visited.set(root);
+    vis.discoverVertex(root, 0);
+    for (UInt level = 1; !frontier.empty(); ++level)
+    {
+        for (UInt u : frontier)
+        {
+            auto ns = getAdjEdgesOfId(g, u, 0);
+            for (auto it = ns.first; it != ns.second; ++it)
+            {
+                UInt v = g.getAdjVertexId(it);
+                if (visited.test(v))
+                {
+                    vis.nonTreeEdge(u, v);
+                    continue;
+                }
+
+                visited.set(v);
+                vis.treeEdge(u, v);
+                vis.discoverVertex(v, level);
+                next.push_back(v);
+            }
+            vis.finishVertex(u);
+
+            if (vis.isDone())
+                return false;
+        }
+
+        frontier.swap(next);
+        next.clear();
+    }
+
+    return true;
+}
+
+/// Traverses the graph \a g breadth-first from the vertex \a root calling
+/// callbacks of the visitor \a vis (see TraversalVisitor).
+template<typename Graph, typename Visitor>
+void traverseBfs(const Graph& g, typename Graph::Edge::first_type root,
+                 Visitor& vis)
+{
+    VertexBitset visited(g.getVerticesNum());
+    traverseBfsFromId(g, g.getVertexId(root), vis, visited);
+}
+
+/// Traverses all components of the graph \a g breadth-first, starting from
+/// unvisited vertices in order of their IDs.
+template<typename Graph, typename Visitor>
+void traverseBfsAll(const Graph& g, Visitor& vis)
+{
+    VertexBitset visited(g.getVerticesNum());
+    for (unsigned int v = 0; v < g.getVerticesNum(); ++v)
+        if (!visited.test(v) && !traverseBfsFromId(g, v, vis, visited))
+            return;
+}
+
+
+/// Determines whether the graph \a g is bipartite, i.e. has no odd cycles.
+/// If so and \a sides is given, sets it to sides (0 or 1) of vertices indexed
+/// by their IDs.
+template<typename Graph>
+bool isBipartite(const Graph& g, std::vector<unsigned char>* sides = nullptr)
+{
+    // colours vertices by parity of levels and looks for an edge inside
+    // a level
+    struct Colouring : TraversalVisitor {
+        std::vector<unsigned char> side;
+        bool odd = false;
+
+        void discoverVertex(UInt v, UInt level) { side[v] = level & 1; }
+        void nonTreeEdge(UInt u, UInt v) { odd = odd || side[u] == side[v]; }
+        bool isDone() const { return odd; }
+    } vis;
+
+    vis.side.assign(g.getVerticesNum(), 0);
+    traverseBfsAll(g, vis);
+    if (sides && !vis.odd)
+        sides->swap(vis.side);
+
+    return !vis.odd;
+}
+
+
+
+/*! ****************************************************************************
+ *  \brief Parallel breadth-first search building a BFS tree, with an optional
+ *  direction-optimizing mode (Beamer, Asanović and Patterson).
+ *
+ *  \tparam Graph is a graph type, see countTrianglesSparse().
+ *
+ *  The top-down step scans edges of the frontier and claims unvisited
+ *  neighbours by CAS on their parents. When the frontier gets large, the
+ *  bottom-up step is used instead: every unvisited vertex scans its own edges
+ *  and stops at the first neighbour in the frontier, so on graphs of small
+ *  diameter most edges are never examined. The frontier is a vector of IDs
+ *  in the top-down step and a VertexBitset in the bottom-up one. Steps switch
+ *  by Beamer's heuristic with parameters alpha and beta.
+ *
+ *  Both steps are split among threads of a ThreadTeam. The search copies the
+ *  adjacency of the graph into its own arrays once, so it may be run from
+ *  many sources.
+ ******************************************************************************/
+template<typename Graph>
+class DirOptBfs {
+public:
+    typedef unsigned int UInt;
+    typedef typename Graph::Edge::first_type Vertex;
+
+    /// ID or level meaning “no vertex”/“not reached”.
+    static const UInt NO_ID = UInt(-1);
+
+    /// Default alpha: switch to bottom-up when the frontier has more than
+    /// 1 / alpha of edges of unvisited vertices.
+    static const UInt DEF_ALPHA = 15;
+
+    /// Default beta: switch back to top-down when the frontier has less
+    /// than 1 / beta of vertices.
+    static const UInt DEF_BETA = 18;
+
+    /// Number of vertices handed out to a thread at once; a multiple of
+    /// 64, so threads of the bottom-up step write different bitset words.
+    static const size_t BLOCK_SIZE = 1024;
+
+public:
+    /// Prepares a search over the graph \a g using \a threadsNum threads
+    /// (0 means all available cores). If \a dirOpt is false, only top-down
+    /// steps are done.
+    explicit DirOptBfs(const Graph& g, unsigned int threadsNum = 1,
+                       bool dirOpt = true, UInt alpha = DEF_ALPHA,
+                       UInt beta = DEF_BETA)
+        : _g(g)
+        , _team(threadsNum)
+        , _dirOpt(dirOpt)
+        , _alpha(alpha)
+        , _beta(beta)
+        , _parents(new std::atomic<UInt>[g.getVerticesNum()])
+        , _levels(g.getVerticesNum(), NO_ID)
+        , _nexts(_team.getThreadsNum())
+        , _examined(_team.getThreadsNum(), 0)
+    {
+        build();
+    }
+
+    /// Builds a BFS tree rooted at the vertex \a root.
+    void run(Vertex root)
+    {
+        const size_t vertsNum = _g.getVerticesNum();
+        const UInt rootId = _g.getVertexId(root);
+        forEachBlock(vertsNum, [&](size_t v, unsigned int)
+            {
+                _parents[v].store(NO_ID, std::memory_order_relaxed);
+                _levels[v] = NO_ID;
+            });
+        std::fill(_examined.begin(), _examined.end(), 0);
+        _topDownSteps = _bottomUpSteps = 0;
+
+        _parents[rootId].store(rootId, std::memory_order_relaxed);
+        _levels[rootId] = 0;
+
+        std::vector<UInt> frontier(1, rootId);
+        VertexBitset frontierBits(vertsNum), nextBits(vertsNum);
+        bool bitsMode = false;
+
+        // edges to check from the frontier and from unvisited vertices
+        size_t frontierEdges = getDegree(rootId);
+        size_t unvisitedEdges = _adj.size() - frontierEdges;
+        size_t frontierSize = 1;
+
+        for (UInt level = 1; frontierSize > 0; ++level)
+        {
+            if (_dirOpt && !bitsMode && frontierEdges > unvisitedEdges / _alpha)
+            {
+                bitsMode = true;
+                toBits(frontier, frontierBits);
+            }
+            else if (bitsMode && frontierSize < vertsNum / _beta)
+            {
+                bitsMode = false;
+                toVector(frontierBits, frontier);
+            }
+
+            std::vector<size_t> degSums(_team.getThreadsNum(), 0);
+            if (bitsMode)
+            {
+                ++_bottomUpSteps;
+                nextBits.clear();
+                stepBottomUp(level, frontierBits, nextBits, degSums);
+                frontierBits.swap(nextBits);
+                frontierSize = frontierBits.count();
+            }
+            else
+            {
+                ++_topDownSteps;
+                stepTopDown(level, frontier, degSums);
+                frontier.clear();
+                for (std::vector<UInt>& next : _nexts)
+                {
+                    frontier.insert(frontier.end(), next.begin(), next.end());
+                    next.clear();
+                }
+                frontierSize = frontier.size();
+            }
+
+            frontierEdges = 0;
+            for (size_t s : degSums)
+                frontierEdges += s;
+            unvisitedEdges -= std::min(unvisitedEdges, frontierEdges);
+        }
+    }
+
+    /// Returns levels (distances in edges from the root) indexed by vertex
+    /// IDs, NO_ID for unreached vertices.
+    const std::vector<UInt>& getLevels() const { return _levels; }
+
+    /// Returns parents in the BFS tree indexed by vertex IDs; the root is its
+    /// own parent, unreached vertices have NO_ID.
+    std::vector<UInt> getParents() const
+    {
+        std::vector<UInt> res(_g.getVerticesNum());
+        for (size_t v = 0; v < res.size(); ++v)
+            res[v] = _parents[v].load(std::memory_order_relaxed);
+        return res;
+    }
+
+    /// Returns the number of half-edges examined by the last run.
+    size_t getExaminedEdgesNum() const
+    {
+        size_t res = 0;
+        for (size_t e : _examined)
+            res += e;
+        return res;
+    }
+
+    /// Returns the number of top-down steps done by the last run.
+    size_t getTopDownStepsNum() const { return _topDownSteps; }
+
+    /// Returns the number of bottom-up steps done by the last run.
+    size_t getBottomUpStepsNum() const { return _bottomUpSteps; }
+
+protected:
+    /// Calls fn(v, threadIdx) for v = 0, 1, ..., \a n - 1 on all threads, in
+    /// blocks of BLOCK_SIZE.
+    template<typename Fn>
+    void forEachBlock(size_t n, Fn fn)
+    {
+        _team.runBlocks((n + BLOCK_SIZE - 1) / BLOCK_SIZE,
+            [&](size_t b, unsigned int tid)
+            {
+                size_t end = std::min(n, (b + 1) * BLOCK_SIZE);
+                for (size_t i = b * BLOCK_SIZE; i < end; ++i)
+                    fn(i, tid);
+            });
+    }
+
+    /// Copies neighbours of all vertices to _adj grouped by vertices.
+    void build()
+    {
+        const size_t vertsNum = _g.getVerticesNum();
+        _offsets.assign(vertsNum + 1, 0);
+        forEachBlock(vertsNum, [&](size_t v, unsigned int)
+            {
+                auto ns = getAdjEdgesOfId(_g, UInt(v), 0);
+                _offsets[v + 1] = UInt(std::distance(ns.first, ns.second));
+            });
+        for (size_t v = 0; v < vertsNum; ++v)
+            _offsets[v + 1] += _offsets[v];
+
+        _adj.resize(_offsets[vertsNum]);
+        forEachBlock(vertsNum, [&](size_t v, unsigned int)
+            {
+                UInt pos = _offsets[v];
+                auto ns = getAdjEdgesOfId(_g, UInt(v), 0);
+                for (auto it = ns.first; it != ns.second; ++it)
+                    _adj[pos++] = _g.getAdjVertexId(it);
+            });
+    }
+
+    size_t getDegree(UInt v) const { return _offsets[v + 1] - _offsets[v]; }
+
+    /// Claims unvisited neighbours of the \a frontier for the \a level; new
+    /// vertices go to _nexts of threads, sums of their degrees to \a degSums.
+    void stepTopDown(UInt level, const std::vector<UInt>& frontier,
+                     std::vector<size_t>& degSums)
+    {
+        forEachBlock(frontier.size(), [&](size_t i, unsigned int tid)
+            {
+                UInt u = frontier[i];
+                _examined[tid] += getDegree(u);
+                for (UInt p = _offsets[u]; p < _offsets[u + 1]; ++p)
+                {
+                    UInt v = _adj[p];
+                    UInt none = NO_ID;
+                    if (_parents[v].load(std::memory_order_relaxed) == NO_ID
+                            && _parents[v].compare_exchange_strong(none, u,
+                                                    std::memory_order_relaxed))
+                    {
+                        _levels[v] = level;
+                        _nexts[tid].push_back(v);
+                        degSums[tid] += getDegree(v);
+                    }
+                }
+            });
+    }
+
+    /// Finds for every unvisited vertex a neighbour in \a frontier and, if
+    /// found, adds the vertex to \a next for the \a level.
+    void stepBottomUp(UInt level, const VertexBitset& frontier,
+                      VertexBitset& next, std::vector<size_t>& degSums)
+    {
+        forEachBlock(_g.getVerticesNum(), [&](size_t v, unsigned int tid)
+            {
+                if (_levels[v] != NO_ID)
+                    return;
+
+                for (UInt p = _offsets[v]; p < _offsets[v + 1]; ++p)
+                {
+                    UInt u = _adj[p];
+                    if (frontier.test(u))
+                    {
+                        _examined[tid] += p - _offsets[v] + 1;
+                        _parents[v].store(u, std::memory_order_relaxed);
+                        _levels[v] = level;
+                        next.set(UInt(v));
+                        degSums[tid] += getDegree(UInt(v));
+                        return;
+                    }
+                }
+                _examined[tid] += getDegree(UInt(v));
+            });
+    }
+
+    /// Converts the frontier from a vector to a bitset.
+    static void toBits(const std::vector<UInt>& vs, VertexBitset& bits)
+    {
+        bits.clear();
+        for (UInt v : vs)
+            bits.set(v);
+    }
+
+    /// Converts the frontier from a bitset to a vector.
+    static void toVector(const VertexBitset& bits, std::vector<UInt>& vs)
+    {
+        vs.clear();
+        bits.forEach([&vs](UInt v) { vs.push_back(v); });
+    }
+
+protected:
+    const Graph& _g;                                ///< Graph to search in.
+    ThreadTeam _team;                               ///< Worker threads.
+    bool _dirOpt;                                   ///< Allows bottom-up.
+    UInt _alpha;                                    ///< Top-down to bottom-up.
+    UInt _beta;                                     ///< Bottom-up to top-down.
+
+    std::vector<UInt> _offsets;                     ///< Adjacency ranges.
+    std::vector<UInt> _adj;                         ///< Neighbours' IDs.
+
+    std::unique_ptr<std::atomic<UInt>[]> _parents;  ///< BFS tree.
+    std::vector<UInt> _levels;                      ///< Levels of vertices.
+    std::vector<std::vector<UInt>> _nexts;          ///< Next frontiers.
+    std::vector<size_t> _examined;                  ///< Edges per thread.
+    size_t _topDownSteps = 0;                       ///< Statistics.
+    size_t _bottomUpSteps = 0;                      ///< Statistics.
+}; // class DirOptBfs
+
+template<typename Graph>
+const typename DirOptBfs<Graph>::UInt DirOptBfs<Graph>::NO_ID;
+
+template<typename Graph>
+const typename DirOptBfs<Graph>::UInt DirOptBfs<Graph>::DEF_ALPHA;
+
+template<typename Graph>
+const typename DirOptBfs<Graph>::UInt DirOptBfs<Graph>::DEF_BETA;
+
+template<typename Graph>
+const size_t DirOptBfs<Graph>::BLOCK_SIZE;
+
+
+/// Finds distances in edges from the vertex \a root to all vertices of the
+/// graph \a g by the direction-optimizing BFS using \a threadsNum threads
+/// (0 means all available cores).
+///
+/// Returns distances indexed by vertex IDs, DirOptBfs::NO_ID for unreachable
+/// vertices.
+template<typename Graph>
+std::vector<unsigned int> findHopDistances(const Graph& g,
+                            typename Graph::Edge::first_type root,
+                            unsigned int threadsNum = 1)
+{
+    DirOptBfs<Graph> bfs(g, threadsNum);
+    bfs.run(root);
+    return bfs.getLevels();
+}
+
+
+#endif // UGRAPH_TRAVERSAL_HPP
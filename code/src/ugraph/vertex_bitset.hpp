@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of bitset-backed sets of vertex IDs.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef VERTEX_BITSET_HPP
+#define VERTEX_BITSET_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+#include "../bitwise_tasks.hpp"
+
+
+/// Number of bits in a bitset word.
+const size_t BITSET_WORD_BITS = 64;
+
+/// Returns the number of words needed for \a bitsNum bits, rounded up to a
+/// multiple of 8 words (64 bytes), so SIMD kernels never handle short tails.
+inline size_t getBitsetWordsNum(size_t bitsNum)
+{
+    size_t words = (bitsNum + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+    return (words + 7) / 8 * 8;
+}
+
+/// Returns the index of the lowest set bit of a non-zero word \a w.
+inline unsigned int getLowestBit(std::uint64_t w)
+{
+    return unsigned(__builtin_ctzll(w));
+}
+
+/// Looks for the first set bit with an index not less than \a from among
+/// \a wordsNum words starting from \a words. Returns \a bitsEnd if no such bit.
+inline size_t findNextBit(const std::uint64_t* words, size_t wordsNum,
+                          size_t from, size_t bitsEnd)
+{
+    size_t wi = from / BITSET_WORD_BITS;
+    if (wi >= wordsNum)
+        return bitsEnd;
+
+    // bits below from are dropped in the first word
+    std::uint64_t w = words[wi] & (~0ULL << (from % BITSET_WORD_BITS));
+    while (w == 0)
+    {
+        if (++wi == wordsNum)
+            return bitsEnd;
+        w = words[wi];
+    }
+
+    return std::min(wi * BITSET_WORD_BITS + getLowestBit(w), bitsEnd);
+}
+
+
+/*! ****************************************************************************
+ *  \brief Set of vertex IDs 0, 1, ..., n - 1 packed into 64-bit words.
+ *
+ *  Compared to std::set<UInt>, membership takes O(1) without allocations and
+ *  set operations process 64 elements per word, with the popcount kernels
+ *  from bitwise_tasks.hpp for counting.
+ ******************************************************************************/
+class VertexBitset {
+public:
+    typedef unsigned int UInt;
+
+public:
+    /// Creates an empty set able to store IDs less than \a n.
+    explicit VertexBitset(size_t n = 0)
+        : _words(getBitsetWordsNum(n), 0)
+        , _bitsNum(n)
+    {
+    }
+
+    /// Adds the ID \a id.
+    void set(UInt id)
+    {
+        _words[id / BITSET_WORD_BITS] |= 1ULL << (id % BITSET_WORD_BITS);
+    }
+
+    /// Removes the ID \a id.
+    void reset(UInt id)
+    {
+        _words[id / BITSET_WORD_BITS] &= ~(1ULL << (id % BITSET_WORD_BITS));
+    }
+
+    /// Returns true if the set contains the ID \a id.
+    bool test(UInt id) const
+    {
+        return (_words[id / BITSET_WORD_BITS] >> (id % BITSET_WORD_BITS)) & 1;
+    }
+
+    /// Removes all IDs.
+    void clear()
+    {
+        std::fill(_words.begin(), _words.end(), 0);
+    }
+
+    /// Returns the number of IDs in the set.
+    size_t count() const
+    {
+        return size_t(countOnes(_words.data(), _words.size()));
+    }
+
+    /// Returns true if the set is empty.
+    bool isEmpty() const
+    {
+        for (std::uint64_t w : _words)
+            if (w != 0)
+                return false;
+        return true;
+    }
+
+    /// Returns the size of the intersection with the set \a other of the same
+    /// capacity.
+    size_t countCommon(const VertexBitset& other) const
+    {
+        return size_t(countOnesAnd(_words.data(), other._words.data(),
+                                   std::min(_words.size(), other._words.size())));
+    }
+
+    /// Returns the least ID not less than \a from, or getCapacity() if none.
+    size_t findNext(size_t from) const
+    {
+        return findNextBit(_words.data(), _words.size(), from, _bitsNum);
+    }
+
+    /// Calls fn(id) for each ID in the set in ascending order.
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (size_t wi = 0; wi < _words.size(); ++wi)
+        {
+            for (std::uint64_t w = _words[wi]; w != 0; w &= w - 1)
+                fn(UInt(wi * BITSET_WORD_BITS + getLowestBit(w)));
+        }
+    }
+
+    /// Swaps contents with the set \a other.
+    void swap(VertexBitset& other)
+    {
+        _words.swap(other._words);
+        std::swap(_bitsNum, other._bitsNum);
+    }
+
+    /// Returns the upper bound for stored IDs.
+    size_t getCapacity() const { return _bitsNum; }
+
+    /// Returns the words storing the set.
+    const std::vector<std::uint64_t>& getWords() const { return _words; }
+    std::vector<std::uint64_t>& getWords() { return _words; }
+
+protected:
+    std::vector<std::uint64_t> _words;  ///< Bits, padded to 64 bytes.
+    size_t _bitsNum;                    ///< Capacity in bits.
+}; // class VertexBitset
+
+
+#endif // VERTEX_BITSET_HPP
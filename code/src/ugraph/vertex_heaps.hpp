@@ -0,0 +1,503 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains implementations of indexed priority queues over dense
+///             vertex IDs.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef VERTEX_HEAPS_HPP
+#define VERTEX_HEAPS_HPP
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+
+/*! ****************************************************************************
+ *  \brief Implements an indexed d-ary min-heap storing vertex IDs together
+ *  with associated weights.
+ *
+ *  \tparam Weight represents a type for weights. Must be comparable.
+ *  \tparam Arity is the number of children of a heap node (d).
+ *
+ *  The interface repeats the one of VertexPriorityQueue with vertices replaced
+ *  by their dense IDs. Positions of IDs in the heap are tracked in a vector,
+ *  so decrease-key and removal of an arbitrary element need no lookup, and
+ *  no operation allocates memory once the heap has been reserved.
+ ******************************************************************************/
+template <typename Weight = unsigned int, unsigned int Arity = 4>
+class IndexedDaryHeap {
+public:
+    typedef unsigned int UInt;
+    typedef Weight WeightType;
+    typedef std::pair<UInt, Weight> VertexWeight;
+
+    static_assert(Arity >= 2, "Heap arity must be at least 2");
+
+public:
+
+    /// Reserves memory for vertices with IDs less than \a n.
+    void reserve(size_t n)
+    {
+        _heap.reserve(n);
+        if (_pos.size() < n)
+            _pos.resize(n, NOT_IN);
+    }
+
+    /// For the given vertex \a v sets new weight to \a weight.
+    /// If no vertex exists, inserts a new pair (v, weight).
+    void set(UInt v, Weight weight)
+    {
+        if (!contains(v))
+        {
+            insert(v, weight);
+            return;
+        }
+
+        UInt i = _pos[v];
+        Weight old = _heap[i].first;
+        _heap[i].first = weight;
+        if (weight < old)
+            siftUp(i);
+        else
+            siftDown(i);
+    }
+
+    /// Inserts a new vertex-weight pair w/o checking a presence the same vertex
+    /// in a queue. Usefull for initialization.
+    void insert(UInt v, Weight weight)
+    {
+        if (v >= _pos.size())
+            _pos.resize(v + 1, NOT_IN);
+
+        _heap.push_back({weight, v});
+        _pos[v] = UInt(_heap.size() - 1);
+        siftUp(_pos[v]);
+    }
+
+    /// Return a pair of vertex-weight for the minimum element. Method does not
+    /// remove it from the heap.
+    ///
+    /// If a queue is empty, throws an exception.
+    VertexWeight getMin() const
+    {
+        if (isEmpty())
+            throw std::out_of_range("Queue is empty");
+
+        return { _heap[0].second, _heap[0].first };
+    }
+
+    /// Removes and returns the minimum element.
+    /// If a queue is empty, throws an exception.
+    VertexWeight popMin()
+    {
+        VertexWeight vw = getMin();
+        removeAt(0);
+
+        return vw;
+    }
+
+    /// Removes the given vertex \a v.
+    /// In no such a vertex, throws an exception.
+    void remove(UInt v)
+    {
+        if (!contains(v))
+            throw std::invalid_argument("No such vertex in PQ");
+
+        removeAt(_pos[v]);
+    }
+
+    /// For the given vertex \a v returns associated weight.
+    /// In no such a vertex, return false, otherwise true and set \a weight.
+    bool getWeight(UInt v, Weight& weight) const
+    {
+        if (!contains(v))
+            return false;
+
+        weight = _heap[_pos[v]].first;
+        return true;
+    }
+
+    /// Returns true if the vertex \a v is in the queue.
+    bool contains(UInt v) const
+    {
+        return v < _pos.size() && _pos[v] != NOT_IN;
+    }
+
+    /// Returns true if the queue is empty.
+    bool isEmpty() const
+    {
+        return _heap.empty();
+    }
+
+    /// Returns the number of elements in the queue.
+    size_t getSize() const { return _heap.size(); }
+
+protected:
+    /// Position of a vertex that is not in the heap.
+    static const UInt NOT_IN = UInt(-1);
+
+    /// Heap element: weight goes first so that pairs are ordered by weight
+    /// and, for equal weights, by vertex ID.
+    typedef std::pair<Weight, UInt> HeapItem;
+
+    /// Places the item at the position \a i and updates its index.
+    void place(UInt i, const HeapItem& item)
+    {
+        _heap[i] = item;
+        _pos[item.second] = i;
+    }
+
+    void siftUp(UInt i)
+    {
+        HeapItem item = _heap[i];
+        while (i > 0)
+        {
+            UInt par = (i - 1) / Arity;
+            if (!(item < _heap[par]))
+                break;
+
+            place(i, _heap[par]);
+            i = par;
+        }
+
+        place(i, item);
+    }
+
+    void siftDown(UInt i)
+    {
+        HeapItem item = _heap[i];
+        const UInt n = UInt(_heap.size());
+        while (true)
+        {
+            UInt first = i * Arity + 1;
+            if (first >= n)
+                break;
+
+            // looks for the smallest child
+            UInt last = (first + Arity < n) ? first + Arity : n;
+            UInt best = first;
+            for (UInt c = first + 1; c < last; ++c)
+                if (_heap[c] < _heap[best])
+                    best = c;
+
+            if (!(_heap[best] < item))
+                break;
+
+            place(i, _heap[best]);
+            i = best;
+        }
+
+        place(i, item);
+    }
+
+    /// Removes the element at the heap position \a i.
+    void removeAt(UInt i)
+    {
+        _pos[_heap[i].second] = NOT_IN;
+
+        UInt last = UInt(_heap.size() - 1);
+        if (i != last)
+        {
+            HeapItem moved = _heap[last];
+            _heap.pop_back();
+            place(i, moved);
+
+            siftUp(i);
+            siftDown(_pos[moved.second]);
+            return;
+        }
+
+        _heap.pop_back();
+    }
+
+protected:
+    std::vector<HeapItem> _heap;        ///< Implicit d-ary tree.
+    std::vector<UInt> _pos;             ///< Vertex ID -> position in _heap.
+}; // class IndexedDaryHeap
+
+template <typename Weight, unsigned int Arity>
+const typename IndexedDaryHeap<Weight, Arity>::UInt
+    IndexedDaryHeap<Weight, Arity>::NOT_IN;
+
+
+
+/*! ****************************************************************************
+ *  \brief Implements an indexed pairing min-heap storing vertex IDs together
+ *  with associated weights.
+ *
+ *  \tparam Weight represents a type for weights. Must be comparable.
+ *
+ *  The interface is the same as the one of IndexedDaryHeap. Tree nodes live in
+ *  a vector indexed by vertex ID, so links are IDs rather than pointers and
+ *  the heap does not allocate per operation. Decrease-key is O(1) (cut and
+ *  meld), removal of the minimum is amortized O(log n).
+ ******************************************************************************/
+template <typename Weight = unsigned int>
+class IndexedPairingHeap {
+public:
+    typedef unsigned int UInt;
+    typedef Weight WeightType;
+    typedef std::pair<UInt, Weight> VertexWeight;
+
+public:
+
+    /// Reserves memory for vertices with IDs less than \a n.
+    void reserve(size_t n)
+    {
+        if (_nodes.size() < n)
+            _nodes.resize(n);
+    }
+
+    /// For the given vertex \a v sets new weight to \a weight.
+    /// If no vertex exists, inserts a new pair (v, weight).
+    void set(UInt v, Weight weight)
+    {
+        if (!contains(v))
+        {
+            insert(v, weight);
+            return;
+        }
+
+        Node& n = _nodes[v];
+        if (weight < n.weight)                      // decrease-key
+        {
+            n.weight = weight;
+            if (v != _root)
+            {
+                cut(v);
+                _root = meld(_root, v);
+            }
+            return;
+        }
+
+        // increase-key: reinsert the node
+        remove(v);
+        insert(v, weight);
+    }
+
+    /// Inserts a new vertex-weight pair w/o checking a presence the same vertex
+    /// in a queue. Usefull for initialization.
+    void insert(UInt v, Weight weight)
+    {
+        reserve(size_t(v) + 1);
+
+        Node& n = _nodes[v];
+        n.weight = weight;
+        n.child = n.sibling = n.prev = NIL;
+        n.in = true;
+
+        _root = (_root == NIL) ? v : meld(_root, v);
+        ++_size;
+    }
+
+    /// Return a pair of vertex-weight for the minimum element. Method does not
+    /// remove it from the heap.
+    ///
+    /// If a queue is empty, throws an exception.
+    VertexWeight getMin() const
+    {
+        if (isEmpty())
+            throw std::out_of_range("Queue is empty");
+
+        return { _root, _nodes[_root].weight };
+    }
+
+    /// Removes and returns the minimum element.
+    /// If a queue is empty, throws an exception.
+    VertexWeight popMin()
+    {
+        VertexWeight vw = getMin();
+        remove(_root);
+
+        return vw;
+    }
+
+    /// Removes the given vertex \a v.
+    /// In no such a vertex, throws an exception.
+    void remove(UInt v)
+    {
+        if (!contains(v))
+            throw std::invalid_argument("No such vertex in PQ");
+
+        if (v != _root)
+            cut(v);
+
+        UInt sub = mergePairs(_nodes[v].child);
+        _nodes[v].in = false;
+        _nodes[v].child = NIL;
+        --_size;
+
+        if (v == _root)
+            _root = sub;
+        else if (sub != NIL)
+            _root = meld(_root, sub);
+    }
+
+    /// For the given vertex \a v returns associated weight.
+    /// In no such a vertex, return false, otherwise true and set \a weight.
+    bool getWeight(UInt v, Weight& weight) const
+    {
+        if (!contains(v))
+            return false;
+
+        weight = _nodes[v].weight;
+        return true;
+    }
+
+    /// Returns true if the vertex \a v is in the queue.
+    bool contains(UInt v) const
+    {
+        return v < _nodes.size() && _nodes[v].in;
+    }
+
+    /// Returns true if the queue is empty.
+    bool isEmpty() const
+    {
+        return _size == 0;
+    }
+
+    /// Returns the number of elements in the queue.
+    size_t getSize() const { return _size; }
+
+protected:
+    /// “Null” link.
+    static const UInt NIL = UInt(-1);
+
+    /// Tree node of a vertex.
+    struct Node {
+        Weight weight = Weight();
+        UInt child = NIL;           ///< Leftmost child.
+        UInt sibling = NIL;         ///< Right sibling.
+        UInt prev = NIL;            ///< Left sibling or parent for the leftmost.
+        bool in = false;            ///< true if the vertex is in the heap.
+    };
+
+    /// Returns true if the node \a a must go above the node \a b; ties are
+    /// broken by vertex IDs.
+    bool isLess(UInt a, UInt b) const
+    {
+        return _nodes[a].weight < _nodes[b].weight
+            || (!(_nodes[b].weight < _nodes[a].weight) && a < b);
+    }
+
+    /// Melds two roots \a a and \a b and returns the new one.
+    UInt meld(UInt a, UInt b)
+    {
+        if (isLess(b, a))
+            std::swap(a, b);
+
+        // b becomes the leftmost child of a
+        Node& na = _nodes[a];
+        Node& nb = _nodes[b];
+        nb.prev = a;
+        nb.sibling = na.child;
+        if (na.child != NIL)
+            _nodes[na.child].prev = b;
+        na.child = b;
+        na.sibling = na.prev = NIL;
+
+        return a;
+    }
+
+    /// Detaches the non-root node \a v (with its subtree) from its parent.
+    void cut(UInt v)
+    {
+        Node& n = _nodes[v];
+        Node& p = _nodes[n.prev];
+        if (p.child == v)
+            p.child = n.sibling;                // v is the leftmost child
+        else
+            p.sibling = n.sibling;
+
+        if (n.sibling != NIL)
+            _nodes[n.sibling].prev = n.prev;
+
+        n.sibling = n.prev = NIL;
+    }
+
+    /// Two-pass pairing of the sibling list starting at \a first.
+    /// Returns the resulting root.
+    UInt mergePairs(UInt first)
+    {
+        if (first == NIL)
+            return NIL;
+
+        // first pass: meld pairs from left to right
+        _pairs.clear();
+        while (first != NIL)
+        {
+            UInt a = first;
+            UInt b = _nodes[a].sibling;
+            first = (b != NIL) ? _nodes[b].sibling : NIL;
+
+            _nodes[a].sibling = _nodes[a].prev = NIL;
+            if (b != NIL)
+            {
+                _nodes[b].sibling = _nodes[b].prev = NIL;
+                a = meld(a, b);
+            }
+            _pairs.push_back(a);
+        }
+
+        // second pass: meld the results from right to left
+        UInt res = _pairs.back();
+        for (size_t i = _pairs.size() - 1; i > 0; --i)
+            res = meld(_pairs[i - 1], res);
+
+        return res;
+    }
+
+protected:
+    std::vector<Node> _nodes;       ///< Nodes indexed by vertex ID.
+    std::vector<UInt> _pairs;       ///< Scratch list for mergePairs().
+    UInt _root = NIL;               ///< Root of the heap.
+    size_t _size = 0;               ///< Number of elements.
+}; // class IndexedPairingHeap
+
+template <typename Weight>
+const typename IndexedPairingHeap<Weight>::UInt IndexedPairingHeap<Weight>::NIL;
+
+
+
+/// Placeholder of a priority queue type standing for the default one over
+/// edge labels of a graph, see LabelHeap.
+struct ByLabel {};
+
+/// Gives the type of path lengths over edge labels of the type \a Label: the
+/// label type itself with small integer types promoted to int, so fractional
+/// labels are never truncated. Another type may be chosen by \a W.
+template <typename Label, typename W = ByLabel>
+struct LabelWeight {
+    typedef W Type;
+};
+
+template <typename Label>
+struct LabelWeight<Label, ByLabel> {
+    typedef decltype(+Label()) Type;
+};
+
+/// Gives the priority queue type \a PQ or, if it is ByLabel, IndexedDaryHeap
+/// over LabelWeight of \a Label.
+template <typename Label, typename PQ = ByLabel>
+struct LabelHeap {
+    typedef PQ Type;
+};
+
+template <typename Label>
+struct LabelHeap<Label, ByLabel> {
+    typedef IndexedDaryHeap<typename LabelWeight<Label>::Type> Type;
+};
+
+
+#endif // VERTEX_HEAPS_HPP
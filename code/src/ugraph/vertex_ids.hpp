@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief      Contains declarations of the interning layer mapping vertices
+///             to dense integer identifiers.
+/// \author     Sergey Shershakov
+/// \version    0.1.0
+/// \date       21.09.2020
+/// \copyright  © Sergey Shershakov 2020.
+///             This code is for educational purposes of the course "Algorithms
+///             and Data Structures" provided by the Faculty of Computer Science
+///             at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef VERTEX_IDS_HPP
+#define VERTEX_IDS_HPP
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <functional>
+#include <memory>
+
+
+/*! ****************************************************************************
+ *  \brief Type trait determining whether std::hash is usable for a type \a T.
+ ******************************************************************************/
+template <typename T, typename = void>
+struct IsStdHashable : std::false_type {
+};
+
+template <typename T>
+struct IsStdHashable<T,
+        decltype(void(std::hash<T>()(std::declval<const T&>())))>
+    : std::true_type {
+};
+
+
+/*! ****************************************************************************
+ *  \brief Metafunction choosing a default associative container for mapping
+ *  vertices to their IDs: a hash map for hashable vertices, a tree map for
+ *  comparable ones otherwise. Nodes are allocated by \a Alloc rebound to the
+ *  value type.
+ *
+ *  Usage: DefaultVertexIdMap<Vertex>::Type...
+ ******************************************************************************/
+template <typename Vertex, typename Alloc = std::allocator<Vertex>>
+struct DefaultVertexIdMap
+{
+    typedef std::pair<const Vertex, unsigned int> Value;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Value>
+            ValueAlloc;
+
+    typedef typename std::conditional<IsStdHashable<Vertex>::value,
+                std::unordered_map<Vertex, unsigned int, std::hash<Vertex>,
+                                   std::equal_to<Vertex>, ValueAlloc>,
+                std::map<Vertex, unsigned int, std::less<Vertex>, ValueAlloc>
+            >::type
+            Type;
+};
+
+
+/*! ****************************************************************************
+ *  \brief Interns vertices into dense IDs 0, 1, 2, ... in the order they are
+ *  added.
+ *
+ *  \tparam Vertex represents a type for vertices.
+ *  \tparam IdMap is an associative container Vertex -> unsigned int, used for
+ *  the forward mapping. The backward mapping is a plain vector.
+ *
+ *  Having dense IDs, algorithms store their side data in plain vectors indexed
+ *  by ID and translate IDs back to vertices only at the API boundary.
+ ******************************************************************************/
+template <typename Vertex,
+          typename IdMap = typename DefaultVertexIdMap<Vertex>::Type>
+class VertexIdMap {
+public:
+    typedef unsigned int UInt;
+
+    /// ID value meaning “no vertex”.
+    static const UInt NO_ID = UInt(-1);
+
+public:
+    VertexIdMap() = default;
+
+    /// Makes an empty map allocating its nodes by \a alloc.
+    explicit VertexIdMap(const typename IdMap::allocator_type& alloc)
+        : _ids(alloc)
+    {
+    }
+
+    /// Returns the ID of the vertex \a v; if the vertex is met for the first
+    /// time, assigns the next free ID to it.
+    UInt intern(Vertex v)
+    {
+        auto res = _ids.insert({v, UInt(_vertices.size())});
+        if (res.second)
+            _vertices.push_back(v);
+
+        return res.first->second;
+    }
+
+    /// Looks for the ID of the vertex \a v. Returns true and sets \a id if
+    /// the vertex is interned, false otherwise.
+    bool findId(Vertex v, UInt& id) const
+    {
+        auto it = _ids.find(v);
+        if (it == _ids.end())
+            return false;
+
+        id = it->second;
+        return true;
+    }
+
+    /// Returns the ID of the vertex \a v.
+    /// If no such a vertex, throws an exception.
+    UInt getId(Vertex v) const
+    {
+        auto it = _ids.find(v);
+        if (it == _ids.end())
+            throw std::invalid_argument("No such vertex");
+
+        return it->second;
+    }
+
+    /// Returns the vertex having the ID \a id.
+    Vertex getVertex(UInt id) const { return _vertices[id]; }
+
+    /// Returns the number of interned vertices, which is also the upper bound
+    /// for IDs.
+    size_t getSize() const { return _vertices.size(); }
+
+    /// Removes the vertex \a v. To keep IDs dense, the vertex having the last
+    /// ID gets the ID of \a v. Returns the former ID of \a v.
+    /// If no such a vertex, throws an exception.
+    UInt remove(Vertex v)
+    {
+        UInt id = getId(v);
+        Vertex last = _vertices.back();
+        _ids.erase(v);
+        if (id + 1 != _vertices.size())
+        {
+            _ids[last] = id;
+            _vertices[id] = last;
+        }
+        _vertices.pop_back();
+
+        return id;
+    }
+
+    /// Reserves memory for \a n vertices.
+    void reserve(size_t n) { _vertices.reserve(n); }
+
+protected:
+    IdMap _ids;                         ///< Vertex -> ID.
+    std::vector<Vertex> _vertices;      ///< ID -> Vertex.
+}; // class VertexIdMap
+
+template <typename Vertex, typename IdMap>
+const typename VertexIdMap<Vertex, IdMap>::UInt
+    VertexIdMap<Vertex, IdMap>::NO_ID;
+
+
+#endif // VERTEX_IDS_HPP
@@ -1,4 +1,11 @@
 
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <bitset>
+
 #include <gtest/gtest.h>
 
 #include "bitwise_tasks.cpp"
@@ -15,3 +22,155 @@ TEST(BitwiseCheckBit, checkBit1)
 
     EXPECT_EQ(0, getBitAtIndex(number, idx));
 }
+
+TEST(BitwiseCheckBit, checkBit2)
+{
+    EXPECT_EQ(1, getBitAtIndex(9, 0));
+    EXPECT_EQ(1, getBitAtIndex(9, 3));
+    EXPECT_EQ(0, getBitAtIndex(9, 4));
+    EXPECT_EQ(1, getBitAtIndex(0x80000000u, 31));
+}
+
+
+TEST(BitwiseCountOnes, countOnes1)
+{
+    EXPECT_EQ(0, countOnes(0ULL));
+    EXPECT_EQ(2, countOnes(9ULL));
+    EXPECT_EQ(64, countOnes(~0ULL));
+    EXPECT_EQ(32, countOnes(0xAAAAAAAAAAAAAAAAULL));
+}
+
+
+// Returns instruction sets supported by the CPU.
+static std::vector<BitwiseIsa> getSupportedIsas()
+{
+    std::vector<BitwiseIsa> isas = { BitwiseIsa::Scalar };
+    if (hasAvx2())
+        isas.push_back(BitwiseIsa::Avx2);
+    if (hasAvx512Popcnt())
+        isas.push_back(BitwiseIsa::Avx512);
+    return isas;
+}
+
+
+// Bulk counts for all lengths up to a few vector widths, so that all tails
+// are checked.
+TEST(BitwiseCountOnes, bulk1)
+{
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> words(100);
+    for (std::uint64_t& w : words)
+        w = rng();
+
+    for (BitwiseIsa isa : getSupportedIsas())
+        for (size_t n = 0; n <= words.size(); ++n)
+        {
+            std::uint64_t expected = 0;
+            for (size_t i = 0; i < n; ++i)
+                expected += countOnes((unsigned long long)words[i]);
+
+            EXPECT_EQ(expected, countOnes(words.data(), n, isa));
+        }
+
+    std::vector<std::uint64_t> ones(1000, ~0ULL);
+    EXPECT_EQ(64000, countOnes(ones));
+}
+
+
+TEST(BitwiseCheckBit, bitmapBit1)
+{
+    std::uint64_t words[] = { 1, 0x8000000000000000ULL };
+    EXPECT_EQ(1, getBitmapBit(words, 0));
+    EXPECT_EQ(0, getBitmapBit(words, 1));
+    EXPECT_EQ(0, getBitmapBit(words, 64));
+    EXPECT_EQ(1, getBitmapBit(words, 127));
+}
+
+
+TEST(BitwiseCheckBit, bulk1)
+{
+    std::mt19937 rng(42);
+    std::vector<std::uint32_t> numbers(100);
+    for (std::uint32_t& x : numbers)
+        x = rng();
+
+    std::vector<std::uint8_t> bits(numbers.size());
+    for (BitwiseIsa isa : getSupportedIsas())
+        for (int idx : { 0, 1, 7, 16, 31 })
+            for (size_t n : { size_t(0), size_t(1), size_t(31), size_t(32),
+                              size_t(33), size_t(64), size_t(100) })
+            {
+                std::fill(bits.begin(), bits.end(), 2);
+                getBitsAtIndex(numbers.data(), n, idx, bits.data(), isa);
+                for (size_t i = 0; i < n; ++i)
+                    EXPECT_EQ(getBitAtIndex(numbers[i], idx), bits[i]);
+                for (size_t i = n; i < bits.size(); ++i)
+                    EXPECT_EQ(2, bits[i]);
+            }
+}
+
+
+// Intersection counts for all lengths, so that all tails are checked.
+TEST(BitwiseCountOnes, bulkAnd1)
+{
+    std::mt19937_64 rng(7);
+    std::vector<std::uint64_t> a(100), b(100);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = rng();
+        b[i] = rng();
+    }
+
+    for (BitwiseIsa isa : getSupportedIsas())
+        for (size_t n = 0; n <= a.size(); ++n)
+        {
+            std::uint64_t expected = 0;
+            for (size_t i = 0; i < n; ++i)
+                expected += countOnes((unsigned long long)(a[i] & b[i]));
+
+            EXPECT_EQ(expected, countOnesAnd(a.data(), b.data(), n, isa));
+        }
+}
+
+
+TEST(BitwiseToBinary, toBinary1)
+{
+    EXPECT_EQ("00000000000000000000000000001001", toBinaryString(9u));
+    EXPECT_EQ(std::string(32, '1'), toBinaryString(~0u));
+    EXPECT_EQ("1" + std::string(63, '0'),
+              toBinaryString(std::uint64_t(1) << 63));
+
+    testing::internal::CaptureStdout();
+    printBinary(5);
+    EXPECT_EQ("00000000000000000000000000000101",
+              testing::internal::GetCapturedStdout());
+}
+
+// All versions must agree with std::bitset on random numbers.
+TEST(BitwiseToBinary, bulk1)
+{
+    std::mt19937_64 rng(3);
+    std::vector<std::uint32_t> n32(50);
+    std::vector<std::uint64_t> n64(50);
+    std::string expected32, expected64;
+    for (size_t i = 0; i < n32.size(); ++i)
+    {
+        n32[i] = std::uint32_t(rng());
+        n64[i] = rng();
+        expected32 += std::bitset<32>(n32[i]).to_string() + ' ';
+        expected64 += std::bitset<64>(n64[i]).to_string() + ' ';
+    }
+
+    std::vector<char> buf(n64.size() * (BINARY64_LEN + 1));
+    for (BitwiseIsa isa : getSupportedIsas())
+    {
+        char* end = toBinaryBulk(n32.data(), n32.size(), buf.data(), ' ', isa);
+        EXPECT_EQ(expected32, std::string(buf.data(), end));
+
+        end = toBinaryBulk(n64.data(), n64.size(), buf.data(), ' ', isa);
+        EXPECT_EQ(expected64, std::string(buf.data(), end));
+    }
+
+    char* end = toBinaryBulk(n32.data(), 0, buf.data());
+    EXPECT_EQ(buf.data(), end);
+}
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for ConcurrentDisjointSetForest class and parallel
+/// connected components.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <random>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/conc_disj_set.hpp"
+#include "ugraph/disj_set.hpp"
+#include "ugraph/ugraph_par_algos.hpp"
+
+
+TEST(ConcurrentDisjointSetForest, simplest)
+{
+}
+
+
+TEST(ConcurrentDisjointSetForest, merge1)
+{
+    ConcurrentDisjointSetForest dsf(6);
+    EXPECT_EQ(6, dsf.getSize());
+    EXPECT_TRUE(dsf.isRepresentative(3));
+
+    EXPECT_TRUE(dsf.merge(0, 1));
+    EXPECT_TRUE(dsf.merge(2, 3));
+    EXPECT_FALSE(dsf.merge(1, 0));
+    EXPECT_TRUE(dsf.isSameSet(0, 1));
+    EXPECT_FALSE(dsf.isSameSet(0, 2));
+
+    EXPECT_TRUE(dsf.merge(1, 3));
+    EXPECT_TRUE(dsf.isSameSet(0, 2));
+    EXPECT_EQ(dsf.find(0), dsf.find(3));
+    EXPECT_NE(dsf.find(0), dsf.find(4));
+    EXPECT_FALSE(dsf.isSameSet(4, 5));
+}
+
+
+// Random merges from several threads give the same partition as sequential
+// merges in a FlatDisjointSetForest.
+TEST(ConcurrentDisjointSetForest, parallelMerges)
+{
+    const unsigned int N = 5000;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<unsigned int> dist(0, N - 1);
+    std::vector<std::pair<unsigned int, unsigned int>> pairs(4000);
+    for (auto& p : pairs)
+        p = {dist(rng), dist(rng)};
+
+    FlatDisjointSetForest ref;
+    ref.reserve(N);
+    for (auto& p : pairs)
+        ref.merge(p.first, p.second);
+
+    ConcurrentDisjointSetForest dsf(N);
+    std::atomic<unsigned int> merged(0);
+    parallelFor(0, pairs.size(), 4,
+        [&](size_t beg, size_t end, unsigned int)
+        {
+            for (size_t i = beg; i < end; ++i)
+                if (dsf.merge(pairs[i].first, pairs[i].second))
+                    ++merged;
+        });
+
+    unsigned int refSets = 0;
+    for (unsigned int v = 0; v < N; ++v)
+    {
+        if (ref.isRepresentative(v))
+            ++refSets;
+        ASSERT_EQ(ref.find(v) == ref.find(0), dsf.isSameSet(v, 0));
+        ASSERT_EQ(ref.find(v) == ref.find(v / 2), dsf.isSameSet(v, v / 2));
+    }
+
+    // each successful merge reduces the number of sets by one
+    EXPECT_EQ(N - merged, refSets);
+}
+
+
+TEST(ConcurrentDisjointSetForest, connectedComponents1)
+{
+    UGraph<int> g;
+    g.addEdge(10, 11);
+    g.addEdge(11, 12);
+    g.addEdge(20, 21);
+    g.addEdge(12, 10);
+    g.addVertex(30);
+    g.addEdge(21, 22);
+    g.addEdge(13, 13);
+
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+    {
+        std::vector<unsigned int> comps = connectedComponents(g, threads);
+        ASSERT_EQ(g.getVerticesNum(), comps.size());
+
+        // components are numbered by their smallest vertex IDs
+        EXPECT_EQ(0, comps[g.getVertexId(10)]);
+        EXPECT_EQ(0, comps[g.getVertexId(11)]);
+        EXPECT_EQ(0, comps[g.getVertexId(12)]);
+        EXPECT_EQ(1, comps[g.getVertexId(20)]);
+        EXPECT_EQ(1, comps[g.getVertexId(22)]);
+        EXPECT_EQ(2, comps[g.getVertexId(30)]);
+        EXPECT_EQ(3, comps[g.getVertexId(13)]);
+    }
+}
+
+
+TEST(ConcurrentDisjointSetForest, connectedComponentsSV1)
+{
+    UGraph<int> g;
+    g.addEdge(10, 11);
+    g.addEdge(11, 12);
+    g.addEdge(20, 21);
+    g.addEdge(12, 10);
+    g.addVertex(30);
+    g.addEdge(21, 22);
+    g.addEdge(13, 13);
+
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+        EXPECT_EQ(connectedComponents(g, 1), connectedComponentsSV(g, threads));
+
+    EXPECT_TRUE(connectedComponentsSV(UGraph<int>()).empty());
+}
+
+TEST(ConcurrentDisjointSetForest, connectedComponentsSVRandom)
+{
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        // about as many edges as vertices give many components of all sizes
+        std::mt19937 rng(seed);
+        UGraph<unsigned int> g;
+        for (unsigned int v = 0; v < 2000; ++v)
+            g.addVertex(v);
+        for (int i = 0; i < 1800; ++i)
+            g.addEdge(rng() % 2000, rng() % 2000);
+
+        std::vector<unsigned int> exp = connectedComponents(g, 1);
+        for (unsigned int threads = 1; threads <= 4; ++threads)
+            EXPECT_EQ(exp, connectedComponentsSV(g, threads));
+    }
+}
@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for the incremental connectivity index.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <map>
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/ugraph.hpp"
+#include "ugraph/lbl_ugraph.hpp"
+#include "ugraph/conn_index.hpp"
+
+
+typedef UGraph<char> CharGraph;
+typedef EdgeLblUGraph<int, int> IntIntGraph;
+
+
+// a listener counting notifications
+struct CountingListener : UGraphListener {
+    size_t vertices = 0;
+    size_t edges = 0;
+
+    void onVertexAdded(UInt) override { ++vertices; }
+    void onEdgeAdded(UInt, UInt) override { ++edges; }
+};
+
+
+TEST(ConnectivityIndex, listeners1)
+{
+    CharGraph g;
+    g.addEdge('a', 'b');
+
+    CountingListener l;
+    g.addListener(&l);
+    g.addListener(&l);                  // added once only
+    g.addEdge('a', 'c');
+    g.addEdge('c', 'a');                // not a new edge
+    g.addVertex('d');
+    g.addVertex('b');                   // not a new vertex
+    g.addEdge('e', 'e');
+    EXPECT_EQ(3, l.vertices);
+    EXPECT_EQ(2, l.edges);
+
+    // copies have no listeners
+    CharGraph g2 = g;
+    g2.addEdge('x', 'y');
+    EXPECT_EQ(3, l.vertices);
+
+    g.removeListener(&l);
+    g.addEdge('x', 'y');
+    EXPECT_EQ(3, l.vertices);
+    EXPECT_EQ(2, l.edges);
+}
+
+TEST(ConnectivityIndex, incremental1)
+{
+    CharGraph g;
+    g.addEdge('a', 'b');
+    g.addEdge('c', 'd');
+    g.addVertex('e');
+
+    ConnectivityIndex<CharGraph> ci(g);
+    EXPECT_EQ(3, ci.getComponentsNum());
+    EXPECT_TRUE(ci.connected('a', 'b'));
+    EXPECT_FALSE(ci.connected('a', 'c'));
+    EXPECT_EQ(ci.componentOf('c'), ci.componentOf('d'));
+    EXPECT_EQ(2, ci.getComponentSize('a'));
+    EXPECT_EQ(1, ci.getComponentSize('e'));
+    EXPECT_THROW(ci.connected('a', 'z'), std::invalid_argument);
+
+    g.addEdge('b', 'c');
+    g.addEdge('f', 'e');
+    EXPECT_EQ(2, ci.getComponentsNum());
+    EXPECT_TRUE(ci.connected('a', 'd'));
+    EXPECT_TRUE(ci.connected('f', 'e'));
+    EXPECT_FALSE(ci.connected('d', 'e'));
+    EXPECT_EQ(4, ci.getComponentSize('d'));
+
+    std::map<unsigned int, size_t> sizes = ci.componentSizes();
+    ASSERT_EQ(2, sizes.size());
+    EXPECT_EQ(4, sizes[ci.componentOf('a')]);
+    EXPECT_EQ(2, sizes[ci.componentOf('f')]);
+}
+
+TEST(ConnectivityIndex, detach1)
+{
+    CharGraph g;
+    g.addEdge('a', 'b');
+    {
+        ConnectivityIndex<CharGraph> ci(g);
+        EXPECT_EQ(1, ci.getComponentsNum());
+    }
+
+    // the destroyed index is no longer notified
+    g.addEdge('c', 'd');
+    ConnectivityIndex<CharGraph> ci(g);
+    EXPECT_EQ(2, ci.getComponentsNum());
+}
+
+TEST(ConnectivityIndex, random1)
+{
+    // labeled graphs notify the index too; batches of edges alternate with
+    // checks against a rebuild from scratch
+    std::mt19937 rng(5);
+    IntIntGraph g;
+    for (int v = 0; v < 500; ++v)
+        g.addVertex(v);
+
+    ConnectivityIndex<IntIntGraph> ci(g, 2);
+    for (int batch = 0; batch < 10; ++batch)
+    {
+        for (int i = 0; i < 50; ++i)
+            g.addLblEdge(int(rng() % 600), int(rng() % 600), 1);
+
+        std::vector<unsigned int> comps = connectedComponents(g, 1);
+        ConnectivityIndex<IntIntGraph> cold(g, 3);
+        EXPECT_EQ(cold.getComponentsNum(), ci.getComponentsNum());
+        EXPECT_EQ(cold.componentSizes().size(), ci.componentSizes().size());
+        for (int i = 0; i < 200; ++i)
+        {
+            int u = g.getVertexById(rng() % g.getVerticesNum());
+            int v = g.getVertexById(rng() % g.getVerticesNum());
+            EXPECT_EQ(comps[g.getVertexId(u)] == comps[g.getVertexId(v)],
+                      ci.connected(u, v));
+            EXPECT_EQ(cold.getComponentSize(u), ci.getComponentSize(u));
+        }
+    }
+}
+
+TEST(ConnectivityIndex, removal1)
+{
+    CharGraph g;
+    g.addEdge('a', 'b');
+    g.addEdge('b', 'c');
+    g.addEdge('d', 'e');
+
+    ConnectivityIndex<CharGraph> ci(g);
+    EXPECT_TRUE(ci.connected('a', 'c'));
+
+    g.removeEdge('b', 'c');
+    EXPECT_TRUE(ci.isStale());
+    g.addEdge('c', 'd');                // ignored until the rebuild
+    EXPECT_FALSE(ci.connected('a', 'c'));
+    EXPECT_TRUE(ci.connected('c', 'e'));
+    EXPECT_FALSE(ci.isStale());
+    EXPECT_EQ(2, ci.getComponentsNum());
+
+    // IDs are renumbered by the removal
+    g.removeVertex('a');
+    EXPECT_EQ(2, ci.getComponentsNum());
+    EXPECT_EQ(1, ci.getComponentSize('b'));
+    EXPECT_EQ(3, ci.getComponentSize('e'));
+    g.addEdge('b', 'e');
+    EXPECT_EQ(1, ci.getComponentsNum());
+}
+
+TEST(ConnectivityIndex, tombstones1)
+{
+    CharGraph g;
+    g.setTombstoneMode(true);
+    g.addEdge('a', 'b');
+    g.addEdge('b', 'c');
+    g.addEdge('d', 'e');
+    g.addVertex('f');
+
+    ConnectivityIndex<CharGraph> ci(g);
+    EXPECT_EQ(3, ci.getComponentsNum());
+
+    // tombstones are not components
+    g.removeVertex('b');
+    g.removeVertex('f');
+    EXPECT_EQ(3, ci.getComponentsNum());
+    EXPECT_EQ(3, ci.componentSizes().size());
+    EXPECT_FALSE(ci.connected('a', 'c'));
+
+    // a revived vertex is a component again
+    g.addVertex('f');
+    EXPECT_EQ(4, ci.getComponentsNum());
+    g.addEdge('f', 'a');
+    EXPECT_EQ(3, ci.getComponentsNum());
+
+    // compaction renumbers vertices
+    g.compact();
+    EXPECT_TRUE(ci.isStale());
+    EXPECT_EQ(3, ci.getComponentsNum());
+    EXPECT_TRUE(ci.connected('a', 'f'));
+    EXPECT_EQ(2, ci.getComponentSize('e'));
+}
@@ -0,0 +1,191 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for the binary CSR graph file format.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/csr_file.hpp"
+#include "ugraph/ugraph_algos.hpp"
+
+#define GR_OUT_DIR "./"
+
+
+TEST(CsrFile, simplest)
+{
+}
+
+
+typedef UGraph<int> IntGraph;
+typedef CsrUGraph<int> CsrIntGraph;
+typedef EdgeLblUGraph<int, double> IntDblGraph;
+typedef CsrEdgeLblUGraph<int, double> CsrIntDblGraph;
+
+
+// aux method collecting edges of a graph
+template <typename Graph>
+static std::set<std::pair<int, int>> getEdgeSet(const Graph& g)
+{
+    std::set<std::pair<int, int>> res;
+    typename Graph::EdgeIterPair es = g.getEdges();
+    for (auto it = es.first; it != es.second; ++it)
+        res.insert({it->first, it->second});
+    return res;
+}
+
+
+TEST(CsrFile, writeMap1)
+{
+    IntGraph g;
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 2);
+    g.addEdge(-5, 4);
+    g.addVertex(7);
+    CsrIntGraph cg(g);
+
+    writeCsrFile(GR_OUT_DIR "test1.csr", cg);
+    CsrIntGraph mg = mapCsrFile<int>(GR_OUT_DIR "test1.csr");
+
+    EXPECT_EQ(cg.getVerticesNum(), mg.getVerticesNum());
+    EXPECT_EQ(cg.getEdgesNum(), mg.getEdgesNum());
+    EXPECT_EQ(getEdgeSet(cg), getEdgeSet(mg));
+    EXPECT_TRUE(mg.isVertexExists(7));
+    EXPECT_TRUE(mg.isEdgeExists(4, -5));
+    EXPECT_FALSE(mg.isEdgeExists(1, 4));
+
+    // a copy keeps the mapping alive
+    CsrIntGraph copy = mg;
+    mg = CsrIntGraph();
+    EXPECT_EQ(0, mg.getVerticesNum());
+    EXPECT_EQ(getEdgeSet(cg), getEdgeSet(copy));
+
+    // an empty graph
+    writeCsrFile(GR_OUT_DIR "test2.csr", CsrIntGraph());
+    EXPECT_EQ(0, mapCsrFile<int>(GR_OUT_DIR "test2.csr").getEdgesNum());
+}
+
+
+// MST algorithms must accept a mapped graph directly.
+TEST(CsrFile, writeMapLbl1)
+{
+    IntDblGraph g;
+    g.addLblEdge(1, 2, 4.5);
+    g.addLblEdge(2, 3, 8);
+    g.addLblEdge(2, 8, 11);
+    g.addLblEdge(3, 4, 7);
+    g.addLblEdge(3, 9, 2);
+    g.addLblEdge(3, 6, 4);
+    g.addLblEdge(4, 5, 9);
+    g.addLblEdge(4, 6, 14);
+    g.addLblEdge(5, 6, 10);
+    g.addLblEdge(6, 7, 2);
+    g.addLblEdge(7, 8, 1);
+    g.addLblEdge(7, 9, 6);
+    g.addLblEdge(8, 1, 8);
+    g.addLblEdge(8, 9, 7);
+    g.addEdge(9, 10);
+    CsrIntDblGraph cg(g);
+
+    writeCsrFile(GR_OUT_DIR "test3.csr", cg);
+    CsrIntDblGraph mg = mapCsrLblFile<int, double>(GR_OUT_DIR "test3.csr");
+
+    EXPECT_EQ(getEdgeSet(cg), getEdgeSet(mg));
+    double lbl;
+    EXPECT_TRUE(mg.getLabel(2, 1, lbl));
+    EXPECT_EQ(4.5, lbl);
+    EXPECT_FALSE(mg.getLabel(9, 10, lbl));
+
+    g.addLblEdge(9, 10, 1);
+    CsrIntDblGraph cg2(g);
+    writeCsrFile(GR_OUT_DIR "test3.csr", cg2);
+    mg = mapCsrLblFile<int, double>(GR_OUT_DIR "test3.csr");
+    EXPECT_EQ(findMSTKruskal(g), findMSTKruskal(mg));
+    EXPECT_EQ(findMSTKruskal(g).size(), findMSTPrim(mg).size());
+
+    // labels may be ignored
+    EXPECT_EQ(getEdgeSet(cg2), getEdgeSet(mapCsrFile<int>(GR_OUT_DIR "test3.csr")));
+}
+
+
+TEST(CsrFile, badFiles1)
+{
+    EXPECT_THROW(mapCsrFile<int>(GR_OUT_DIR "no_such_file.csr"),
+                 std::invalid_argument);
+
+    {
+        std::ofstream f(GR_OUT_DIR "test4.csr");
+        f << "not a graph file at all, but long enough to hold a header..."
+             "................................................................";
+    }
+    EXPECT_THROW(mapCsrFile<int>(GR_OUT_DIR "test4.csr"), std::invalid_argument);
+
+    IntGraph g;
+    g.addEdge(1, 2);
+    writeCsrFile(GR_OUT_DIR "test5.csr", CsrIntGraph(g));
+    EXPECT_THROW(mapCsrFile<long long>(GR_OUT_DIR "test5.csr"),
+                 std::invalid_argument);
+    EXPECT_THROW((mapCsrLblFile<int, int>(GR_OUT_DIR "test5.csr")),
+                 std::invalid_argument);
+}
+
+// aux method rewriting the header of the CSR file \a fn by \a fix
+template <typename Fix>
+static void corruptCsrHeader(const char* fn, Fix fix)
+{
+    std::fstream f(fn, std::ios::in | std::ios::out | std::ios::binary);
+    CsrFileHeader h;
+    f.read(reinterpret_cast<char*>(&h), sizeof(h));
+    fix(h);
+    f.seekp(0);
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+}
+
+TEST(CsrFile, badFiles2)
+{
+    // counts making sizes of sections wrap to small values
+    IntDblGraph g;
+    g.addLblEdge(1, 2, 0.5);
+    g.addLblEdge(2, 3, 1.5);
+
+    writeCsrFile(GR_OUT_DIR "test6.csr", CsrIntDblGraph(g));
+    corruptCsrHeader(GR_OUT_DIR "test6.csr", [](CsrFileHeader& h)
+                     { h.verticesNum = std::uint64_t(1) << 62; });
+    EXPECT_THROW(mapCsrFile<int>(GR_OUT_DIR "test6.csr"),
+                 std::invalid_argument);
+
+    writeCsrFile(GR_OUT_DIR "test7.csr", CsrIntDblGraph(g));
+    corruptCsrHeader(GR_OUT_DIR "test7.csr", [](CsrFileHeader& h)
+                     { h.verticesNum = std::uint64_t(-1); });
+    EXPECT_THROW(mapCsrFile<int>(GR_OUT_DIR "test7.csr"),
+                 std::invalid_argument);
+
+    writeCsrFile(GR_OUT_DIR "test8.csr", CsrIntDblGraph(g));
+    corruptCsrHeader(GR_OUT_DIR "test8.csr", [](CsrFileHeader& h)
+                     { h.adjNum = std::uint64_t(1) << 62; });
+    EXPECT_THROW(mapCsrFile<int>(GR_OUT_DIR "test8.csr"),
+                 std::invalid_argument);
+
+    writeCsrFile(GR_OUT_DIR "test9.csr", CsrIntDblGraph(g));
+    corruptCsrHeader(GR_OUT_DIR "test9.csr", [](CsrFileHeader& h)
+                     { h.adjNum = std::uint64_t(1) << 61; });
+    EXPECT_THROW((mapCsrLblFile<int, double>(GR_OUT_DIR "test9.csr")),
+                 std::invalid_argument);
+
+    // the intact file is fine
+    writeCsrFile(GR_OUT_DIR "test6.csr", CsrIntDblGraph(g));
+    EXPECT_EQ(2, (mapCsrLblFile<int, double>(GR_OUT_DIR "test6.csr"))
+                     .getEdgesNum());
+}
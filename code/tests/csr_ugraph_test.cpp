@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for CsrUGraph and CsrEdgeLblUGraph classes.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/ugraph_algos.hpp"
+#include "grviz/ugraph_dotwriter.hpp"
+
+#define GV_OUT_DIR "./"
+
+TEST(CsrUGraph, simplest)
+{
+}
+
+
+typedef UGraph<int> IntGraph;
+typedef CsrUGraph<int> CsrIntGraph;
+typedef EdgeLblUGraph<int, int> IntIntGraph;
+typedef CsrEdgeLblUGraph<int, int> CsrIntIntGraph;
+
+
+// Tests an empty graph for its default properties.
+TEST(CsrUGraph, emptyGraphProps)
+{
+    CsrIntGraph g;
+    EXPECT_EQ(0, g.getVerticesNum());
+    EXPECT_EQ(0, g.getEdgesNum());
+
+    CsrIntGraph::EdgeIterPair es = g.getEdges();
+    EXPECT_TRUE(es.first == es.second);
+}
+
+
+TEST(CsrUGraph, freeze1)
+{
+    IntGraph g;
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 2);
+    g.addEdge(1, 4);
+    g.addEdge(2, 4);
+    g.addEdge(4, 4);
+    g.addVertex(7);
+
+    CsrIntGraph cg(g);
+    EXPECT_EQ(5, cg.getVerticesNum());
+    EXPECT_EQ(6, cg.getEdgesNum());
+
+    EXPECT_TRUE(cg.isVertexExists(7));
+    EXPECT_FALSE(cg.isVertexExists(5));
+
+    EXPECT_TRUE(cg.isEdgeExists(1, 2));
+    EXPECT_TRUE(cg.isEdgeExists(2, 1));
+    EXPECT_TRUE(cg.isEdgeExists(4, 4));
+    EXPECT_FALSE(cg.isEdgeExists(3, 4));
+    EXPECT_FALSE(cg.isEdgeExists(1, 7));
+    EXPECT_FALSE(cg.isEdgeExists(1, 5));
+}
+
+// Edges of a frozen graph must be the same as edges of the original one.
+TEST(CsrUGraph, iterEdges1)
+{
+    IntGraph g;
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 2);
+    g.addEdge(1, 4);
+    g.addEdge(2, 4);
+    g.addEdge(4, 4);
+
+    std::set<IntGraph::Edge> expected;
+    IntGraph::EdgeIterPair es = g.getEdges();
+    for(IntGraph::EdgeIter it = es.first; it != es.second; ++it)
+        expected.insert({it->first, it->second});
+
+    CsrIntGraph cg(g);
+    std::set<CsrIntGraph::Edge> actual;
+    int c = 0;
+    CsrIntGraph::EdgeIterPair ces = cg.getEdges();
+    for(CsrIntGraph::EdgeIter it = ces.first; it != ces.second; ++it)
+    {
+        actual.insert(*it);
+        ++c;
+    }
+
+    EXPECT_EQ(6, c);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(CsrUGraph, adjEdges1)
+{
+    IntGraph g;
+    g.addEdge(1, 4);
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 4);
+
+    CsrIntGraph cg(g);
+    std::vector<int> ns;
+    CsrIntGraph::AdjListCIterPair adj = cg.getAdjEdges(1);
+    for(auto it = adj.first; it != adj.second; ++it)
+    {
+        EXPECT_EQ(1, it->first);
+        ns.push_back(it->second);
+    }
+
+    EXPECT_EQ(std::vector<int>({2, 3, 4}), ns);
+
+    adj = cg.getAdjEdges(10);
+    EXPECT_TRUE(adj.first == adj.second);
+}
+
+TEST(CsrEdgeLblUGraph, getEdgeLabel)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, 10);
+    g.addLblEdge(1, 3, 20);
+    g.addEdge(1, 4);
+    g.addLblEdge(2, 4, 40);
+
+    CsrIntIntGraph cg(g);
+    EXPECT_EQ(4, cg.getVerticesNum());
+    EXPECT_EQ(4, cg.getEdgesNum());
+
+    int lbl;
+    EXPECT_TRUE(cg.getLabel(1, 2, lbl));
+    EXPECT_EQ(10, lbl);
+
+    EXPECT_TRUE(cg.getLabel(3, 1, lbl));
+    EXPECT_EQ(20, lbl);
+
+    EXPECT_FALSE(cg.getLabel(1, 4, lbl));
+    EXPECT_FALSE(cg.getLabel(3, 4, lbl));
+
+    EXPECT_TRUE(cg.getLabel(4, 2, lbl));
+    EXPECT_EQ(40, lbl);
+
+    // labels are available right from adjacency iterators
+    int sum = 0;
+    CsrIntIntGraph::AdjListCIterPair adj = cg.getAdjEdges(1);
+    for (auto it = adj.first; it != adj.second; ++it)
+    {
+        if (cg.getAdjLabel(it, lbl))
+            sum += lbl;
+        EXPECT_EQ(it->second, cg.getVertexById(cg.getAdjVertexId(it)));
+    }
+    EXPECT_EQ(30, sum);
+
+    CsrEdgeLblUGraphDotWriter<int, int>::Type dw;
+    dw.write(GV_OUT_DIR "test1_csr.gv", cg, "Test CSR Graph");
+}
+
+// MST algorithms must give the same results for a frozen graph.
+TEST(CsrEdgeLblUGraph, mst1)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, 4);
+    g.addLblEdge(2, 3, 8);
+    g.addLblEdge(2, 8, 11);
+    g.addLblEdge(3, 4, 7);
+    g.addLblEdge(3, 9, 2);
+    g.addLblEdge(3, 6, 4);
+    g.addLblEdge(4, 5, 9);
+    g.addLblEdge(4, 6, 14);
+    g.addLblEdge(5, 6, 10);
+    g.addLblEdge(6, 7, 2);
+    g.addLblEdge(7, 8, 1);
+    g.addLblEdge(7, 9, 6);
+    g.addLblEdge(8, 1, 8);
+    g.addLblEdge(8, 9, 7);
+
+    CsrIntIntGraph cg(g);
+
+    std::set<IntIntGraph::Edge> mstK = findMSTKruskal(g);
+    EXPECT_EQ(8, mstK.size());
+    EXPECT_EQ(mstK, findMSTKruskal(cg));
+    EXPECT_EQ(mstK.size(), findMSTPrim(cg).size());
+}
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for VertexBitset and DenseUGraph classes and triangle
+/// counting.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <vector>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/dense_ugraph.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/ugraph_algos.hpp"
+
+
+typedef UGraph<int> IntGraph;
+typedef DenseUGraph<int> DenseIntGraph;
+typedef CsrUGraph<int> CsrIntGraph;
+
+
+TEST(VertexBitset, simplest)
+{
+    VertexBitset s(130);
+    EXPECT_EQ(130, s.getCapacity());
+    EXPECT_TRUE(s.isEmpty());
+    EXPECT_EQ(0, s.getWords().size() % 8);
+
+    s.set(0);
+    s.set(64);
+    s.set(129);
+    EXPECT_TRUE(s.test(64));
+    EXPECT_FALSE(s.test(65));
+    EXPECT_EQ(3, s.count());
+
+    EXPECT_EQ(0, s.findNext(0));
+    EXPECT_EQ(64, s.findNext(1));
+    EXPECT_EQ(129, s.findNext(65));
+
+    s.reset(0);
+    EXPECT_EQ(64, s.findNext(0));
+
+    std::vector<unsigned int> ids;
+    s.forEach([&ids](unsigned int id) { ids.push_back(id); });
+    EXPECT_EQ(std::vector<unsigned int>({64, 129}), ids);
+
+    VertexBitset t(130);
+    t.set(129);
+    t.set(5);
+    EXPECT_EQ(1, s.countCommon(t));
+
+    s.clear();
+    EXPECT_TRUE(s.isEmpty());
+    EXPECT_EQ(130, s.findNext(0));
+}
+
+
+TEST(DenseUGraph, freeze1)
+{
+    IntGraph g;
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 2);
+    g.addEdge(1, 4);
+    g.addEdge(2, 4);
+    g.addEdge(4, 4);
+    g.addVertex(7);
+
+    DenseIntGraph dg(g);
+    EXPECT_EQ(5, dg.getVerticesNum());
+    EXPECT_EQ(6, dg.getEdgesNum());
+
+    EXPECT_TRUE(dg.isVertexExists(7));
+    EXPECT_FALSE(dg.isVertexExists(5));
+
+    EXPECT_TRUE(dg.isEdgeExists(1, 2));
+    EXPECT_TRUE(dg.isEdgeExists(2, 1));
+    EXPECT_TRUE(dg.isEdgeExists(4, 4));
+    EXPECT_FALSE(dg.isEdgeExists(3, 4));
+    EXPECT_FALSE(dg.isEdgeExists(1, 7));
+    EXPECT_FALSE(dg.isEdgeExists(1, 5));
+
+    // common neighbours of 1 and 2 are 2 (a self-loop) and 4
+    EXPECT_EQ(2, dg.countCommonNeighbours(dg.getVertexId(1), dg.getVertexId(2)));
+    EXPECT_EQ(3, dg.getNeighboursNum(dg.getVertexId(1)));
+    EXPECT_EQ(0, dg.getNeighboursNum(dg.getVertexId(7)));
+}
+
+// Edges and adjacency of a frozen graph must be the same as of the original.
+TEST(DenseUGraph, iterEdges1)
+{
+    IntGraph g;
+    g.addEdge(1, 2);
+    g.addEdge(1, 3);
+    g.addEdge(2, 2);
+    g.addEdge(1, 4);
+    g.addEdge(2, 4);
+    g.addEdge(4, 4);
+    for (int i = 10; i < 200; i += 7)
+        g.addEdge(3, i);
+
+    std::set<IntGraph::Edge> expected;
+    IntGraph::EdgeIterPair es = g.getEdges();
+    for (IntGraph::EdgeIter it = es.first; it != es.second; ++it)
+        expected.insert({it->first, it->second});
+
+    DenseIntGraph dg = DenseIntGraph::fromGraph(CsrIntGraph(g));
+    std::set<DenseIntGraph::Edge> actual;
+    size_t c = 0;
+    DenseIntGraph::EdgeIterPair des = dg.getEdges();
+    for (DenseIntGraph::EdgeIter it = des.first; it != des.second; ++it)
+    {
+        actual.insert(*it);
+        ++c;
+    }
+
+    EXPECT_EQ(g.getEdgesNum(), c);
+    EXPECT_EQ(expected, actual);
+
+    std::vector<int> ns;
+    DenseIntGraph::AdjListCIterPair adj = dg.getAdjEdges(1);
+    for (auto it = adj.first; it != adj.second; ++it)
+    {
+        EXPECT_EQ(1, it->first);
+        EXPECT_EQ(it->second, dg.getVertexById(dg.getAdjVertexId(it)));
+        ns.push_back(it->second);
+    }
+    EXPECT_EQ(std::vector<int>({2, 3, 4}), ns);
+
+    adj = dg.getAdjEdges(5);
+    EXPECT_TRUE(adj.first == adj.second);
+}
+
+TEST(DenseUGraph, isDenseEnough1)
+{
+    EXPECT_FALSE(DenseIntGraph::isDenseEnough(0, 0));
+    EXPECT_TRUE(DenseIntGraph::isDenseEnough(100, 4950));
+    EXPECT_FALSE(DenseIntGraph::isDenseEnough(100000, 1000000));
+    EXPECT_FALSE(DenseIntGraph::isDenseEnough(10000, 10000));
+    EXPECT_TRUE(DenseIntGraph::isDenseEnough(10000, 100000));
+    EXPECT_TRUE(DenseIntGraph::isDenseEnough(100000, 100000, 0.0, size_t(1) << 31));
+    EXPECT_FALSE(DenseIntGraph::isDenseEnough(1000000, 1000000000000ULL));
+}
+
+
+// Counts triangles of a small graph by brute force.
+static size_t countTrianglesNaive(const IntGraph& g)
+{
+    std::vector<int> vs(g.getVertices().first, g.getVertices().second);
+    size_t res = 0;
+    for (size_t i = 0; i < vs.size(); ++i)
+        for (size_t j = i + 1; j < vs.size(); ++j)
+            for (size_t k = j + 1; k < vs.size(); ++k)
+                if (g.isEdgeExists(vs[i], vs[j]) && g.isEdgeExists(vs[j], vs[k])
+                        && g.isEdgeExists(vs[i], vs[k]))
+                    ++res;
+    return res;
+}
+
+TEST(DenseUGraph, triangles1)
+{
+    IntGraph g;
+    EXPECT_EQ(0, countTriangles(g));
+
+    // K_5 has 10 triangles, self-loops do not count
+    for (int i = 0; i < 5; ++i)
+        for (int j = i; j < 5; ++j)
+            g.addEdge(i, j);
+
+    EXPECT_EQ(10, countTrianglesSparse(g));
+    EXPECT_EQ(10, countTrianglesDense(DenseIntGraph(g)));
+    EXPECT_EQ(10, countTriangles(g));
+}
+
+// Both versions must agree with brute force for different densities, sizes
+// around word bounds and thread numbers.
+TEST(DenseUGraph, triangles2)
+{
+    std::mt19937 rng(1);
+    for (int n : { 3, 63, 64, 65, 130 })
+        for (double p : { 0.05, 0.3, 0.9 })
+        {
+            IntGraph g;
+            std::bernoulli_distribution coin(p);
+            for (int i = 0; i < n; ++i)
+            {
+                g.addVertex(i);
+                for (int j = i + 1; j < n; ++j)
+                    if (coin(rng))
+                        g.addEdge(i, j);
+            }
+
+            size_t expected = countTrianglesNaive(g);
+            DenseIntGraph dg(g);
+            for (unsigned int threads : { 1u, 3u })
+            {
+                EXPECT_EQ(expected, countTrianglesSparse(g, threads));
+                EXPECT_EQ(expected, countTrianglesDense(dg, threads));
+                EXPECT_EQ(expected, countTriangles(g, threads));
+                EXPECT_EQ(expected, countTriangles(CsrIntGraph(g), threads));
+                EXPECT_EQ(expected, countTriangles(dg, threads));
+            }
+        }
+}
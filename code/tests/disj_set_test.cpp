@@ -142,3 +142,90 @@ TEST(DisjointSetForest, pathCompression1)
     EXPECT_TRUE(nc->getPar() == na);
     EXPECT_TRUE(nd->getPar() == na);
 }
+
+
+TEST(FlatDisjointSetForest, makeSet1)
+{
+    FlatDisjointSetForest dsf;
+
+    FlatDisjointSetForest::Handle a = dsf.makeSet();
+    FlatDisjointSetForest::Handle b = dsf.makeSet();
+    EXPECT_EQ(0, a);
+    EXPECT_EQ(1, b);
+    EXPECT_EQ(a, dsf.getPar(a));
+    EXPECT_EQ(0, dsf.getRank(a));
+    EXPECT_EQ(a, dsf.find(a));
+
+    dsf.reserve(5);
+    EXPECT_EQ(5, dsf.getSize());
+    EXPECT_TRUE(dsf.isRepresentative(4));
+    EXPECT_EQ(5, dsf.makeSet());
+}
+
+
+// The same scenario as for DisjointSetForest::union1, a..h are 0..7.
+TEST(FlatDisjointSetForest, union1)
+{
+    FlatDisjointSetForest dsf;
+    dsf.reserve(8);
+    const unsigned int na = 0, nb = 1, nc = 2, nd = 3, ne = 4, nf = 5,
+                       ng = 6, nh = 7;
+
+    dsf.merge(nb, nf);
+    EXPECT_EQ(0, dsf.getRank(nb));
+    EXPECT_EQ(1, dsf.getRank(nf));
+    EXPECT_EQ(nf, dsf.find(nb));
+    EXPECT_FALSE(dsf.isRepresentative(nb));
+    EXPECT_TRUE(dsf.isRepresentative(nf));
+
+    dsf.merge(ng, nc);
+    dsf.merge(nc, nd);
+    dsf.merge(nc, nh);
+    EXPECT_EQ(1, dsf.getRank(nc));
+    EXPECT_EQ(nc, dsf.find(nh));
+    EXPECT_EQ(nc, dsf.find(nd));
+
+    dsf.merge(na, ne);
+    EXPECT_EQ(ne, dsf.find(na));
+
+    dsf.merge(na, nf);
+    EXPECT_EQ(2, dsf.getRank(nf));
+    EXPECT_EQ(nf, dsf.find(na));
+
+    dsf.merge(na, ng);
+    EXPECT_EQ(2, dsf.getRank(nf));
+    EXPECT_EQ(1, dsf.getRank(nc));
+    EXPECT_EQ(nf, dsf.getPar(nc));
+    EXPECT_EQ(nf, dsf.find(ng));
+
+    // merging the same set does nothing
+    EXPECT_EQ(nf, dsf.merge(nh, nb));
+    EXPECT_EQ(2, dsf.getRank(nf));
+}
+
+
+TEST(FlatDisjointSetForest, pathHalving1)
+{
+    FlatDisjointSetForest dsf(false);
+    dsf.reserve(8);
+
+    // builds a chain 0 -> 1 -> ... -> 7 by hand-picked merges of equal ranks
+    dsf.merge(0, 1);
+    dsf.merge(2, 3);
+    dsf.merge(1, 3);
+    dsf.merge(4, 5);
+    dsf.merge(6, 7);
+    dsf.merge(5, 7);
+    dsf.merge(3, 7);
+    EXPECT_EQ(1, dsf.getPar(0));
+    EXPECT_EQ(3, dsf.getPar(1));
+    EXPECT_EQ(7, dsf.getPar(3));
+    EXPECT_EQ(7, dsf.find(0));
+    EXPECT_EQ(1, dsf.getPar(0));           // no compression
+
+    dsf.setPathCompression(true);
+    EXPECT_EQ(7, dsf.find(0));
+    EXPECT_EQ(3, dsf.getPar(0));           // linked to the grandparent
+    EXPECT_EQ(3, dsf.getPar(1));           // skipped by halving
+    EXPECT_EQ(7, dsf.getPar(3));
+}
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for the dynamic minimum spanning forest.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <vector>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/lbl_ugraph.hpp"
+#include "ugraph/ugraph_algos.hpp"
+#include "ugraph/dyn_mst.hpp"
+#include "test_graphs.hpp"
+
+
+typedef EdgeLblUGraph<char, int> CharIntGraph;
+typedef EdgeLblUGraph<int, int> IntIntGraph;
+
+
+// returns the total weight of the edges \a es of the graph \a g
+template <typename Graph>
+static int getWeight(const Graph& g, const std::set<typename Graph::Edge>& es)
+{
+    int res = 0;
+    for (const auto& e : es)
+    {
+        int lbl;
+        g.getLabel(e.first, e.second, lbl);
+        res += lbl;
+    }
+    return res;
+}
+
+
+TEST(DynamicMST, build1)
+{
+    CharIntGraph g;
+    makeGraph1(g);
+
+    DynamicMST<CharIntGraph> mst(g);
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+    EXPECT_EQ(8, mst.getEdgesNum());
+    EXPECT_EQ(37, mst.getWeight());
+    EXPECT_TRUE(mst.isTreeEdge('g', 'h'));
+    EXPECT_FALSE(mst.isTreeEdge('b', 'h'));
+    EXPECT_FALSE(mst.isTreeEdge('a', 'z'));
+    EXPECT_TRUE(mst.connected('a', 'e'));
+}
+
+TEST(DynamicMST, updates1)
+{
+    CharIntGraph g;
+    makeGraph1(g);
+    DynamicMST<CharIntGraph> mst(g);
+
+    // a light edge replaces the heaviest one of its cycle
+    g.addLblEdge('a', 'e', 3);
+    EXPECT_TRUE(mst.isTreeEdge('a', 'e'));
+    EXPECT_FALSE(mst.isTreeEdge('d', 'e'));
+    EXPECT_EQ(31, mst.getWeight());
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+
+    // removing a tree edge brings the cheapest replacement
+    g.removeEdge('a', 'e');
+    EXPECT_EQ(37, mst.getWeight());
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+
+    // reweighting up and down
+    g.setLabel('g', 'h', 20);
+    EXPECT_FALSE(mst.isTreeEdge('g', 'h'));
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+    g.setLabel('b', 'h', 1);
+    EXPECT_TRUE(mst.isTreeEdge('b', 'h'));
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+    g.setLabel('b', 'h', 0);
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+    EXPECT_EQ(getWeight(g, mst.getEdges()), mst.getWeight());
+
+    // a bridge splits the forest; a new vertex makes a new tree
+    g.removeEdge('d', 'e');
+    g.removeEdge('e', 'f');
+    EXPECT_FALSE(mst.connected('a', 'e'));
+    g.addLblEdge('x', 'e', 5);
+    EXPECT_TRUE(mst.connected('x', 'e'));
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+
+    // removal of a vertex renumbers IDs
+    g.removeVertex('c');
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+    g.addLblEdge('e', 'i', 1);
+    EXPECT_TRUE(mst.connected('a', 'x'));
+    EXPECT_EQ(findMSTKruskal(g), mst.getEdges());
+    EXPECT_EQ(getWeight(g, mst.getEdges()), mst.getWeight());
+}
+
+TEST(DynamicMST, unlabeled1)
+{
+    CharIntGraph g;
+    g.addLblEdge('a', 'b', 1);
+    g.addEdge('b', 'c');
+
+    DynamicMST<CharIntGraph> mst(g);
+    EXPECT_EQ(1, mst.getEdgesNum());
+    g.addEdge('c', 'd');
+    EXPECT_FALSE(mst.connected('a', 'c'));
+
+    // labeling makes the edge count
+    g.addLblEdge('b', 'c', 2);
+    EXPECT_TRUE(mst.connected('a', 'c'));
+    EXPECT_EQ(3, mst.getWeight());
+}
+
+TEST(DynamicMST, random1)
+{
+    for (unsigned int seed = 1; seed <= 4; ++seed)
+    {
+        // few distinct weights give many ties
+        std::mt19937 rng(seed);
+        const int N = 60;
+        IntIntGraph g;
+        for (int i = 0; i < 150; ++i)
+            g.addLblEdge(int(rng() % N), int(rng() % N), int(rng() % 10));
+
+        DynamicMST<IntIntGraph> mst(g);
+        ASSERT_EQ(findMSTKruskal(g), mst.getEdges());
+
+        for (int step = 0; step < 400; ++step)
+        {
+            int u = int(rng() % N);
+            int v = int(rng() % N);
+            switch (rng() % 8)
+            {
+            case 0: case 1: case 2:
+                g.addLblEdge(u, v, int(rng() % 10));
+                break;
+            case 3: case 4:
+                g.setLabel(u, v, int(rng() % 10));
+                break;
+            case 5:
+                g.removeVertex(u);
+                break;
+            default:
+            {
+                // removes an existing edge, often a tree one
+                auto es = mst.getEdges();
+                if (!es.empty() && rng() % 2)
+                {
+                    auto it = es.begin();
+                    std::advance(it, rng() % es.size());
+                    g.removeEdge(it->first, it->second);
+                }
+                else if (g.getVerticesNum() > 0)
+                    g.removeEdge(u, v);
+            }
+            }
+
+            ASSERT_EQ(findMSTKruskal(g), mst.getEdges()) << "step " << step;
+            ASSERT_EQ(getWeight(g, mst.getEdges()), mst.getWeight());
+        }
+    }
+}
+
+TEST(DynamicMST, tombstones1)
+{
+    std::mt19937 rng(5);
+    const int N = 40;
+    IntIntGraph g;
+    g.setTombstoneMode(true);
+    for (int i = 0; i < 100; ++i)
+        g.addLblEdge(int(rng() % N), int(rng() % N), int(rng() % 10));
+
+    DynamicMST<IntIntGraph> mst(g);
+    for (int step = 0; step < 300; ++step)
+    {
+        int u = int(rng() % N);
+        int v = int(rng() % N);
+        switch (rng() % 6)
+        {
+        case 0: case 1:
+            g.addLblEdge(u, v, int(rng() % 10));
+            break;
+        case 2:
+            g.removeEdge(u, v);
+            break;
+        case 3: case 4:
+            g.removeVertex(u);
+            break;
+        default:
+            g.compact();
+        }
+
+        ASSERT_EQ(findMSTKruskal(g), mst.getEdges()) << "step " << step;
+        ASSERT_EQ(getWeight(g, mst.getEdges()), mst.getWeight());
+    }
+
+    // vertex nodes follow the compacted IDs
+    g.compact();
+    auto es = g.getEdges();
+    for (; es.first != es.second; ++es.first)
+        EXPECT_TRUE(mst.connected(es.first->first, es.first->second));
+}
@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for synthetic graph generators.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <tuple>
+#include <atomic>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/graph_gens.hpp"
+#include "ugraph/ugraph_algos.hpp"
+#include "ugraph/ugraph_par_algos.hpp"
+
+
+TEST(GraphGens, simplest)
+{
+}
+
+
+// aux method collecting generated edges in a sorted order
+template <typename Gen>
+static std::vector<GenEdge> sortedEdges(const Gen& gen, unsigned int threads)
+{
+    std::vector<GenEdge> es = collectGenEdges(gen, threads);
+    std::sort(es.begin(), es.end());
+    return es;
+}
+
+// aux method checking that edges do not depend on the number of threads
+template <typename Gen>
+static void checkReproducible(const Gen& gen)
+{
+    std::vector<GenEdge> es1 = sortedEdges(gen, 1);
+    EXPECT_EQ(es1, sortedEdges(gen, 3));
+    EXPECT_EQ(es1, sortedEdges(gen, 4));
+
+    // the same for graphs, including labels of repeated edges
+    GenGraph g1 = makeGenGraph(gen, 1);
+    for (unsigned int threads : { 3, 8 })
+    {
+        GenGraph g = makeGenGraph(gen, threads);
+        ASSERT_EQ(g1.getEdgesNum(), g.getEdgesNum());
+        for (auto es = g1.getEdges(); es.first != es.second; ++es.first)
+        {
+            double lbl1, lbl;
+            ASSERT_TRUE(g1.getLabel(es.first->first, es.first->second, lbl1));
+            ASSERT_TRUE(g.getLabel(es.first->first, es.first->second, lbl));
+            ASSERT_EQ(lbl1, lbl);
+        }
+    }
+
+    for (const GenEdge& e : es1)
+    {
+        ASSERT_LT(std::get<0>(e), gen.getVerticesNum());
+        ASSERT_LT(std::get<1>(e), gen.getVerticesNum());
+    }
+}
+
+
+TEST(GraphGens, erdosRenyi1)
+{
+    ErdosRenyiGen gen(2000, 0.01, 42);
+    checkReproducible(gen);
+
+    // the expected number of edges is 19990, sigma is about 140
+    std::vector<GenEdge> es = collectGenEdges(gen, 2);
+    EXPECT_NEAR(19990.0, double(es.size()), 1000.0);
+
+    std::set<std::pair<unsigned int, unsigned int>> pairs;
+    for (const GenEdge& e : es)
+    {
+        EXPECT_GT(std::get<0>(e), std::get<1>(e));
+        pairs.insert({std::get<0>(e), std::get<1>(e)});
+    }
+    EXPECT_EQ(es.size(), pairs.size());
+
+    // another seed gives another graph
+    EXPECT_NE(sortedEdges(gen, 1), sortedEdges(ErdosRenyiGen(2000, 0.01, 43), 1));
+
+    EXPECT_EQ(10 * 9 / 2, collectGenEdges(ErdosRenyiGen(10, 1.0, 1)).size());
+    EXPECT_TRUE(collectGenEdges(ErdosRenyiGen(10, 0.0, 1)).empty());
+    EXPECT_THROW(ErdosRenyiGen(10, 1.5, 1), std::invalid_argument);
+}
+
+
+TEST(GraphGens, rmat1)
+{
+    RMatGen gen(12, 100000, 7);
+    EXPECT_EQ(4096, gen.getVerticesNum());
+    checkReproducible(gen);
+    EXPECT_EQ(100000, collectGenEdges(gen).size());
+
+    // the vertex 0 gets the most edges
+    GenGraph g = makeGenGraph(gen);
+    EXPECT_EQ(4096, g.getVerticesNum());
+    EXPECT_GT(g.getDegree(0), g.getDegree(4095));
+}
+
+
+TEST(GraphGens, barabasiAlbert1)
+{
+    BarabasiAlbertGen gen(5000, 3, 11);
+    checkReproducible(gen);
+
+    std::vector<GenEdge> es = collectGenEdges(gen);
+    EXPECT_EQ(15000, es.size());
+
+    // edges go to earlier vertices only
+    for (const GenEdge& e : es)
+        ASSERT_LE(std::get<1>(e), std::get<0>(e));
+
+    // early vertices become hubs
+    GenGraph g = makeGenGraph(gen);
+    EXPECT_GT(g.getDegree(0) + g.getDegree(1) + g.getDegree(2), 100);
+}
+
+
+TEST(GraphGens, grid1)
+{
+    GridGen gen2(10, 7, 1, 3);
+    checkReproducible(gen2);
+    EXPECT_EQ(9 * 7 + 10 * 6, collectGenEdges(gen2).size());
+
+    GridGen gen3(5, 4, 3, 3);
+    EXPECT_EQ(60, gen3.getVerticesNum());
+    EXPECT_EQ(4 * 4 * 3 + 5 * 3 * 3 + 5 * 4 * 2, collectGenEdges(gen3, 2).size());
+
+    GenGraph g = makeGenGraph(gen3);
+    EXPECT_TRUE(g.isEdgeExists(0, 1));
+    EXPECT_TRUE(g.isEdgeExists(0, 5));
+    EXPECT_TRUE(g.isEdgeExists(0, 20));
+    EXPECT_FALSE(g.isEdgeExists(4, 5));
+
+    std::vector<unsigned int> comps = connectedComponents(g);
+    EXPECT_EQ(0, *std::max_element(comps.begin(), comps.end()));
+}
+
+
+TEST(GraphGens, randomGeometric1)
+{
+    RandomGeometricGen gen(1500, 0.05, 5);
+    checkReproducible(gen);
+
+    // compares with the brute force
+    std::set<std::pair<unsigned int, unsigned int>> expected;
+    for (unsigned int u = 0; u < 1500; ++u)
+        for (unsigned int v = u + 1; v < 1500; ++v)
+        {
+            double ux, uy, vx, vy;
+            gen.getPoint(u, ux, uy);
+            gen.getPoint(v, vx, vy);
+            if ((ux - vx) * (ux - vx) + (uy - vy) * (uy - vy) <= 0.05 * 0.05)
+                expected.insert({u, v});
+        }
+
+    std::set<std::pair<unsigned int, unsigned int>> actual;
+    for (const GenEdge& e : collectGenEdges(gen))
+    {
+        EXPECT_LE(std::get<2>(e), 0.05);
+        actual.insert(std::minmax(std::get<0>(e), std::get<1>(e)));
+    }
+    EXPECT_EQ(expected, actual);
+}
+
+
+// returns the total weight of the edges \a es of the graph \a g
+static double getWeight(const GenGraph& g, const std::set<GenGraph::Edge>& es)
+{
+    double sum = 0;
+    for (const GenGraph::Edge& e : es)
+    {
+        double lbl = 0;
+        EXPECT_TRUE(g.getLabel(e.first, e.second, lbl));
+        sum += lbl;
+    }
+    return sum;
+}
+
+// Generated graphs are valid inputs for the MST algorithms, and both of them
+// find trees of the same weight with fractional labels too.
+TEST(GraphGens, mst1)
+{
+    GenGraph g = makeGenGraph(GridGen(20, 20, 1, 9));
+    std::set<GenGraph::Edge> mstK = findMSTKruskal(g);
+    std::set<GenGraph::Edge> mstP = findMSTPrim(g);
+    EXPECT_EQ(399, mstK.size());
+    EXPECT_EQ(399, mstP.size());
+    EXPECT_DOUBLE_EQ(getWeight(g, mstK), getWeight(g, mstP));
+
+    GenGraph rg = makeGenGraph(RandomGeometricGen(300, 0.15, 3));
+    mstK = findMSTKruskal(rg);
+    mstP = findMSTPrim(rg);
+    EXPECT_EQ(mstK.size(), mstP.size());
+    EXPECT_DOUBLE_EQ(getWeight(rg, mstK), getWeight(rg, mstP));
+}
+
+
+// Edges are delivered in chunks from several threads.
+TEST(GraphGens, streaming1)
+{
+    std::atomic<size_t> total(0), chunks(0);
+    RMatGen(10, 200000, 1).generate(
+        [&](const GenEdge*, size_t n, unsigned int tid)
+        {
+            EXPECT_LT(tid, 4);
+            EXPECT_LE(n, size_t(GraphGen::CHUNK_SIZE));
+            total += n;
+            ++chunks;
+        }, 4);
+
+    EXPECT_EQ(200000, total.load());
+    EXPECT_GE(chunks.load(), 200000 / GraphGen::CHUNK_SIZE);
+}
@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for loaders of graphs from text files.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <tuple>
+#include <string>
+#include <random>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/graph_loader.hpp"
+#include "grviz/ugraph_dotwriter.hpp"
+
+#define GV_OUT_DIR "./"
+
+
+TEST(GraphLoader, simplest)
+{
+}
+
+
+typedef EdgeLblUGraph<int, int> IntIntGraph;
+typedef GraphTextParser<int, int> IntIntParser;
+
+
+// aux method collecting labeled edges of a graph; -1 stands for no label
+template <typename Graph, typename Vertex, typename EdgeLbl>
+static std::set<std::tuple<Vertex, Vertex, EdgeLbl>> getLblEdges(const Graph& g,
+                                                                 EdgeLbl noLbl)
+{
+    std::set<std::tuple<Vertex, Vertex, EdgeLbl>> res;
+    typename Graph::EdgeIterPair es = g.getEdges();
+    for (auto it = es.first; it != es.second; ++it)
+    {
+        EdgeLbl lbl = noLbl;
+        g.getLabel(it->first, it->second, lbl);
+        res.insert(std::make_tuple(it->first, it->second, lbl));
+    }
+    return res;
+}
+
+static std::set<std::tuple<int, int, int>> getLblEdges(const IntIntGraph& g)
+{
+    return getLblEdges<IntIntGraph, int, int>(g, -1);
+}
+
+
+TEST(GraphLoader, edgeList1)
+{
+    std::string text =
+        "# comment\n"
+        "1 2 10\n"
+        "3\t1 20\r\n"
+        "\n"
+        "2 1 15\n"
+        "  4 4 -5  \n"
+        "% another comment\n"
+        "1 5\n"
+        "5 1 50\n"
+        "7\n"
+        "-3 2 2147483647";
+
+    IntIntGraph g0;
+    g0.addLblEdge(1, 2, 10);
+    g0.addLblEdge(3, 1, 20);
+    g0.addLblEdge(4, 4, -5);
+    g0.addEdge(1, 5);
+    g0.addLblEdge(5, 1, 50);
+    g0.addVertex(7);
+    g0.addLblEdge(-3, 2, 2147483647);
+
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+    {
+        IntIntGraph g = IntIntParser::parse(text.data(), text.size(),
+                                            IntIntParser::EDGE_LIST, threads);
+        EXPECT_EQ(g0.getVerticesNum(), g.getVerticesNum());
+        EXPECT_TRUE(g.isVertexExists(7));
+        EXPECT_EQ(getLblEdges(g0), getLblEdges(g));
+    }
+}
+
+
+TEST(GraphLoader, edgeListErrors1)
+{
+    for (const char* text : {"1 2 3 4\n", "1 x 2\n", "1 2 2147483648\n",
+                             "99999999999 1\n", "1 2 3.5\n"})
+    {
+        EXPECT_THROW(IntIntParser::parse(text, std::strlen(text),
+                                         IntIntParser::EDGE_LIST, 1),
+                     std::invalid_argument) << text;
+    }
+
+    // an error found by a worker thread reaches the caller
+    std::string text;
+    for (int i = 0; i < 10000; ++i)
+        text += "1 2 3\n";
+    text += "1 2 x\n";
+    EXPECT_THROW(IntIntParser::parse(text.data(), text.size(),
+                                     IntIntParser::EDGE_LIST, 4),
+                 std::invalid_argument);
+
+    EXPECT_THROW((loadEdgeListFile<int, int>(GV_OUT_DIR "no_such_file.txt")),
+                 std::invalid_argument);
+}
+
+
+TEST(GraphLoader, parseValues1)
+{
+    long long ll;
+    const char* s = "-9223372036854775808";
+    EXPECT_TRUE(TextValueParser::parseValue(s, s + std::strlen(s), ll));
+    EXPECT_EQ(std::numeric_limits<long long>::min(), ll);
+
+    unsigned int u;
+    s = "-1";
+    EXPECT_FALSE(TextValueParser::parseValue(s, s + 2, u));
+    s = "4294967295";
+    EXPECT_TRUE(TextValueParser::parseValue(s, s + std::strlen(s), u));
+    EXPECT_EQ(4294967295u, u);
+
+    double d;
+    s = "2.5e-3";
+    EXPECT_TRUE(TextValueParser::parseValue(s, s + std::strlen(s), d));
+    EXPECT_DOUBLE_EQ(0.0025, d);
+    s = "2.5x";
+    EXPECT_FALSE(TextValueParser::parseValue(s, s + std::strlen(s), d));
+}
+
+
+// A graph dumped by the DOT-writer must be loaded back as it was.
+TEST(GraphLoader, dotRoundTrip1)
+{
+    IntIntGraph g0;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 3000; ++i)
+    {
+        int s = int(rng() % 500) - 100, d = int(rng() % 500) - 100;
+        if (i % 7 == 0)
+            g0.addEdge(s, d);
+        else
+            g0.addLblEdge(s, d, int(rng() % 100) - 50);
+    }
+    g0.addVertex(10000);
+
+    EdgeLblUGraphDotWriter<int, int>::Type dw;
+    dw.write(GV_OUT_DIR "test_load.gv", g0, "Test \"Graph\"");
+
+    for (unsigned int threads : {1, 3})
+    {
+        IntIntGraph g = loadDotFile<int, int>(GV_OUT_DIR "test_load.gv", threads);
+        EXPECT_EQ(g0.getVerticesNum(), g.getVerticesNum());
+        EXPECT_EQ(g0.getEdgesNum(), g.getEdgesNum());
+        EXPECT_EQ(getLblEdges(g0), getLblEdges(g));
+    }
+}
+
+
+TEST(GraphLoader, dotStrings1)
+{
+    typedef EdgeLblUGraph<std::string, std::string> StrGraph;
+    std::string text =
+        "graph G {\n"
+        "    label=\"Test\";\n"
+        "    node [width=0.5];\n"
+        "\"a b\"\n"
+        "c [color=red];\n"
+        "\"a b\" -- c [label=\"say \\\"hi\\\"\", color=blue];\n"
+        "c -- d\n"
+        "d -- e [ label = plain ]\n"
+        "}\n";
+
+    StrGraph g = GraphTextParser<std::string, std::string>::parse(
+                text.data(), text.size(),
+                GraphTextParser<std::string, std::string>::DOT, 2);
+    EXPECT_EQ(4, g.getVerticesNum());
+    EXPECT_EQ(3, g.getEdgesNum());
+
+    std::string lbl;
+    EXPECT_TRUE(g.getLabel("c", "a b", lbl));
+    EXPECT_EQ("say \"hi\"", lbl);
+    EXPECT_FALSE(g.getLabel("c", "d", lbl));
+    EXPECT_TRUE(g.getLabel("d", "e", lbl));
+    EXPECT_EQ("plain", lbl);
+
+    std::string bad = "a -- b [label=]\n";
+    EXPECT_THROW((GraphTextParser<std::string, std::string>::parse(
+                      bad.data(), bad.size(),
+                      GraphTextParser<std::string, std::string>::DOT, 1)),
+                 std::invalid_argument);
+}
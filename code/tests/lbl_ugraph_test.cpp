@@ -12,6 +12,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "ugraph/lbl_ugraph.hpp"
@@ -59,3 +61,206 @@ TEST(EdgeLblUGraph, getEdgeLabel)
 }
 
 
+
+
+TEST(EdgeLblUGraph, labelHashMap)
+{
+    EdgeLabelHashMap<int> m;
+    int lbl;
+    EXPECT_FALSE(m.find(1, 2, lbl));
+
+    // enough labels to make the table grow several times
+    for (unsigned int i = 0; i < 1000; ++i)
+        EXPECT_TRUE(m.insert(i, i + 1, int(i) * 10));
+    EXPECT_EQ(1000, m.getSize());
+    EXPECT_FALSE(m.insert(2, 1, 5));            // the same as {1, 2}
+
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(m.find(i + 1, i, lbl));
+        ASSERT_EQ(int(i) * 10, lbl);
+    }
+    EXPECT_FALSE(m.find(0, 2, lbl));
+    EXPECT_FALSE(m.find(5000, 5001, lbl));
+}
+
+
+TEST(EdgeLblUGraph, getAdjLabel)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, 10);
+    g.addLblEdge(1, 3, 20);
+    g.addEdge(1, 4);
+
+    int sum = 0, unlabeled = 0;
+    IntIntGraph::AdjListCIterPair adj = g.getAdjEdges(1);
+    for (auto it = adj.first; it != adj.second; ++it)
+    {
+        int lbl;
+        if (g.getAdjLabel(it, lbl))
+            sum += lbl;
+        else
+            ++unlabeled;
+        EXPECT_EQ(it->second, g.getVertexById(g.getAdjVertexId(it)));
+    }
+
+    EXPECT_EQ(30, sum);
+    EXPECT_EQ(1, unlabeled);
+
+    int lbl;
+    EXPECT_TRUE(g.getLabelById(g.getVertexId(3), g.getVertexId(1), lbl));
+    EXPECT_EQ(20, lbl);
+}
+
+
+TEST(EdgeLblUGraph, fromEdges1)
+{
+    std::vector<IntIntGraph::LblEdge> es = {
+        std::make_tuple(1, 2, 10), std::make_tuple(3, 1, 20),
+        std::make_tuple(2, 1, 15), std::make_tuple(2, 2, 5),
+        std::make_tuple(1, 3, 25), std::make_tuple(4, 2, 40)
+    };
+
+    IntIntGraph g0;
+    for (const IntIntGraph::LblEdge& e : es)
+        g0.addLblEdge(std::get<0>(e), std::get<1>(e), std::get<2>(e));
+
+    for (unsigned int threads = 1; threads <= 3; ++threads)
+    {
+        IntIntGraph g = IntIntGraph::fromEdges(es.data(), es.size(), threads);
+        EXPECT_EQ(4, g.getVerticesNum());
+        EXPECT_EQ(4, g.getEdgesNum());
+
+        // the first label of a repeated edge wins
+        for (int s = 1; s <= 4; ++s)
+            for (int d = 1; d <= 4; ++d)
+            {
+                int lbl0 = -1, lbl = -1;
+                EXPECT_EQ(g0.getLabel(s, d, lbl0), g.getLabel(s, d, lbl));
+                EXPECT_EQ(lbl0, lbl);
+            }
+    }
+}
+
+
+TEST(EdgeLblUGraph, labelHashMapErase)
+{
+    // a small table has long probe clusters wrapping around the end
+    EdgeLabelHashMap<int> m;
+    std::vector<std::pair<unsigned int, unsigned int>> keys;
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        keys.push_back({i, i * 7 + 1});
+        m.insert(i, i * 7 + 1, int(i));
+    }
+
+    int lbl;
+    EXPECT_FALSE(m.erase(100, 200));
+    for (unsigned int i = 0; i < 12; i += 2)
+        EXPECT_TRUE(m.erase(keys[i].second, keys[i].first));
+    EXPECT_FALSE(m.erase(keys[0].first, keys[0].second));
+    EXPECT_EQ(6, m.getSize());
+
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+        EXPECT_EQ(i % 2 == 1, m.find(keys[i].first, keys[i].second, lbl));
+        if (i % 2 == 1)
+        {
+            EXPECT_EQ(int(i), lbl);
+        }
+    }
+
+    EXPECT_FALSE(m.assign(1, 8, 100));
+    EXPECT_TRUE(m.assign(0, 1, 200));
+    EXPECT_TRUE(m.find(8, 1, lbl));
+    EXPECT_EQ(100, lbl);
+    EXPECT_TRUE(m.find(0, 1, lbl));
+    EXPECT_EQ(200, lbl);
+    EXPECT_EQ(7, m.getSize());
+}
+
+TEST(EdgeLblUGraph, removal1)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, 12);
+    g.addLblEdge(1, 3, 13);
+    g.addLblEdge(3, 3, 33);
+    g.addLblEdge(3, 4, 34);
+    g.addEdge(2, 4);
+
+    int lbl;
+    EXPECT_TRUE(g.removeEdge(2, 1));
+    EXPECT_FALSE(g.getLabel(1, 2, lbl));
+    EXPECT_FALSE(g.removeEdge(1, 2));
+
+    // a re-added edge gets the new label
+    g.addLblEdge(1, 2, 21);
+    EXPECT_TRUE(g.getLabel(1, 2, lbl));
+    EXPECT_EQ(21, lbl);
+
+    EXPECT_TRUE(g.setLabel(2, 1, 22));
+    EXPECT_TRUE(g.getLabel(1, 2, lbl));
+    EXPECT_EQ(22, lbl);
+    EXPECT_TRUE(g.setLabel(2, 4, 24));
+    EXPECT_TRUE(g.getLabel(4, 2, lbl));
+    EXPECT_FALSE(g.setLabel(1, 4, 14));
+    EXPECT_FALSE(g.getLabel(1, 4, lbl));
+
+    // 4 has the last ID and takes the ID of 1, with its labels
+    EXPECT_TRUE(g.removeVertex(1));
+    EXPECT_EQ(3, g.getVerticesNum());
+    EXPECT_EQ(3, g.getEdgesNum());
+    EXPECT_FALSE(g.getLabel(1, 3, lbl));
+    ASSERT_TRUE(g.getLabel(3, 4, lbl));
+    EXPECT_EQ(34, lbl);
+    ASSERT_TRUE(g.getLabel(2, 4, lbl));
+    EXPECT_EQ(24, lbl);
+    ASSERT_TRUE(g.getLabel(3, 3, lbl));
+    EXPECT_EQ(33, lbl);
+
+    // the moved vertex 3 has a self-loop
+    g.addLblEdge(4, 4, 44);
+    EXPECT_TRUE(g.removeVertex(2));
+    ASSERT_TRUE(g.getLabel(3, 3, lbl));
+    EXPECT_EQ(33, lbl);
+    ASSERT_TRUE(g.getLabel(4, 4, lbl));
+    EXPECT_EQ(44, lbl);
+    ASSERT_TRUE(g.getLabel(4, 3, lbl));
+    EXPECT_EQ(34, lbl);
+    EXPECT_EQ(3, g.getEdgesNum());
+}
+
+// Tests labels with tombstones and compaction.
+TEST(EdgeLblUGraph, compact1)
+{
+    IntIntGraph g;
+    g.setTombstoneMode(true);
+    g.addLblEdge(1, 2, 12);
+    g.addLblEdge(1, 3, 13);
+    g.addLblEdge(3, 3, 33);
+    g.addLblEdge(3, 4, 34);
+    g.addLblEdge(2, 4, 24);
+
+    // no rekeying: 4 keeps its ID
+    EXPECT_TRUE(g.removeVertex(1));
+    EXPECT_EQ(3, g.getVertexId(4));
+    EXPECT_EQ(3, g.getEdgesNum());
+
+    int lbl;
+    EXPECT_FALSE(g.getLabel(1, 3, lbl));
+    g.compact();
+    EXPECT_EQ(0, g.getTombstonesNum());
+    EXPECT_EQ(3, g.getVerticesNum());
+    EXPECT_EQ(2, g.getVertexId(4));
+    ASSERT_TRUE(g.getLabel(4, 3, lbl));
+    EXPECT_EQ(34, lbl);
+    ASSERT_TRUE(g.getLabel(2, 4, lbl));
+    EXPECT_EQ(24, lbl);
+    ASSERT_TRUE(g.getLabel(3, 3, lbl));
+    EXPECT_EQ(33, lbl);
+
+    // a revived vertex has no old labels
+    g.addEdge(1, 2);
+    EXPECT_FALSE(g.getLabel(1, 2, lbl));
+    EXPECT_EQ(4, g.getEdgesNum());
+}
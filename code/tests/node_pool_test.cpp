@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for the node pool and graphs using it.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <map>
+#include <string>
+#include <memory>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/node_pool.hpp"
+#include "ugraph/ugraph.hpp"
+#include "ugraph/lbl_ugraph.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/ugraph_algos.hpp"
+
+
+typedef PoolAllocator<int> IntPoolAlloc;
+typedef UGraph<int, IntPoolAlloc> PoolIntGraph;
+typedef EdgeLblUGraph<int, int, IntPoolAlloc> PoolIntIntGraph;
+typedef EdgeLblUGraph<int, int> IntIntGraph;
+typedef unsigned int UInt;
+
+
+TEST(NodePool, blocks1)
+{
+    NodePool pool;
+    EXPECT_EQ(0, pool.getChunksNum());
+
+    // blocks of a class follow each other in a chunk
+    char* a = static_cast<char*>(pool.allocate(40));
+    char* b = static_cast<char*>(pool.allocate(48));
+    EXPECT_EQ(a + 48, b);
+    EXPECT_EQ(1, pool.getChunksNum());
+    EXPECT_EQ(0, reinterpret_cast<size_t>(a) % NodePool::ALIGNMENT);
+
+    // a freed block is reused by its class only
+    pool.deallocate(a, 40);
+    void* c = pool.allocate(16);
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a, pool.allocate(33));
+
+    // big blocks do not touch chunks
+    void* big = pool.allocate(NodePool::MAX_BLOCK_SIZE + 1);
+    pool.deallocate(big, NodePool::MAX_BLOCK_SIZE + 1);
+    EXPECT_EQ(1, pool.getChunksNum());
+
+    // chunks grow
+    size_t before = pool.getReservedBytes();
+    for (int i = 0; i < 10000; ++i)
+        pool.allocate(64);
+    EXPECT_LT(1, pool.getChunksNum());
+    EXPECT_LT(before * 2, pool.getReservedBytes());
+}
+
+TEST(NodePool, allocator1)
+{
+    typedef std::set<int, std::less<int>, IntPoolAlloc> PoolSet;
+    std::weak_ptr<NodePool> weak;
+    {
+        IntPoolAlloc alloc;
+        weak = alloc.getPool();
+        PoolSet s(alloc);
+        std::map<int, std::string, std::less<int>,
+                 PoolAllocator<std::pair<const int, std::string>>> m(alloc);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            s.insert(i);
+            m[i] = std::to_string(i);
+        }
+        EXPECT_TRUE(alloc == s.get_allocator());
+        for (int i = 0; i < 1000; i += 2)
+            s.erase(i);
+        EXPECT_EQ(500, s.size());
+        EXPECT_EQ("777", m[777]);
+
+        // copies get own pools, moves take the pool along
+        PoolSet s2(s);
+        EXPECT_TRUE(s.get_allocator() != s2.get_allocator());
+        EXPECT_EQ(s, s2);
+        PoolSet s3(std::move(s));
+        EXPECT_TRUE(alloc == s3.get_allocator());
+        s2 = std::move(s3);
+        EXPECT_TRUE(alloc == s2.get_allocator());
+        EXPECT_EQ(500, s2.size());
+
+        // the pool outlives the allocator it has been made by
+        alloc = IntPoolAlloc();
+        EXPECT_FALSE(weak.expired());
+    }
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(NodePool, graph1)
+{
+    std::mt19937 rng(3);
+    PoolIntGraph g;
+    UGraph<int> ref;
+    g.setHubThreshold(8);
+    ref.setHubThreshold(8);
+    for (int i = 0; i < 2000; ++i)
+    {
+        int u = int(rng() % 300);
+        int v = int(rng() % 300);
+        g.addEdge(u, v);
+        ref.addEdge(u, v);
+        if (i % 5 == 0)
+        {
+            g.removeVertex(u);
+            ref.removeVertex(u);
+        }
+    }
+
+    ASSERT_EQ(ref.getEdgesNum(), g.getEdgesNum());
+    ASSERT_EQ(ref.getVerticesNum(), g.getVerticesNum());
+    for (auto es = ref.getEdges(); es.first != es.second; ++es.first)
+        EXPECT_TRUE(g.isEdgeExists(es.first->second, es.first->first));
+    for (UInt id = 0; id < ref.getVerticesNum(); ++id)
+        EXPECT_EQ(ref.getVertexById(id), g.getVertexById(id));
+
+    std::shared_ptr<NodePool> pool = g.getAllocator().getPool();
+
+    // a copy and a compacted graph get new pools
+    PoolIntGraph g2 = g;
+    EXPECT_NE(pool, g2.getAllocator().getPool());
+    EXPECT_EQ(g.getEdgesNum(), g2.getEdgesNum());
+    // the old pool is released as a whole
+    g.compact();
+    EXPECT_NE(pool, g.getAllocator().getPool());
+    EXPECT_EQ(1, pool.use_count());
+    EXPECT_EQ(ref.getEdgesNum(), g.getEdgesNum());
+
+    CsrUGraph<int> csr(g);
+    EXPECT_EQ(g.getEdgesNum(), csr.getEdgesNum());
+}
+
+TEST(NodePool, sharedPool1)
+{
+    // graphs in one pool
+    auto pool = std::make_shared<NodePool>();
+    IntPoolAlloc alloc(pool);
+    PoolIntIntGraph g1(alloc), g2(alloc);
+    IntIntGraph ref;
+    for (int i = 0; i < 100; ++i)
+    {
+        g1.addLblEdge(i, i + 1, i);
+        g2.addLblEdge(i, 2 * i, i);
+        ref.addLblEdge(i, i + 1, i);
+    }
+    EXPECT_EQ(pool, g1.getAllocator().getPool());
+    EXPECT_EQ(pool, g2.getAllocator().getPool());
+
+    int lbl;
+    ASSERT_TRUE(g1.getLabel(51, 50, lbl));
+    EXPECT_EQ(50, lbl);
+    EXPECT_EQ(findMSTKruskal(ref), findMSTKruskal(g1));
+}
+
+TEST(NodePool, movedFrom1)
+{
+    // a moved-from graph shares the pool with the new one and can be reused
+    PoolIntGraph g;
+    g.addEdge(1, 2);
+    PoolIntGraph h(std::move(g));
+    g.addEdge(3, 4);
+    EXPECT_TRUE(g.isEdgeExists(4, 3));
+    EXPECT_TRUE(h.isEdgeExists(1, 2));
+
+    PoolIntGraph k;
+    k = std::move(h);
+    h.addEdge(5, 6);
+    EXPECT_TRUE(h.isEdgeExists(5, 6));
+    EXPECT_TRUE(k.isEdgeExists(2, 1));
+    EXPECT_FALSE(k.isEdgeExists(5, 6));
+
+    PoolIntIntGraph lg;
+    lg.addLblEdge(1, 2, 12);
+    PoolIntIntGraph lg2(std::move(lg));
+    lg.addLblEdge(3, 4, 34);
+    int lbl;
+    ASSERT_TRUE(lg.getLabel(3, 4, lbl));
+    EXPECT_EQ(34, lbl);
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Graphs shared by testing modules for undirected graphs.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TEST_GRAPHS_HPP
+#define TEST_GRAPHS_HPP
+
+#include <random>
+
+#include "ugraph/ugraph.hpp"
+#include "ugraph/lbl_ugraph.hpp"
+
+
+// aux method making graph 1: 9 vertices 'a'..'i' and 14 labeled edges
+inline void makeGraph1(EdgeLblUGraph<char, int>& g)
+{
+    g.addLblEdge('a', 'b', 4);
+    g.addLblEdge('b', 'c', 8);
+    g.addLblEdge('b', 'h', 11);
+    g.addLblEdge('c', 'd', 7);
+    g.addLblEdge('c', 'i', 2);
+    g.addLblEdge('c', 'f', 4);
+    g.addLblEdge('d', 'e', 9);
+    g.addLblEdge('d', 'f', 14);
+    g.addLblEdge('e', 'f', 10);
+    g.addLblEdge('f', 'g', 2);
+    g.addLblEdge('g', 'h', 1);
+    g.addLblEdge('g', 'i', 6);
+    g.addLblEdge('h', 'a', 8);
+    g.addLblEdge('h', 'i', 7);
+}
+
+// aux method making a random graph on vertices 0..vertsNum - 1; the graph
+// may be disconnected
+inline void makeRandomGraph(UGraph<int>& g, int vertsNum, int edgesNum,
+                            unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vDist(0, vertsNum - 1);
+    for (int v = 0; v < vertsNum; ++v)
+        g.addVertex(v);
+    for (int i = 0; i < edgesNum; ++i)
+        g.addEdge(vDist(rng), vDist(rng));
+}
+
+// the same with labels in [1, maxLbl], so there are many equal ones if
+// maxLbl is small
+inline void makeRandomGraph(EdgeLblUGraph<int, int>& g, int vertsNum,
+                            int edgesNum, int maxLbl, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vDist(0, vertsNum - 1);
+    std::uniform_int_distribution<int> wDist(1, maxLbl);
+    for (int v = 0; v < vertsNum; ++v)
+        g.addVertex(v);
+    for (int i = 0; i < edgesNum; ++i)
+        g.addLblEdge(vDist(rng), vDist(rng), wDist(rng));
+}
+
+
+#endif // TEST_GRAPHS_HPP
@@ -13,11 +13,15 @@
 
 
 #include <set>
+#include <vector>
+#include <random>
+#include <limits>
 
 #include <gtest/gtest.h>
 
 #include "ugraph/ugraph_algos.hpp"
 #include "grviz/ugraph_dotwriter.hpp"
+#include "test_graphs.hpp"
 
 #define GV_OUT_DIR "./"
 
@@ -49,25 +53,6 @@ CharIntGraph makeGraphFromEdges(const CharIntGraph& origG,
     return mst;
 }
 
-// aux method making graph 1
-void makeGraph1(CharIntGraph& g)
-{
-    g.addLblEdge('a', 'b', 4);
-    g.addLblEdge('b', 'c', 8);
-    g.addLblEdge('b', 'h', 11);
-    g.addLblEdge('c', 'd', 7);
-    g.addLblEdge('c', 'i', 2);
-    g.addLblEdge('c', 'f', 4);
-    g.addLblEdge('d', 'e', 9);
-    g.addLblEdge('d', 'f', 14);
-    g.addLblEdge('e', 'f', 10);
-    g.addLblEdge('f', 'g', 2);
-    g.addLblEdge('g', 'h', 1);
-    g.addLblEdge('g', 'i', 6);
-    g.addLblEdge('h', 'a', 8);
-    g.addLblEdge('h', 'i', 7);
-}
-
 TEST(UgraphAlgos, mstPrim1)
 {
     // Creates a graph
@@ -117,3 +102,205 @@ TEST(UgraphAlgos, mstKruskal1)
 
 }
 
+// Fractional and negative labels are compared as they are.
+TEST(UgraphAlgos, mstPrim2)
+{
+    typedef EdgeLblUGraph<int, double> IntDoubleGraph;
+    typedef std::set<IntDoubleGraph::Edge> IntDoubleGraphEdgesSet;
+    IntDoubleGraph dg;
+    dg.addLblEdge(1, 2, 0.9);
+    dg.addLblEdge(2, 3, 0.5);
+    dg.addLblEdge(1, 3, 0.4);
+    dg.addLblEdge(3, 4, 1.7);
+    dg.addLblEdge(2, 4, 1.2);
+    EXPECT_EQ(findMSTKruskal(dg), findMSTPrim(dg));
+    EXPECT_EQ(IntDoubleGraphEdgesSet({{1, 3}, {2, 3}, {2, 4}}), findMSTPrim(dg));
+
+    IntIntGraph ig;
+    ig.addLblEdge(1, 2, 3);
+    ig.addLblEdge(2, 3, -5);
+    ig.addLblEdge(1, 3, -2);
+    ig.addLblEdge(3, 4, 1);
+    EXPECT_EQ(findMSTKruskal(ig), findMSTPrim(ig));
+    typedef std::set<IntIntGraph::Edge> IntIntGraphEdgesSet;
+    EXPECT_EQ(IntIntGraphEdgesSet({{1, 3}, {2, 3}, {3, 4}}), findMSTPrim(ig));
+}
+
+
+
+// The graph from the MST tests with labels as edge lengths.
+static IntIntGraph makeSpGraph()
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, 4);
+    g.addLblEdge(2, 3, 8);
+    g.addLblEdge(2, 8, 11);
+    g.addLblEdge(3, 4, 7);
+    g.addLblEdge(3, 9, 2);
+    g.addLblEdge(3, 6, 4);
+    g.addLblEdge(4, 5, 9);
+    g.addLblEdge(4, 6, 14);
+    g.addLblEdge(5, 6, 10);
+    g.addLblEdge(6, 7, 2);
+    g.addLblEdge(7, 8, 1);
+    g.addLblEdge(7, 9, 6);
+    g.addLblEdge(8, 1, 8);
+    g.addLblEdge(8, 9, 7);
+    return g;
+}
+
+TEST(UgraphAlgos, dijkstra1)
+{
+    IntIntGraph g = makeSpGraph();
+    g.addVertex(10);                        // unreachable
+
+    std::vector<int> dist = findShortestDistances(g, 1);
+    const int expected[] = { 0, 4, 12, 19, 21, 11, 9, 8, 14 };
+    for (int v = 1; v <= 9; ++v)
+        EXPECT_EQ(expected[v - 1], dist[g.getVertexId(v)]);
+    EXPECT_EQ(std::numeric_limits<int>::max(), dist[g.getVertexId(10)]);
+
+    int len = 0;
+    EXPECT_EQ(std::vector<int>({1, 8, 7, 6, 5}), findShortestPath(g, 1, 5, &len));
+    EXPECT_EQ(21, len);
+
+    EXPECT_TRUE(findShortestPath(g, 1, 10, &len).empty());
+    EXPECT_EQ(std::numeric_limits<int>::max(), len);
+
+    EXPECT_EQ(std::vector<int>({3}), findShortestPath(g, 3, 3));
+    EXPECT_THROW(findShortestPath(g, 1, 11), std::invalid_argument);
+}
+
+// A search is reused for several queries with early exit and for
+// multi-source runs.
+TEST(UgraphAlgos, dijkstra2)
+{
+    IntIntGraph g = makeSpGraph();
+    DijkstraSearch<IntIntGraph> search(g);
+
+    EXPECT_TRUE(search.run(1, 2));
+    EXPECT_EQ(4, search.getDistance(2));
+    EXPECT_FALSE(search.isReached(5));      // stopped before
+
+    EXPECT_TRUE(search.run(5, 1));
+    EXPECT_EQ(21, search.getDistance(1));
+    EXPECT_EQ(std::vector<int>({5, 6, 7, 8, 1}), search.getPath(1));
+
+    // each vertex is reached from the nearest of 1 and 5
+    search.runMulti({1, 5});
+    EXPECT_EQ(0, search.getDistance(5));
+    EXPECT_EQ(10, search.getDistance(6));
+    EXPECT_EQ(5, search.getSource(6));
+    EXPECT_EQ(8, search.getDistance(8));
+    EXPECT_EQ(1, search.getSource(8));
+    EXPECT_EQ(std::vector<int>({5, 4}), search.getPath(4));
+
+    std::vector<int> dist = findShortestDistances(g, std::vector<int>({1, 5}));
+    EXPECT_EQ(10, dist[g.getVertexId(6)]);
+}
+
+// All queues and graph types must give the same distances as Bellman-Ford.
+TEST(UgraphAlgos, dijkstra3)
+{
+    std::mt19937 rng(5);
+    IntIntGraph g;
+    for (int i = 0; i < 300; ++i)
+    {
+        int u = int(rng() % 100);
+        int v = int(rng() % 100);
+        if (!g.isEdgeExists(u, v))
+            g.addLblEdge(u, v, int(rng() % 20));
+    }
+
+    const unsigned int inf = std::numeric_limits<unsigned int>::max();
+    const int src = *g.getVertices().first;
+    std::vector<unsigned int> expected(g.getVerticesNum(), inf);
+    expected[g.getVertexId(src)] = 0;
+    for (size_t round = 0; round < g.getVerticesNum(); ++round)
+    {
+        IntIntGraph::EdgeIterPair es = g.getEdges();
+        for (auto it = es.first; it != es.second; ++it)
+        {
+            int w = 0;
+            g.getLabel(it->first, it->second, w);
+            unsigned int a = g.getVertexId(it->first);
+            unsigned int b = g.getVertexId(it->second);
+            if (expected[a] != inf)
+                expected[b] = std::min(expected[b], expected[a] + w);
+            if (expected[b] != inf)
+                expected[a] = std::min(expected[a], expected[b] + w);
+        }
+    }
+
+    EXPECT_EQ(expected, findShortestDistances<IndexedDaryHeap<>>(g, src));
+    EXPECT_EQ(expected, findShortestDistances<IndexedPairingHeap<>>(g, src));
+    EXPECT_EQ(expected, findShortestDistances<VertexPriorityQueue<unsigned int>>(g, src));
+
+    // distances of the label type by default
+    std::vector<int> intDist = findShortestDistances(g, src);
+    for (size_t v = 0; v < expected.size(); ++v)
+        EXPECT_EQ(expected[v] == inf ? std::numeric_limits<int>::max()
+                                     : int(expected[v]), intDist[v]);
+
+    // CSR IDs follow the sorted order of vertices, as UGraph's do not
+    CsrEdgeLblUGraph<int, int> cg(g);
+    std::vector<int> csrDist = findShortestDistances(cg, src);
+    auto vs = g.getVertices();
+    for (auto it = vs.first; it != vs.second; ++it)
+        EXPECT_EQ(intDist[g.getVertexId(*it)], csrDist[cg.getVertexId(*it)]);
+
+    // distances along found paths must sum up
+    DijkstraSearch<CsrEdgeLblUGraph<int, int>> search(cg);
+    for (auto it = vs.first; it != vs.second; ++it)
+    {
+        if (!search.run(src, *it))
+            continue;
+        std::vector<int> path = search.getPath(*it);
+        int len = 0;
+        for (size_t i = 1; i < path.size(); ++i)
+        {
+            int w = 0;
+            EXPECT_TRUE(cg.getLabel(path[i - 1], path[i], w));
+            len += w;
+        }
+        EXPECT_EQ(search.getDistance(*it), len);
+    }
+}
+
+// Fractional labels are not truncated.
+TEST(UgraphAlgos, dijkstraDouble1)
+{
+    EdgeLblUGraph<int, double> g;
+    g.addLblEdge(1, 2, 0.5);
+    g.addLblEdge(2, 3, 0.25);
+    g.addLblEdge(1, 3, 1.0);
+    g.addLblEdge(3, 4, 2.5);
+    g.addVertex(5);                         // unreachable
+
+    std::vector<double> dist = findShortestDistances(g, 1);
+    EXPECT_DOUBLE_EQ(0.0, dist[g.getVertexId(1)]);
+    EXPECT_DOUBLE_EQ(0.5, dist[g.getVertexId(2)]);
+    EXPECT_DOUBLE_EQ(0.75, dist[g.getVertexId(3)]);
+    EXPECT_DOUBLE_EQ(3.25, dist[g.getVertexId(4)]);
+    EXPECT_EQ(std::numeric_limits<double>::max(), dist[g.getVertexId(5)]);
+
+    double len = 0;
+    EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), findShortestPath(g, 1, 4, &len));
+    EXPECT_DOUBLE_EQ(3.25, len);
+
+    CsrEdgeLblUGraph<int, double> cg(g);
+    DijkstraSearch<CsrEdgeLblUGraph<int, double>> search(cg);
+    search.runMulti({1, 4});
+    EXPECT_DOUBLE_EQ(0.75, search.getDistance(3));
+    EXPECT_EQ(1, search.getSource(3));
+    EXPECT_DOUBLE_EQ(0.0, search.getDistance(4));
+}
+
+TEST(UgraphAlgos, dijkstraErrors1)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, -1);
+    g.addEdge(2, 3);
+    EXPECT_THROW(findShortestDistances(g, 1), std::invalid_argument);
+    EXPECT_THROW(findShortestDistances(g, 3), std::invalid_argument);
+}
@@ -13,6 +13,10 @@
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <string>
+#include <sstream>
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 #include "ugraph/lbl_ugraph.hpp"
@@ -38,3 +42,100 @@ TEST(UGraphDotWriter, simpleGraph)
     IntIntGraphDW dw;   // dotwriter
     dw.write(GV_OUT_DIR "test1.gv", g, "Test Graph");
 }
+
+
+// aux method reading a whole file
+static std::string readFile(const char* fn)
+{
+    std::ifstream f(fn);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+
+// The fast visitor must give exactly the same output as the original one.
+TEST(UGraphDotWriter, fastVisitor1)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, 10);
+    g.addLblEdge(-1, 3, -20);
+    g.addEdge(1, 4);
+    g.addLblEdge(2, 2, 2147483647);
+
+    xi::ldopa::graph::GenDotWriter<IntIntGraph,
+        EdgeLblUGraphDotVisitor<int, int>> slow;
+    slow.write(GV_OUT_DIR "test_slow.gv", g, "Test Graph");
+    IntIntGraphDW fast;
+    fast.write(GV_OUT_DIR "test_fast.gv", g, "Test Graph");
+    EXPECT_EQ(readFile(GV_OUT_DIR "test_slow.gv"),
+              readFile(GV_OUT_DIR "test_fast.gv"));
+
+    // the buffer is reused by the next write
+    fast.write(GV_OUT_DIR "test_fast.gv", g, "Test Graph");
+    EXPECT_EQ(readFile(GV_OUT_DIR "test_slow.gv"),
+              readFile(GV_OUT_DIR "test_fast.gv"));
+
+    EdgeLblUGraph<char, std::string> sg;
+    sg.addLblEdge('a', 'b', "say \"hi\"");
+    sg.addLblEdge('b', 'c', "back\\slash");
+    sg.addLblEdge('c', 'a', "");
+    xi::ldopa::graph::GenDotWriter<EdgeLblUGraph<char, std::string>,
+        EdgeLblUGraphDotVisitor<char, std::string>> sslow;
+    sslow.write(GV_OUT_DIR "test_slow.gv", sg);
+    EdgeLblUGraphDotWriter<char, std::string>::Type sfast;
+    sfast.write(GV_OUT_DIR "test_fast.gv", sg);
+    EXPECT_EQ(readFile(GV_OUT_DIR "test_slow.gv"),
+              readFile(GV_OUT_DIR "test_fast.gv"));
+
+    // characters are escaped the same as strings
+    EdgeLblUGraph<char, char> cg;
+    cg.addLblEdge('a', 'b', '"');
+    cg.addLblEdge('b', '"', '\\');
+    cg.addLblEdge('\\', 'a', 'x');
+    xi::ldopa::graph::GenDotWriter<EdgeLblUGraph<char, char>,
+        EdgeLblUGraphDotVisitor<char, char>> cslow;
+    cslow.write(GV_OUT_DIR "test_slow.gv", cg);
+    EdgeLblUGraphDotWriter<char, char>::Type cfast;
+    cfast.write(GV_OUT_DIR "test_fast.gv", cg);
+    EXPECT_EQ(readFile(GV_OUT_DIR "test_slow.gv"),
+              readFile(GV_OUT_DIR "test_fast.gv"));
+
+    EdgeLblUGraph<unsigned long long, double> dg;
+    dg.addLblEdge(18446744073709551615ULL, 0, 0.1);
+    dg.addLblEdge(10, 100, 1e20);
+    dg.addLblEdge(99, 100, -2.5);
+    xi::ldopa::graph::GenDotWriter<EdgeLblUGraph<unsigned long long, double>,
+        EdgeLblUGraphDotVisitor<unsigned long long, double>> dslow;
+    dslow.write(GV_OUT_DIR "test_slow.gv", dg);
+    EdgeLblUGraphDotWriter<unsigned long long, double>::Type dfast;
+    dfast.write(GV_OUT_DIR "test_fast.gv", dg);
+    EXPECT_EQ(readFile(GV_OUT_DIR "test_slow.gv"),
+              readFile(GV_OUT_DIR "test_fast.gv"));
+}
+
+
+TEST(UGraphDotWriter, outBuffer1)
+{
+    // a tiny buffer is flushed many times
+    xi::ldopa::graph::DotOutBuffer buf(40);
+    std::stringstream ss;
+    buf.begin(ss);
+    buf.appendInt(0);
+    buf.append(' ');
+    buf.appendInt(-9223372036854775807LL - 1);
+    buf.append(' ');
+    buf.appendUInt(18446744073709551615ULL);
+    buf.append(' ');
+    buf.appendValue(7u);
+    buf.appendValue('x');
+    buf.appendQuoted(std::string("a\"b"));
+    buf.appendQuoted('"');
+    buf.appendQuoted((unsigned char)'\\');
+    buf.appendQuoted((signed char)'y');
+    buf.append(" and a string longer than the whole buffer itself");
+    buf.end();
+
+    EXPECT_EQ("0 -9223372036854775808 18446744073709551615 7x\"a\\\"b\"\"\\\"\"\"\\\\\"\"y\""
+              " and a string longer than the whole buffer itself", ss.str());
+}
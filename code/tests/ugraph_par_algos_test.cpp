@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for parallel algoritms for undirected graphs.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <vector>
+#include <random>
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/ugraph_algos.hpp"
+#include "ugraph/ugraph_par_algos.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "test_graphs.hpp"
+
+
+TEST(UgraphParAlgos, simplest)
+{
+}
+
+
+typedef EdgeLblUGraph<int, int> IntIntGraph;
+typedef EdgeLblUGraph<char, int> CharIntGraph;
+
+
+TEST(UgraphParAlgos, parallelSort1)
+{
+    std::mt19937 rng(3);
+    for (size_t n : {0, 1, 5, 100, 1001})
+    {
+        std::vector<int> v(n);
+        for (int& x : v)
+            x = int(rng() % 50);
+
+        for (unsigned int threads = 1; threads <= 5; ++threads)
+        {
+            std::vector<int> sorted = v;
+            parallelSort(sorted.begin(), sorted.end(), threads, std::less<int>());
+            EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+            EXPECT_EQ(std::multiset<int>(v.begin(), v.end()),
+                      std::multiset<int>(sorted.begin(), sorted.end()));
+        }
+    }
+}
+
+
+TEST(UgraphParAlgos, mstFilterKruskal1)
+{
+    CharIntGraph g;
+    makeGraph1(g);
+
+    auto mstK = findMSTKruskal(g);
+    EXPECT_EQ(mstK, findMSTFilterKruskal(g));
+    EXPECT_EQ(mstK, findMSTFilterKruskal(g, 2, 3));
+}
+
+
+TEST(UgraphParAlgos, mstFilterKruskalRandom)
+{
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        IntIntGraph g;
+        makeRandomGraph(g, 300, 1500, 5, seed);
+
+        auto mstK = findMSTKruskal(g);
+        for (unsigned int threads = 1; threads <= 4; ++threads)
+        {
+            EXPECT_EQ(mstK, findMSTFilterKruskal(g, threads, 8));
+            EXPECT_EQ(mstK, findMSTFilterKruskal(g, threads, 200));
+        }
+    }
+}
+
+
+TEST(UgraphParAlgos, mstBoruvka1)
+{
+    CharIntGraph g;
+    makeGraph1(g);
+
+    auto mstK = findMSTKruskal(g);
+    EXPECT_EQ(mstK, findMSTBoruvka(g));
+    EXPECT_EQ(mstK, findMSTBoruvka(g, 3));
+}
+
+
+TEST(UgraphParAlgos, mstBoruvkaRandom)
+{
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        IntIntGraph g;
+        makeRandomGraph(g, 300, 1500, 5, seed);
+
+        auto mstK = findMSTKruskal(g);
+        for (unsigned int threads = 1; threads <= 4; ++threads)
+            EXPECT_EQ(mstK, findMSTBoruvka(g, threads));
+    }
+
+    // a sparse, disconnected graph gives a spanning forest
+    IntIntGraph g;
+    makeRandomGraph(g, 500, 300, 3, 11);
+    EXPECT_EQ(findMSTKruskal(g), findMSTBoruvka(g, 2));
+}
+
+
+TEST(UgraphParAlgos, threadTeam1)
+{
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+    {
+        ThreadTeam team(threads);
+        EXPECT_EQ(threads, team.getThreadsNum());
+
+        // many short steps on the same team
+        std::vector<int> hits(1000, 0);
+        for (int step = 0; step < 50; ++step)
+            team.runBlocks(hits.size(), [&](size_t b, unsigned int) { ++hits[b]; });
+        for (int h : hits)
+            EXPECT_EQ(50, h);
+
+        std::atomic<unsigned int> ran(0);
+        team.run([&](unsigned int) { ++ran; });
+        EXPECT_EQ(threads, ran.load());
+
+        // an exception of any thread reaches the caller, the team survives
+        EXPECT_THROW(team.run([&](unsigned int tid)
+                              {
+                                  if (tid == threads - 1)
+                                      throw std::invalid_argument("test");
+                              }),
+                     std::invalid_argument);
+        team.run([&](unsigned int) { ++ran; });
+        EXPECT_EQ(2 * threads, ran.load());
+    }
+}
+
+
+TEST(UgraphParAlgos, parallelForErrors1)
+{
+    for (unsigned int threads = 1; threads <= 4; ++threads)
+    {
+        // a throwing chunk of any thread, including the calling one, reaches
+        // the caller after other chunks are done
+        for (unsigned int bad = 0; bad < threads; ++bad)
+        {
+            std::atomic<unsigned int> done(0);
+            EXPECT_THROW(parallelFor(0, 100, threads,
+                             [&](size_t, size_t, unsigned int tid)
+                             {
+                                 if (tid == bad)
+                                     throw std::invalid_argument("test");
+                                 ++done;
+                             }),
+                         std::invalid_argument);
+            EXPECT_EQ(threads - 1, done.load());
+        }
+
+        // the same for blocks
+        std::atomic<size_t> blocks(0);
+        EXPECT_THROW(parallelForBlocks(50, threads,
+                         [&](size_t b, unsigned int)
+                         {
+                             ++blocks;
+                             if (b == 10)
+                                 throw std::out_of_range("test");
+                         }),
+                     std::out_of_range);
+        EXPECT_LE(11, blocks.load());
+    }
+}
+
+
+TEST(UgraphParAlgos, deltaStepping1)
+{
+    CharIntGraph g;
+    makeGraph1(g);
+    g.addVertex('z');
+
+    std::vector<int> expected = findShortestDistances(g, 'a');
+    EXPECT_EQ(expected, findShortestDistancesDelta(g, 'a'));
+    for (unsigned int delta : {1u, 3u, 5u, 100u})
+        for (unsigned int threads = 1; threads <= 3; ++threads)
+            EXPECT_EQ(expected, findShortestDistancesDelta(g, 'a', delta, threads));
+
+    DeltaSteppingSearch<CharIntGraph> search(g, 4, 2);
+    EXPECT_EQ(4, search.getDelta());
+    search.run('e');
+    EXPECT_EQ(21, search.getDistance('a'));
+    EXPECT_EQ(search.getInfinity(), search.getDistance('z'));
+
+    // the same search is reused for another source
+    search.run('a');
+    EXPECT_EQ(expected, search.getDistances());
+}
+
+// Distances must be the same as Dijkstra's for random graphs, deltas and
+// thread numbers, zero labels included.
+TEST(UgraphParAlgos, deltaSteppingRandom)
+{
+    for (unsigned int seed = 1; seed <= 5; ++seed)
+    {
+        IntIntGraph g;
+        makeRandomGraph(g, 300, 900, int(seed * 20), seed);
+        g.addLblEdge(0, 299, 0);
+
+        CsrEdgeLblUGraph<int, int> cg(g);
+        for (int src : {0, 150})
+        {
+            std::vector<int> expected = findShortestDistances(cg, src);
+            for (unsigned int delta : {0u, 1u, 10u, 1000u})
+                for (unsigned int threads : {1u, 4u})
+                    EXPECT_EQ(expected,
+                              findShortestDistancesDelta(cg, src, delta, threads));
+        }
+    }
+}
+
+TEST(UgraphParAlgos, deltaSteppingLongEdges)
+{
+    // delta much smaller than edges: buckets share slots of cyclic arrays
+    for (unsigned int seed = 1; seed <= 3; ++seed)
+    {
+        IntIntGraph g;
+        makeRandomGraph(g, 300, 900, 1000000, seed);
+
+        CsrEdgeLblUGraph<int, int> cg(g);
+        std::vector<int> expected = findShortestDistances(cg, 0);
+        for (unsigned int delta : {1u, 7u, 300u})
+        {
+            DeltaSteppingSearch<CsrEdgeLblUGraph<int, int>> search(cg, delta, 2);
+            search.run(0);
+            EXPECT_EQ(expected, search.getDistances());
+            search.run(0);
+            EXPECT_EQ(expected, search.getDistances());
+        }
+    }
+}
+
+// Fractional labels are not truncated, distances are the same as Dijkstra's.
+TEST(UgraphParAlgos, deltaSteppingDouble1)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> wDist(0.0, 2.0);
+    EdgeLblUGraph<int, double> g;
+    for (int v = 0; v < 200; ++v)
+        g.addLblEdge(v, (v + 1) % 200, wDist(rng));
+    for (int i = 0; i < 600; ++i)
+        g.addLblEdge(int(rng() % 200), int(rng() % 200), wDist(rng));
+
+    CsrEdgeLblUGraph<int, double> cg(g);
+    std::vector<double> expected = findShortestDistances(cg, 0);
+    EXPECT_LT(0.0, expected[cg.getVertexId(100)]);
+    for (double delta : {0.0, 0.05, 0.5, 3.0})
+        for (unsigned int threads : {1u, 3u})
+            EXPECT_EQ(expected, findShortestDistancesDelta(cg, 0, delta, threads));
+
+    DeltaSteppingSearch<CsrEdgeLblUGraph<int, double>> search(cg, 0.25, 2);
+    EXPECT_DOUBLE_EQ(0.25, search.getDelta());
+}
+
+TEST(UgraphParAlgos, deltaSteppingErrors1)
+{
+    IntIntGraph g;
+    g.addLblEdge(1, 2, -1);
+    EXPECT_THROW(findShortestDistancesDelta(g, 1, 0u, 2), std::invalid_argument);
+
+    g.addEdge(2, 3);
+    EXPECT_THROW(findShortestDistancesDelta(g, 1, 0u, 1), std::invalid_argument);
+}
@@ -12,6 +12,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 
+#include <set>
+#include <tuple>
+#include <vector>
+#include <stdexcept>
+
 #include <gtest/gtest.h>
 
 #include "ugraph/ugraph.hpp"
@@ -24,6 +29,7 @@ TEST(UGraph, simplest)
 
 // Graph with integers as node ids.
 typedef UGraph<int> IntGraph;
+typedef unsigned int UInt;
 
 TEST(UGraph, simpleCreation)
 {
@@ -157,3 +163,296 @@ TEST(UGraph, iterEdges2)
     EXPECT_EQ(6, c);
 }
 
+
+
+// Tests edge existence checks and insertions for a hub vertex.
+TEST(UGraph, hubVertex1)
+{
+    IntGraph g;
+    g.setHubThreshold(16);
+    EXPECT_EQ(16, g.getHubThreshold());
+
+    for (int i = 1; i <= 1000; ++i)
+        g.addEdge(0, i);
+    g.addEdge(0, 0);
+    g.addEdge(1, 2);
+
+    EXPECT_TRUE(g.isHub(0));
+    EXPECT_FALSE(g.isHub(1));
+    EXPECT_EQ(1002, g.getDegree(0));
+    EXPECT_EQ(2, g.getDegree(1));
+    EXPECT_EQ(0, g.getDegree(2000));
+
+    for (int i = 1; i <= 1000; ++i)
+    {
+        ASSERT_TRUE(g.isEdgeExists(0, i));
+        ASSERT_TRUE(g.isEdgeExists(i, 0));
+    }
+    EXPECT_TRUE(g.isEdgeExists(0, 0));
+    EXPECT_TRUE(g.isEdgeExists(2, 1));
+    EXPECT_FALSE(g.isEdgeExists(0, 1001));
+    EXPECT_FALSE(g.isEdgeExists(2, 3));
+
+    // duplicates are not added
+    g.addEdge(500, 0);
+    EXPECT_EQ(1002, g.getEdgesNum());
+
+    // switching the index off does not change the answers
+    g.setHubThreshold(unsigned(-1));
+    EXPECT_FALSE(g.isHub(0));
+    EXPECT_TRUE(g.isEdgeExists(700, 0));
+    EXPECT_FALSE(g.isEdgeExists(700, 1));
+}
+
+
+// A graph built in bulk must be the same as the one built edge by edge.
+TEST(UGraph, fromEdges1)
+{
+    std::vector<IntGraph::Edge> es = {
+        {4, 1}, {1, 2}, {2, 2}, {1, 4}, {3, 1}, {2, 4}, {2, 2}, {4, 4}, {1, 2}
+    };
+
+    IntGraph g0;
+    for (const IntGraph::Edge& e : es)
+        g0.addEdge(e.first, e.second);
+
+    for (unsigned int threads = 1; threads <= 3; ++threads)
+    {
+        IntGraph g = IntGraph::fromEdges(es.data(), es.size(), threads);
+        EXPECT_EQ(g0.getVerticesNum(), g.getVerticesNum());
+        EXPECT_EQ(g0.getEdgesNum(), g.getEdgesNum());
+
+        // IDs go in ascending order of vertices
+        for (unsigned int i = 0; i < 4; ++i)
+            EXPECT_EQ(int(i + 1), g.getVertexById(i));
+
+        for (int s = 0; s <= 5; ++s)
+        {
+            EXPECT_EQ(g0.getDegree(s), g.getDegree(s));
+            for (int d = 0; d <= 5; ++d)
+                EXPECT_EQ(g0.isEdgeExists(s, d), g.isEdgeExists(s, d));
+        }
+
+        std::multiset<IntGraph::Edge> expected, actual;
+        IntGraph::EdgeIterPair eit = g0.getEdges();
+        for (IntGraph::EdgeIter it = eit.first; it != eit.second; ++it)
+            expected.insert({it->first, it->second});
+        eit = g.getEdges();
+        for (IntGraph::EdgeIter it = eit.first; it != eit.second; ++it)
+            actual.insert({it->first, it->second});
+        EXPECT_EQ(expected, actual);
+
+        // the graph stays modifiable
+        g.addEdge(3, 5);
+        EXPECT_TRUE(g.isEdgeExists(5, 3));
+        EXPECT_EQ(2, g.getDegree(3));
+    }
+
+    EXPECT_EQ(0, IntGraph::fromEdges(es.begin(), es.begin()).getVerticesNum());
+}
+
+
+TEST(UGraph, fromEdgesHubs1)
+{
+    std::vector<std::tuple<int, int>> es;
+    for (int i = 1; i <= 100; ++i)
+        es.push_back(std::make_tuple(i, 0));
+
+    IntGraph g = IntGraph::fromEdges(es.begin(), es.end(), 2);
+    EXPECT_TRUE(g.isHub(0));
+    EXPECT_FALSE(g.isHub(1));
+    EXPECT_TRUE(g.isEdgeExists(0, 77));
+    EXPECT_FALSE(g.isEdgeExists(0, 101));
+}
+
+
+// Tests removal of edges, including self-loops and edges of hubs.
+TEST(UGraph, removeEdge1)
+{
+    IntGraph g;
+    g.setHubThreshold(4);
+    for (int i = 1; i <= 6; ++i)
+        g.addEdge(0, i);
+    g.addEdge(1, 2);
+    g.addEdge(3, 3);
+
+    EXPECT_TRUE(g.removeEdge(2, 0));
+    EXPECT_FALSE(g.removeEdge(0, 2));
+    EXPECT_FALSE(g.removeEdge(0, 100));
+    EXPECT_FALSE(g.removeEdge(1, 3));
+    EXPECT_FALSE(g.isEdgeExists(0, 2));
+    EXPECT_TRUE(g.isEdgeExists(1, 2));
+    EXPECT_EQ(5, g.getDegree(0));
+    EXPECT_EQ(1, g.getDegree(2));
+    EXPECT_TRUE(g.isHub(0));
+
+    EXPECT_TRUE(g.removeEdge(3, 3));
+    EXPECT_FALSE(g.isEdgeExists(3, 3));
+    EXPECT_EQ(1, g.getDegree(3));
+    EXPECT_EQ(6, g.getEdgesNum());
+
+    // vertices stay
+    EXPECT_TRUE(g.removeEdge(0, 4));
+    EXPECT_TRUE(g.isVertexExists(4));
+    EXPECT_EQ(0, g.getDegree(4));
+
+    // removed edges may be added again
+    g.addEdge(0, 2);
+    g.addEdge(3, 3);
+    EXPECT_TRUE(g.isEdgeExists(2, 0));
+    EXPECT_EQ(7, g.getEdgesNum());
+
+    std::set<IntGraph::Edge> es;
+    for (auto it = g.getEdges(); it.first != it.second; ++it.first)
+        es.insert(*it.first);
+    EXPECT_EQ(std::set<IntGraph::Edge>({ {0, 1}, {0, 2}, {0, 3}, {0, 5},
+                                         {0, 6}, {1, 2}, {3, 3} }), es);
+}
+
+// Tests removal of vertices: IDs stay dense, the last vertex takes the ID.
+TEST(UGraph, removeVertex1)
+{
+    IntGraph g;
+    g.setHubThreshold(3);
+    g.addEdge(10, 11);
+    g.addEdge(10, 12);
+    g.addEdge(10, 13);
+    g.addEdge(13, 13);
+    g.addEdge(14, 13);
+    g.addEdge(14, 12);
+    g.addEdge(14, 11);
+    g.addEdge(14, 14);
+    ASSERT_EQ(4, g.getVertexId(14));
+    ASSERT_TRUE(g.isHub(14));
+
+    EXPECT_FALSE(g.removeVertex(100));
+    EXPECT_TRUE(g.removeVertex(10));
+    EXPECT_FALSE(g.isVertexExists(10));
+    EXPECT_EQ(4, g.getVerticesNum());
+    EXPECT_EQ(5, g.getEdgesNum());
+
+    // 14 has taken the ID of 10 in the hub index too
+    EXPECT_EQ(0, g.getVertexId(14));
+    EXPECT_EQ(14, g.getVertexById(0));
+    EXPECT_TRUE(g.isHub(14));
+    EXPECT_EQ(5, g.getDegree(14));
+    EXPECT_TRUE(g.isEdgeExists(14, 11));
+    EXPECT_TRUE(g.isEdgeExists(13, 14));
+    EXPECT_TRUE(g.isEdgeExists(14, 14));
+    EXPECT_FALSE(g.isEdgeExists(11, 12));
+    EXPECT_EQ(1, g.getDegree(11));
+
+    // a vertex with a self-loop
+    EXPECT_TRUE(g.removeVertex(13));
+    EXPECT_EQ(3, g.getVerticesNum());
+    EXPECT_EQ(3, g.getEdgesNum());
+    EXPECT_EQ(4, g.getDegree(14));
+    for (int v : { 11, 12, 14 })
+        EXPECT_EQ(v, g.getVertexById(g.getVertexId(v)));
+
+    EXPECT_TRUE(g.removeVertex(11));
+    EXPECT_TRUE(g.removeVertex(12));
+    EXPECT_TRUE(g.removeVertex(14));
+    EXPECT_EQ(0, g.getVerticesNum());
+    EXPECT_EQ(0, g.getEdgesNum());
+}
+
+// Tests the tombstone mode: removed vertices keep their IDs until compact().
+TEST(UGraph, tombstones1)
+{
+    IntGraph g;
+    g.setHubThreshold(3);
+    g.setTombstoneMode(true);
+    EXPECT_TRUE(g.isTombstoneMode());
+    for (int i = 1; i <= 4; ++i)
+        g.addEdge(0, i);
+    g.addEdge(4, 4);
+    g.addEdge(1, 2);
+    ASSERT_TRUE(g.isHub(0));
+
+    EXPECT_TRUE(g.removeVertex(1));
+    EXPECT_FALSE(g.removeVertex(1));
+    EXPECT_FALSE(g.isVertexExists(1));
+    EXPECT_TRUE(g.isTombstone(1));
+    EXPECT_EQ(1, g.getTombstonesNum());
+    EXPECT_EQ(5, g.getVerticesNum());
+    EXPECT_EQ(4, g.getEdgesNum());
+    EXPECT_THROW(g.getVertexId(1), std::invalid_argument);
+
+    // other vertices keep their IDs
+    for (int v : { 0, 2, 3, 4 })
+        EXPECT_EQ(UInt(v), g.getVertexId(v));
+    EXPECT_EQ(3, g.getDegree(0));
+    EXPECT_EQ(0, g.getDegree(1));
+    EXPECT_FALSE(g.isEdgeExists(0, 1));
+    EXPECT_TRUE(g.isEdgeExists(0, 4));
+
+    // a vertex with a self-loop; a revived vertex gets its ID back
+    EXPECT_TRUE(g.removeVertex(4));
+    EXPECT_EQ(2, g.getTombstonesNum());
+    g.addEdge(1, 3);
+    EXPECT_EQ(1, g.getVertexId(1));
+    EXPECT_FALSE(g.isTombstone(1));
+    EXPECT_EQ(1, g.getTombstonesNum());
+    EXPECT_EQ(3, g.getEdgesNum());
+
+    // a new vertex gets a new ID
+    g.addVertex(7);
+    EXPECT_EQ(5, g.getVertexId(7));
+    EXPECT_EQ(6, g.getVerticesNum());
+
+    // switching the mode off keeps tombstones; a removal moves the last ID
+    g.setTombstoneMode(false);
+    EXPECT_TRUE(g.removeVertex(2));
+    EXPECT_EQ(2, g.getVertexId(7));
+    EXPECT_FALSE(g.isTombstone(2));
+    EXPECT_TRUE(g.isTombstone(4));
+    EXPECT_EQ(5, g.getVerticesNum());
+}
+
+// Tests compaction: tombstones are dropped, IDs keep their order.
+TEST(UGraph, compact1)
+{
+    IntGraph g;
+    g.setHubThreshold(3);
+    g.setTombstoneMode(true);
+    for (int i = 1; i <= 6; ++i)
+        g.addEdge(0, i);
+    g.addEdge(5, 6);
+    g.addEdge(6, 6);
+
+    g.removeVertex(2);
+    g.removeVertex(4);
+    g.removeEdge(0, 6);
+    g.compact();
+
+    EXPECT_EQ(0, g.getTombstonesNum());
+    EXPECT_EQ(5, g.getVerticesNum());
+    EXPECT_EQ(5, g.getEdgesNum());
+    int expIds[] = { 0, 1, 3, 5, 6 };
+    for (UInt id = 0; id < 5; ++id)
+    {
+        EXPECT_EQ(expIds[id], g.getVertexById(id));
+        EXPECT_EQ(id, g.getVertexId(expIds[id]));
+    }
+
+    // the hub index refers to the rebuilt adjacency list
+    EXPECT_TRUE(g.isHub(0));
+    EXPECT_EQ(3, g.getDegree(0));
+    EXPECT_TRUE(g.isEdgeExists(5, 0));
+    EXPECT_TRUE(g.removeEdge(0, 5));
+    EXPECT_TRUE(g.removeEdge(6, 6));
+    EXPECT_FALSE(g.isEdgeExists(0, 5));
+    EXPECT_EQ(3, g.getEdgesNum());
+
+    // without tombstones IDs stay
+    g.compact();
+    EXPECT_EQ(3, g.getVertexId(5));
+
+    // copies get their own hub index
+    IntGraph g2 = g;
+    g.removeEdge(0, 1);
+    EXPECT_TRUE(g2.isEdgeExists(0, 1));
+    EXPECT_TRUE(g2.removeEdge(1, 0));
+    EXPECT_EQ(2, g2.getEdgesNum());
+}
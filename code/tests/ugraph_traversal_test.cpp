@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for traversals of undirected graphs.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/ugraph.hpp"
+#include "ugraph/csr_ugraph.hpp"
+#include "ugraph/ugraph_traversal.hpp"
+#include "test_graphs.hpp"
+
+
+typedef UGraph<char> CharGraph;
+typedef UGraph<int> IntGraph;
+typedef unsigned int UInt;
+
+const UInt NO_LEVEL = DirOptBfs<IntGraph>::NO_ID;
+
+
+// a visitor recording events as a string of vertex names
+struct RecordingVisitor : TraversalVisitor {
+    const CharGraph& g;
+    std::string discovered;
+    std::string finished;
+    std::vector<UInt> levels;
+    std::vector<std::pair<char, char>> tree;
+    size_t nonTree = 0;
+    size_t stopAfter = size_t(-1);
+
+    explicit RecordingVisitor(const CharGraph& gr)
+        : g(gr), levels(gr.getVerticesNum(), NO_LEVEL) {}
+
+    void discoverVertex(UInt v, UInt level)
+    {
+        discovered += g.getVertexById(v);
+        levels[v] = level;
+    }
+    void treeEdge(UInt u, UInt v)
+    {
+        tree.push_back({g.getVertexById(u), g.getVertexById(v)});
+    }
+    void nonTreeEdge(UInt, UInt) { ++nonTree; }
+    void finishVertex(UInt v) { finished += g.getVertexById(v); }
+    bool isDone() const { return discovered.size() >= stopAfter; }
+};
+
+
+// aux method making graph 1: a path a-b-c-d with a triangle b-e-f-b
+// and a separate edge x-y
+static void makeGraph1(CharGraph& g)
+{
+    g.addEdge('a', 'b');
+    g.addEdge('b', 'c');
+    g.addEdge('c', 'd');
+    g.addEdge('b', 'e');
+    g.addEdge('e', 'f');
+    g.addEdge('f', 'b');
+    g.addEdge('x', 'y');
+}
+
+// reference levels by the visitor-based BFS
+static std::vector<UInt> getBfsLevels(const IntGraph& g, int root)
+{
+    struct Levels : TraversalVisitor {
+        std::vector<UInt> levels;
+        void discoverVertex(UInt v, UInt level) { levels[v] = level; }
+    } vis;
+    vis.levels.assign(g.getVerticesNum(), NO_LEVEL);
+    traverseBfs(g, root, vis);
+    return vis.levels;
+}
+
+
+TEST(UgraphTraversal, dfs1)
+{
+    CharGraph g;
+    makeGraph1(g);
+
+    RecordingVisitor vis(g);
+    traverseDfs(g, 'a', vis);
+
+    // every vertex of the component is discovered and finished once
+    EXPECT_EQ(6, vis.discovered.size());
+    EXPECT_EQ(6, vis.finished.size());
+    EXPECT_EQ('a', vis.discovered[0]);
+    EXPECT_EQ('a', vis.finished.back());
+    EXPECT_EQ(5, vis.tree.size());
+    EXPECT_EQ(NO_LEVEL, vis.levels[g.getVertexId('x')]);
+
+    // 6 edges give 12 half-edges, 5 of them are tree ones
+    EXPECT_EQ(7, vis.nonTree);
+
+    // the depth is the length of the tree path to the root
+    EXPECT_EQ(1, vis.levels[g.getVertexId('b')]);
+    for (const auto& e : vis.tree)
+        EXPECT_EQ(vis.levels[g.getVertexId(e.first)] + 1,
+                  vis.levels[g.getVertexId(e.second)]);
+
+    // a vertex finishes before its tree parent
+    for (const auto& e : vis.tree)
+        EXPECT_LT(vis.finished.find(e.second), vis.finished.find(e.first));
+}
+
+TEST(UgraphTraversal, dfsDeep1)
+{
+    // a long path would overflow the stack of a recursive DFS
+    const int n = 200000;
+    IntGraph g;
+    for (int v = 1; v < n; ++v)
+        g.addEdge(v - 1, v);
+
+    struct MaxDepth : TraversalVisitor {
+        UInt depth = 0;
+        void discoverVertex(UInt, UInt level) { depth = std::max(depth, level); }
+    } vis;
+    traverseDfs(g, 0, vis);
+    EXPECT_EQ(UInt(n - 1), vis.depth);
+}
+
+TEST(UgraphTraversal, bfs1)
+{
+    CharGraph g;
+    makeGraph1(g);
+
+    RecordingVisitor vis(g);
+    traverseBfs(g, 'a', vis);
+
+    EXPECT_EQ(6, vis.discovered.size());
+    EXPECT_EQ(vis.discovered, vis.finished);
+    EXPECT_EQ(0, vis.levels[g.getVertexId('a')]);
+    EXPECT_EQ(1, vis.levels[g.getVertexId('b')]);
+    EXPECT_EQ(2, vis.levels[g.getVertexId('c')]);
+    EXPECT_EQ(2, vis.levels[g.getVertexId('e')]);
+    EXPECT_EQ(2, vis.levels[g.getVertexId('f')]);
+    EXPECT_EQ(3, vis.levels[g.getVertexId('d')]);
+    EXPECT_EQ(NO_LEVEL, vis.levels[g.getVertexId('y')]);
+    EXPECT_EQ(7, vis.nonTree);
+
+    // vertices are discovered in order of levels
+    for (size_t i = 1; i < vis.discovered.size(); ++i)
+        EXPECT_LE(vis.levels[g.getVertexId(vis.discovered[i - 1])],
+                  vis.levels[g.getVertexId(vis.discovered[i])]);
+}
+
+TEST(UgraphTraversal, traverseAll1)
+{
+    CharGraph g;
+    makeGraph1(g);
+    g.addVertex('z');
+
+    struct Roots : TraversalVisitor {
+        size_t roots = 0, discovered = 0;
+        void startVertex(UInt) { ++roots; }
+        void discoverVertex(UInt, UInt) { ++discovered; }
+    } dfsVis, bfsVis;
+
+    traverseDfsAll(g, dfsVis);
+    traverseBfsAll(g, bfsVis);
+    EXPECT_EQ(3, dfsVis.roots);
+    EXPECT_EQ(9, dfsVis.discovered);
+    EXPECT_EQ(3, bfsVis.roots);
+    EXPECT_EQ(9, bfsVis.discovered);
+}
+
+TEST(UgraphTraversal, stop1)
+{
+    CharGraph g;
+    makeGraph1(g);
+
+    RecordingVisitor dfsVis(g), bfsVis(g);
+    dfsVis.stopAfter = bfsVis.stopAfter = 3;
+    traverseDfsAll(g, dfsVis);
+    traverseBfsAll(g, bfsVis);
+
+    // the DFS stops right away; the BFS finishes the current vertex first
+    EXPECT_EQ(3, dfsVis.discovered.size());
+    EXPECT_EQ("ab", bfsVis.discovered.substr(0, 2));
+    EXPECT_EQ(2, bfsVis.finished.size());
+}
+
+TEST(UgraphTraversal, csr1)
+{
+    CharGraph g;
+    makeGraph1(g);
+    CsrUGraph<char> csr(g);
+
+    RecordingVisitor vis(g), csrVis(g);
+    traverseBfs(g, 'a', vis);
+    traverseBfs(csr, 'a', csrVis);
+
+    // the CSR graph keeps the vertex IDs of the source graph
+    EXPECT_EQ(vis.levels, csrVis.levels);
+}
+
+TEST(UgraphTraversal, bipartite1)
+{
+    CharGraph g;
+    g.addEdge('a', 'b');
+    g.addEdge('b', 'c');
+    g.addEdge('c', 'd');
+    g.addEdge('d', 'a');
+    g.addEdge('x', 'y');
+    g.addVertex('z');
+
+    std::vector<unsigned char> sides;
+    EXPECT_TRUE(isBipartite(g, &sides));
+    ASSERT_EQ(g.getVerticesNum(), sides.size());
+    for (auto es = g.getEdges(); es.first != es.second; ++es.first)
+        EXPECT_NE(sides[g.getVertexId(es.first->first)],
+                  sides[g.getVertexId(es.first->second)]);
+
+    // an odd cycle in the second component
+    g.addEdge('y', 'u');
+    g.addEdge('u', 'x');
+    sides.clear();
+    EXPECT_FALSE(isBipartite(g, &sides));
+    EXPECT_TRUE(sides.empty());
+
+    // a loop is an odd cycle too
+    CharGraph g2;
+    g2.addEdge('a', 'b');
+    g2.addEdge('b', 'b');
+    EXPECT_FALSE(isBipartite(g2));
+
+    EXPECT_TRUE(isBipartite(CharGraph()));
+}
+
+TEST(UgraphTraversal, dirOptBfs1)
+{
+    CharGraph g;
+    makeGraph1(g);
+
+    DirOptBfs<CharGraph> bfs(g);
+    bfs.run('a');
+
+    RecordingVisitor vis(g);
+    traverseBfs(g, 'a', vis);
+    EXPECT_EQ(vis.levels, bfs.getLevels());
+
+    std::vector<UInt> parents = bfs.getParents();
+    EXPECT_EQ(g.getVertexId('a'), parents[g.getVertexId('a')]);
+    EXPECT_EQ(g.getVertexId('b'), parents[g.getVertexId('c')]);
+    EXPECT_EQ(g.getVertexId('c'), parents[g.getVertexId('d')]);
+    EXPECT_EQ(NO_LEVEL, parents[g.getVertexId('x')]);
+
+    // reuse from another root
+    bfs.run('y');
+    EXPECT_EQ(1, bfs.getLevels()[g.getVertexId('x')]);
+    EXPECT_EQ(NO_LEVEL, bfs.getLevels()[g.getVertexId('a')]);
+}
+
+TEST(UgraphTraversal, dirOptBfsRandom)
+{
+    for (unsigned int seed = 1; seed <= 4; ++seed)
+    {
+        // dense enough for bottom-up steps to be chosen
+        IntGraph g;
+        makeRandomGraph(g, 3000, 30000, seed);
+
+        std::vector<UInt> expLevels = getBfsLevels(g, 0);
+        for (unsigned int threads = 1; threads <= 4; ++threads)
+        {
+            for (bool dirOpt : { false, true })
+            {
+                DirOptBfs<IntGraph> bfs(g, threads, dirOpt);
+                bfs.run(0);
+                EXPECT_EQ(expLevels, bfs.getLevels());
+                EXPECT_EQ(dirOpt, bfs.getBottomUpStepsNum() > 0);
+
+                // parents are neighbours one level closer to the root
+                std::vector<UInt> parents = bfs.getParents();
+                for (UInt v = 1; v < parents.size(); ++v)
+                {
+                    if (expLevels[v] == NO_LEVEL)
+                    {
+                        EXPECT_EQ(NO_LEVEL, parents[v]);
+                        continue;
+                    }
+                    EXPECT_EQ(expLevels[v], expLevels[parents[v]] + 1);
+                    EXPECT_TRUE(g.isEdgeExists(g.getVertexById(v),
+                                               g.getVertexById(parents[v])));
+                }
+            }
+        }
+
+        EXPECT_EQ(expLevels, findHopDistances(g, 0, 2));
+    }
+}
+
+TEST(UgraphTraversal, dirOptBfsEdges1)
+{
+    // a small-diameter graph: bottom-up steps skip most edges
+    IntGraph g;
+    makeRandomGraph(g, 2000, 40000, 7);
+
+    DirOptBfs<IntGraph> topDown(g, 1, false), dirOpt(g, 1, true);
+    topDown.run(0);
+    dirOpt.run(0);
+
+    EXPECT_EQ(topDown.getLevels(), dirOpt.getLevels());
+    EXPECT_EQ(2 * g.getEdgesNum(), topDown.getExaminedEdgesNum());
+    EXPECT_LT(2 * dirOpt.getExaminedEdgesNum(), topDown.getExaminedEdgesNum());
+}
@@ -0,0 +1,162 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for indexed priority queues.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <set>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/ugraph_algos.hpp"
+#include "ugraph/vertex_heaps.hpp"
+
+
+// All the queues share the same interface, so the same tests are run for them.
+template <typename PQ>
+class VertexHeaps : public ::testing::Test {
+};
+
+typedef ::testing::Types<VertexPriorityQueue<unsigned int>,
+                         IndexedDaryHeap<>,
+                         IndexedDaryHeap<unsigned int, 2>,
+                         IndexedPairingHeap<> > PQTypes;
+TYPED_TEST_CASE(VertexHeaps, PQTypes);
+
+
+TYPED_TEST(VertexHeaps, empty)
+{
+    TypeParam pq;
+    EXPECT_TRUE(pq.isEmpty());
+    EXPECT_THROW(pq.getMin(), std::out_of_range);
+    EXPECT_THROW(pq.remove(1), std::invalid_argument);
+
+    unsigned int w;
+    EXPECT_FALSE(pq.getWeight(0, w));
+}
+
+
+TYPED_TEST(VertexHeaps, setAndPop)
+{
+    TypeParam pq;
+    pq.reserve(10);
+    pq.insert(0, 50);
+    pq.insert(1, 20);
+    pq.insert(2, 40);
+    pq.insert(3, 30);
+
+    EXPECT_EQ(1, pq.getMin().first);
+    EXPECT_EQ(20, pq.getMin().second);
+
+    pq.set(2, 10);                              // decrease
+    EXPECT_EQ(2, pq.getMin().first);
+
+    pq.set(2, 60);                              // increase
+    EXPECT_EQ(1, pq.getMin().first);
+
+    unsigned int w;
+    EXPECT_TRUE(pq.getWeight(2, w));
+    EXPECT_EQ(60, w);
+
+    pq.remove(3);
+    EXPECT_FALSE(pq.getWeight(3, w));
+
+    pq.set(7, 5);                               // inserts
+    EXPECT_EQ(7, pq.getMin().first);
+
+    std::vector<unsigned int> order;
+    while (!pq.isEmpty())
+        order.push_back(pq.popMin().first);
+
+    EXPECT_EQ(std::vector<unsigned int>({7, 1, 0, 2}), order);
+}
+
+
+// Random sequence of operations is checked against a reference std::set.
+TYPED_TEST(VertexHeaps, randomOps)
+{
+    const unsigned int N = 200;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<unsigned int> idDist(0, N - 1);
+    std::uniform_int_distribution<unsigned int> wDist(0, 1000);
+    std::uniform_int_distribution<int> opDist(0, 3);
+
+    TypeParam pq;
+    std::set<std::pair<unsigned int, unsigned int>> ref;     // (weight, id)
+    std::vector<unsigned int> weights(N, 0);
+    std::vector<bool> in(N, false);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        unsigned int id = idDist(rng);
+        int op = opDist(rng);
+        if (op <= 1)                            // set
+        {
+            unsigned int w = wDist(rng);
+            if (in[id])
+                ref.erase({weights[id], id});
+            pq.set(id, w);
+            ref.insert({w, id});
+            weights[id] = w;
+            in[id] = true;
+        }
+        else if (op == 2 && in[id])             // remove
+        {
+            pq.remove(id);
+            ref.erase({weights[id], id});
+            in[id] = false;
+        }
+        else if (!ref.empty())                  // pop
+        {
+            auto vw = pq.popMin();
+            ASSERT_EQ(ref.begin()->first, vw.second);
+            in[vw.first] = false;
+            ref.erase({vw.second, vw.first});
+        }
+
+        ASSERT_EQ(ref.empty(), pq.isEmpty());
+        if (!ref.empty())
+        {
+            ASSERT_EQ(ref.begin()->first, pq.getMin().second);
+        }
+    }
+}
+
+
+// Prim's algorithm must produce an MST of the same weight with any queue.
+TYPED_TEST(VertexHeaps, mstPrim)
+{
+    EdgeLblUGraph<int, int> g;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> vDist(0, 59);
+    std::uniform_int_distribution<int> wDist(1, 100);
+    for (int i = 0; i < 60; ++i)
+        g.addLblEdge(i, (i + 1) % 60, wDist(rng));
+    for (int i = 0; i < 300; ++i)
+        g.addLblEdge(vDist(rng), vDist(rng), wDist(rng));
+
+    auto weightOf = [&g](const std::set<EdgeLblUGraph<int, int>::Edge>& es) {
+        int sum = 0;
+        for (auto e : es)
+        {
+            int lbl;
+            g.getLabel(e.first, e.second, lbl);
+            sum += lbl;
+        }
+        return sum;
+    };
+
+    auto mstK = findMSTKruskal(g);
+    auto mstP = findMSTPrim<TypeParam>(g);
+    EXPECT_EQ(59, mstP.size());
+    EXPECT_EQ(weightOf(mstK), weightOf(mstP));
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file
+/// \brief Testing module for VertexIdMap class and vertex IDs of graphs.
+///
+/// © Sergey Shershakov 2020.
+///
+/// This code is for educational purposes of the course "Algorithms and Data
+/// Structures" provided by the School of Software Engineering of the Faculty
+/// of Computer Science at the Higher School of Economics.
+///
+/// When altering code, a copyright line must be preserved.
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ugraph/vertex_ids.hpp"
+#include "ugraph/ugraph.hpp"
+
+
+TEST(VertexIdMap, simplest)
+{
+}
+
+
+// A comparable-only vertex type.
+struct Point {
+    int x, y;
+    bool operator<(const Point& rhv) const
+    {
+        return x < rhv.x || (x == rhv.x && y < rhv.y);
+    }
+};
+
+
+TEST(VertexIdMap, defaultMap)
+{
+    EXPECT_TRUE(IsStdHashable<int>::value);
+    EXPECT_TRUE(IsStdHashable<std::string>::value);
+    EXPECT_FALSE(IsStdHashable<Point>::value);
+
+    EXPECT_TRUE((std::is_same<std::unordered_map<int, unsigned int>,
+                              DefaultVertexIdMap<int>::Type>::value));
+    EXPECT_TRUE((std::is_same<std::map<Point, unsigned int>,
+                              DefaultVertexIdMap<Point>::Type>::value));
+}
+
+
+TEST(VertexIdMap, intern1)
+{
+    VertexIdMap<std::string> ids;
+    EXPECT_EQ(0, ids.getSize());
+
+    EXPECT_EQ(0, ids.intern("a"));
+    EXPECT_EQ(1, ids.intern("b"));
+    EXPECT_EQ(0, ids.intern("a"));
+    EXPECT_EQ(2, ids.intern("c"));
+    EXPECT_EQ(3, ids.getSize());
+
+    EXPECT_EQ("b", ids.getVertex(1));
+    EXPECT_EQ(2, ids.getId("c"));
+
+    unsigned int id;
+    EXPECT_TRUE(ids.findId("a", id));
+    EXPECT_EQ(0, id);
+    EXPECT_FALSE(ids.findId("d", id));
+    EXPECT_THROW(ids.getId("d"), std::invalid_argument);
+}
+
+
+TEST(VertexIdMap, internComparable)
+{
+    VertexIdMap<Point> ids;
+    EXPECT_EQ(0, ids.intern({1, 2}));
+    EXPECT_EQ(1, ids.intern({2, 1}));
+    EXPECT_EQ(0, ids.intern({1, 2}));
+    EXPECT_EQ(2, ids.getVertex(1).x);
+}
+
+
+// Vertices of a graph get dense IDs in order of addition.
+TEST(VertexIdMap, ugraphIds)
+{
+    UGraph<int> g;
+    g.addEdge(10, 5);
+    g.addEdge(5, 7);
+    g.addVertex(10);
+    g.addVertex(3);
+
+    EXPECT_EQ(0, g.getVertexId(10));
+    EXPECT_EQ(1, g.getVertexId(5));
+    EXPECT_EQ(2, g.getVertexId(7));
+    EXPECT_EQ(3, g.getVertexId(3));
+    EXPECT_EQ(7, g.getVertexById(2));
+    EXPECT_THROW(g.getVertexId(4), std::invalid_argument);
+}